@@ -0,0 +1,159 @@
+"""
+Synthetic city PLC for benchmarks: a height-field terrain with box buildings cut
+out of the volume, closed by a flat top and four vertical side polygons.
+
+Mirrors dtcc_tetgen_wrapper/cpp/tetwrap/bench/city_plc.h; keep both generators
+in sync so the C++ and Python benchmarks mesh the same inputs.
+"""
+from __future__ import annotations
+
+from dataclasses import dataclass
+from typing import Dict, List
+
+import numpy as np
+
+
+@dataclass
+class CityParams:
+    cells: int = 16  # terrain cells per side
+    buildings: int = 2  # buildings per side
+    footprint: int = 3  # building footprint in cells per side
+    size: float = 1000.0  # domain side length
+    height: float = 200.0  # domain top (z)
+    relief: float = 10.0  # terrain amplitude
+    building_height: float = 30.0  # roof height above the highest footprint vertex
+    max_volume: float = 0.0  # TetGen -a bound, 0 for none
+
+
+def city_params_for(target_tets: int) -> CityParams:
+    """
+    Parameters whose mesh has roughly `target_tets` tetrahedra under -q1.5.
+
+    The surface resolution follows the volume resolution; the -a bound assumes
+    quality tets average about half of it.
+    """
+    p = CityParams()
+    volume = p.size * p.size * p.height
+    p.max_volume = 2.0 * volume / max(1, int(target_tets))
+    edge = np.cbrt(p.max_volume)
+    p.cells = max(16, int(round(p.size / edge)))
+    p.buildings = max(1, p.cells // 8)
+    p.footprint = 3
+    return p
+
+
+def terrain_z(p: CityParams, x: np.ndarray, y: np.ndarray) -> np.ndarray:
+    return p.relief * (
+        0.6 * np.sin(2.0 * np.pi * x / p.size) * np.cos(3.0 * np.pi * y / p.size)
+        + 0.4 * np.sin(5.0 * np.pi * (x + y) / p.size)
+    )
+
+
+def _quads(a: np.ndarray, b: np.ndarray, c: np.ndarray, d: np.ndarray) -> np.ndarray:
+    """Split quads (a, b, c, d) into triangles (a, b, c), (a, c, d), quad by quad."""
+    tris = np.empty((2 * len(a), 3), dtype=np.int64)
+    tris[0::2] = np.column_stack([a, b, c])
+    tris[1::2] = np.column_stack([a, c, d])
+    return tris
+
+
+def make_city_plc(p: CityParams) -> Dict[str, object]:
+    """
+    Build the PLC as keyword arguments for `tetrahedralize`: `vertices`, `faces`,
+    `face_markers` (0 terrain, 1 buildings) and `boundary_facets` keyed
+    top/north/east/south/west.
+    """
+    n = p.cells
+    step = n // p.buildings if p.buildings > 0 else n
+    if n < 2:
+        raise ValueError("city: cells must be >= 2")
+    if p.buildings > 0 and step < p.footprint + 2:
+        raise ValueError(f"city: {p.buildings} buildings of {p.footprint} cells do not fit in {n} cells")
+
+    h = p.size / n
+    jj, ii = np.meshgrid(np.arange(n + 1), np.arange(n + 1), indexing="ij")
+    x = ii.ravel() * h
+    y = jj.ravel() * h
+    vertices: List[np.ndarray] = [np.column_stack([x, y, terrain_z(p, x, y)])]
+    num_vertices = (n + 1) * (n + 1)
+
+    def g(i, j):
+        return j * (n + 1) + i
+
+    faces: List[np.ndarray] = []
+    markers: List[np.ndarray] = []
+    built = np.zeros((n, n), dtype=bool)
+    k = p.footprint
+    pad = (step - k) // 2
+    ground_z = vertices[0][:, 2]
+
+    # Perimeter of a footprint walked counter-clockwise, one entry per cell edge
+    ring = (
+        [(i, 0) for i in range(k)]
+        + [(k, j) for j in range(k)]
+        + [(i, k) for i in range(k, 0, -1)]
+        + [(0, j) for j in range(k, 0, -1)]
+    )
+    rj, ri = np.meshgrid(np.arange(k), np.arange(k), indexing="ij")
+    for bj in range(p.buildings):
+        for bi in range(p.buildings):
+            i0 = bi * step + pad
+            j0 = bj * step + pad
+            built[j0 : j0 + k, i0 : i0 + k] = True
+            fj, fi = np.meshgrid(np.arange(j0, j0 + k + 1), np.arange(i0, i0 + k + 1), indexing="ij")
+            roof = ground_z[g(fi, fj)].max() + p.building_height
+
+            # Flat roof grid over the footprint
+            r0 = num_vertices
+            vertices.append(np.column_stack([fi.ravel() * h, fj.ravel() * h, np.full(fi.size, roof)]))
+            num_vertices += fi.size
+
+            def r(i, j):
+                return r0 + j * (k + 1) + i
+
+            a, b, c, d = (v.ravel() for v in (r(ri, rj), r(ri + 1, rj), r(ri + 1, rj + 1), r(ri, rj + 1)))
+            faces.append(_quads(a, b, c, d))
+
+            # Walls: one quad per perimeter cell edge
+            u = np.array(ring)
+            v = np.roll(u, -1, axis=0)
+            a = g(i0 + u[:, 0], j0 + u[:, 1])
+            b = g(i0 + v[:, 0], j0 + v[:, 1])
+            A = r(u[:, 0], u[:, 1])
+            B = r(v[:, 0], v[:, 1])
+            faces.append(_quads(a, b, B, A))
+            markers.append(np.ones(2 * k * k + 2 * len(ring), dtype=np.int32))
+
+    # Terrain triangles outside the footprints, in row order
+    cj, ci = np.nonzero(~built)
+    terrain = _quads(g(ci, cj), g(ci + 1, cj), g(ci + 1, cj + 1), g(ci, cj + 1))
+    faces.append(terrain)
+    markers.append(np.zeros(terrain.shape[0], dtype=np.int32))
+
+    # Closing polygons
+    t00, t10, t11, t01 = range(num_vertices, num_vertices + 4)
+    vertices.append(
+        np.array(
+            [[0.0, 0.0, p.height], [p.size, 0.0, p.height], [p.size, p.size, p.height], [0.0, p.size, p.height]]
+        )
+    )
+    span = np.arange(n + 1)
+    boundary_facets = {
+        "top": [t00, t10, t11, t01],
+        "north": [int(v) for v in g(span[::-1], n)] + [t01, t11],
+        "east": [int(v) for v in g(n, span)] + [t11, t10],
+        "south": [int(v) for v in g(span, 0)] + [t10, t00],
+        "west": [int(v) for v in g(0, span[::-1])] + [t00, t01],
+    }
+
+    return {
+        "vertices": np.ascontiguousarray(np.vstack(vertices), dtype=np.float64),
+        "faces": np.ascontiguousarray(np.vstack(faces), dtype=np.int32),
+        "face_markers": np.concatenate(markers),
+        "boundary_facets": boundary_facets,
+    }
+
+
+def city_switches(p: CityParams) -> Dict[str, object]:
+    """Switch parameters matching the C++ benchmark (pQq1.5a<max_volume>)."""
+    return {"plc": True, "quiet": True, "quality": 1.5, "max_volume": p.max_volume}
@@ -0,0 +1,80 @@
+"""
+pytest-benchmark suite: mesh synthetic city PLCs from ~1k to ~10M tets through the
+public adapter and record throughput, wrapper overhead and peak RSS.
+
+    pip install pytest-benchmark
+    pytest benchmarks --benchmark-only -m "not slow"   # up to ~100k tets
+    pytest benchmarks --benchmark-only -m slow         # ~1M and ~10M tets
+    pytest benchmarks --benchmark-only -m "not slow" --benchmark-compare  # against the last --benchmark-autosave
+"""
+from __future__ import annotations
+
+import sys
+
+import pytest
+
+from dtcc_tetgen_wrapper import tetrahedralize
+
+from city_plc import city_params_for, city_switches, make_city_plc
+
+pytest.importorskip("pytest_benchmark")
+
+TARGETS = [
+    1_000,
+    10_000,
+    100_000,
+    pytest.param(1_000_000, marks=pytest.mark.slow),
+    pytest.param(10_000_000, marks=pytest.mark.slow),
+]
+
+# Wrapper phases around TetGen itself (see TetwrapIO.stats["time"])
+OVERHEAD_PHASES = ("pack_input", "boundary_faces", "to_numpy")
+
+
+def _peak_rss_mb() -> float:
+    """Process-wide high-water mark, so it only grows across cases."""
+    try:
+        import resource
+    except ImportError:  # Windows
+        return 0.0
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak / (1024.0 * 1024.0) if sys.platform == "darwin" else peak / 1024.0
+
+
+@pytest.mark.parametrize("target_tets", TARGETS)
+def test_city(benchmark, target_tets: int) -> None:
+    params = city_params_for(target_tets)
+    plc = make_city_plc(params)
+    switches_params = city_switches(params)
+
+    def run():
+        return tetrahedralize(
+            plc["vertices"],
+            plc["faces"],
+            plc["boundary_facets"],
+            face_markers=plc["face_markers"],
+            switches_params=switches_params,
+            return_boundary_faces=True,
+        )
+
+    rounds = 5 if target_tets <= 100_000 else 1
+    io = benchmark.pedantic(run, rounds=rounds, iterations=1, warmup_rounds=0)
+
+    times = io.stats["time"]
+    tets = int(io.tets.shape[0])
+    tetgen_s = times["total"] - sum(times.get(phase, 0.0) for phase in OVERHEAD_PHASES)
+    overhead_s = times["total"] - tetgen_s
+    benchmark.extra_info.update(
+        {
+            "tets": tets,
+            "tets_per_s": tets / benchmark.stats.stats.mean,
+            "tetgen_s": tetgen_s,
+            "overhead_s": overhead_s,
+            "overhead_fraction": overhead_s / times["total"] if times["total"] > 0 else 0.0,
+            "steiner_points": io.stats.get("steiner_points"),
+            "peak_pool_bytes": io.stats.get("peak_pool_bytes"),
+            "peak_rss_mb": _peak_rss_mb(),
+        }
+    )
+    assert tets > 0
+    assert io.boundary_tri_faces is not None
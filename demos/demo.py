@@ -83,25 +83,13 @@ def main():
     print(f"TetGen produced: {len(tetwrap_out.points)} vertices, {len(tetwrap_out.tets)} tets")
     if tetwrap_out.boundary_tri_faces is not None:
         print(f"               {len(tetwrap_out.boundary_tri_faces)} boundary faces")
-    # Optional: export to VTU if meshio is available
-    try:
-        from pathlib import Path
+    # Export with the native writers (no meshio needed)
+    from pathlib import Path
 
-        import meshio  # type: ignore
-
-        outpath = Path(__file__).with_name("demo_box.vtu")
-
-        cells = [("tetra", tetwrap_out.tets)]
-        if tetwrap_out.boundary_tri_faces is not None and len(tetwrap_out.boundary_tri_faces) > 0:
-            cells.append(("triangle", tetwrap_out.boundary_tri_faces))
-
-        mesh = meshio.Mesh(points=tetwrap_out.points, cells=cells)
-        meshio.write("demo_box_faces.vtu", meshio.Mesh(tetwrap_out.points, [("triangle", tetwrap_out.boundary_tri_faces)]))
-        meshio.write(outpath, mesh)
-        print(f"Wrote {outpath}")
-
-    except Exception as e:
-        print("meshio not installed (or write failed)", e)
+    outpath = Path(__file__).with_name("demo_box.vtu")
+    tetwrap_out.write_vtu(outpath)
+    tetwrap_out.write_xdmf(outpath.with_suffix(".xmf"))
+    print(f"Wrote {outpath} and {outpath.with_suffix('.xmf')}")
 
 
 if __name__ == "__main__":
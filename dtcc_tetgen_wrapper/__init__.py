@@ -3,11 +3,42 @@ Public package entry points for dtcc_tetgen_wrapper.
 """
 
 
-from .adapter import tetrahedralize
+from .adapter import (
+    CancelToken,
+    FacetCSR,
+    MeshingAborted,
+    RemeshResult,
+    refine,
+    remesh_region,
+    tetrahedralize,
+    tetrahedralize_batch,
+    tetrahedralize_tiled,
+)
+from .cache import MeshCache
+from .sizing import BoxZone, GridSizing, HeightSizing, SphereZone, SurfaceDistanceSizing
 from .switches import build_tetgen_switches, tetgen_defaults
+from .tetgen_files import read_smesh, read_tetgen, write_smesh, write_tetgen
 from .tetwrapio import TetwrapIO
 
 __all__ = ["tetrahedralize", 
+           "tetrahedralize_batch",
+           "tetrahedralize_tiled",
+           "remesh_region",
+           "refine",
+           "RemeshResult",
+           "FacetCSR",
+           "CancelToken",
+           "MeshingAborted",
+           "MeshCache",
+           "HeightSizing",
+           "SurfaceDistanceSizing",
+           "BoxZone",
+           "SphereZone",
+           "GridSizing",
+           "read_tetgen",
+           "write_tetgen",
+           "read_smesh",
+           "write_smesh",
            "TetwrapIO", 
            "switches",
            "tetgen_defaults", 
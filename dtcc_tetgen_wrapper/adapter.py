@@ -6,32 +6,111 @@ Inputs are plain NumPy arrays and Python lists — no dtcc dependency.
 """
 from __future__ import annotations
 
-from typing import List, Mapping, Optional, Sequence, Tuple, Union
+import functools
+import os
+from typing import Any, Callable, Dict, List, Mapping, NamedTuple, Optional, Sequence, Tuple, Union
 
 import numpy as np
 
 from . import _tetwrap, switches
+from .cache import CacheLike, MeshCache, as_cache, mesh_key
+from .sizing import SizingKernel, native_sizing
 from .tetwrapio import TetwrapIO
 
+
+
+class FacetCSR(NamedTuple):
+    """
+    Polygons in CSR form: polygon i is ``indices[offsets[i]:offsets[i + 1]]``.
+
+    `offsets` has one more entry than there are polygons and starts at 0.
+    `markers` optionally gives one integer per polygon.
+    """
+
+    offsets: np.ndarray
+    indices: np.ndarray
+    markers: Optional[np.ndarray] = None
+
+
+class RemeshResult(NamedTuple):
+    """
+    Result of `remesh_region`: the spliced mesh, and for every point and tet of
+    the input mesh its index in `io`, or -1 where it was removed.
+    """
+
+    io: TetwrapIO
+    point_map: np.ndarray
+    tet_map: np.ndarray
+
+
+# Cooperative cancellation flag, and the RuntimeError raised (with a `.code`)
+# when a run is stopped through it.
+CancelToken = _tetwrap.CancelToken
+MeshingAborted = _tetwrap.MeshingAborted
+
+ProgressCallback = Callable[[Dict[str, Any]], None]
+
+# Directory for failure repro bundles; None: native default, False: none
+DumpDir = Optional[Union[str, "os.PathLike[str]", bool]]
+
 BoundaryFacets = Union[
     Sequence[Sequence[int]],
     Mapping[str, Sequence[int]],
+    FacetCSR,
 ]
 
 
-def _ensure_ndarray(vertices: np.ndarray, faces: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
-    V = np.asarray(vertices, dtype=float)
-    F = np.asarray(faces, dtype=np.int64)
+# dtypes the native module reads in place; anything else is converted once here.
+_COORD_DTYPES = (np.dtype(np.float64), np.dtype(np.float32))
+_INDEX_DTYPES = (np.dtype(np.int32), np.dtype(np.int64))
 
+
+def _index_array(indices: Any) -> np.ndarray:
+    F = np.asarray(indices)
+    if F.dtype not in _INDEX_DTYPES:
+        F = F.astype(np.int64)
+    return np.ascontiguousarray(F)
+
+
+def _ensure_vertices(vertices: np.ndarray) -> np.ndarray:
+    V = np.asarray(vertices)
+    if V.dtype not in _COORD_DTYPES:
+        V = V.astype(np.float64)
+    V = np.ascontiguousarray(V)
     if V.ndim != 2 or V.shape[1] != 3:
         raise ValueError("vertices must be (N, 3) float array")
+    return V
+
+
+def _ensure_ndarray(vertices: np.ndarray, faces: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+    V = _ensure_vertices(vertices)
+    F = _index_array(faces)
     if F.ndim != 2 or F.shape[1] != 3:
         raise ValueError("faces must be (M, 3) int array of triangles")
     return V, F
 
 
-def _normalize_boundary_facets(boundary_facets: BoundaryFacets) -> List[List[int]]:
+def _ensure_csr(csr: FacetCSR, name: str) -> Tuple[np.ndarray, np.ndarray, Optional[np.ndarray]]:
+    offsets = np.ascontiguousarray(csr.offsets, dtype=np.int64)
+    indices = _index_array(csr.indices)
+    if offsets.ndim != 1 or offsets.shape[0] < 1 or offsets[0] != 0:
+        raise ValueError(f"{name} offsets must be a 1D array starting at 0")
+    if indices.ndim != 1 or offsets[-1] != indices.shape[0]:
+        raise ValueError(f"{name} offsets must end at the length of the 1D index array")
+    if np.any(np.diff(offsets) < 3):
+        raise ValueError(f"every {name} polygon must have at least 3 vertices")
+    markers = None
+    if csr.markers is not None:
+        markers = np.ascontiguousarray(csr.markers, dtype=np.int32)
+        if markers.ndim != 1 or markers.shape[0] != offsets.shape[0] - 1:
+            raise ValueError(f"{name} markers must have one entry per polygon")
+    return offsets, indices, markers
+
+
+def _normalize_boundary_facets(boundary_facets: BoundaryFacets, required: bool = True) -> List[List[int]]:
     if boundary_facets is None:
+        if not required:
+            return []
         raise ValueError("boundary_facets is required (list of polygons or dict of named polygons)")
 
     if isinstance(boundary_facets, Mapping):
@@ -50,7 +129,7 @@ def _normalize_boundary_facets(boundary_facets: BoundaryFacets) -> List[List[int
                 if len(poly) < 3:
                     raise ValueError(f"boundary facet '{key}' must have at least 3 vertices")
                 out.append(poly)
-        if len(out) < 1:
+        if len(out) < 1 and required:
             raise ValueError("boundary_facets dict must contain at least one polygon")
         return out
 
@@ -60,11 +139,120 @@ def _normalize_boundary_facets(boundary_facets: BoundaryFacets) -> List[List[int
         if len(p) < 3:
             raise ValueError(f"boundary facet {i} must have at least 3 vertices")
         out.append(p)
-    if len(out) < 1:
+    if len(out) < 1 and required:
         raise ValueError("boundary_facets must contain at least one polygon")
     return out
 
 
+def _normalize_face_markers(face_markers: Optional[Sequence[int]], F: np.ndarray) -> Optional[np.ndarray]:
+    if face_markers is None:
+        return None
+    F_markers = np.asarray(face_markers, dtype=np.int32)
+    if F_markers.ndim != 1:
+        raise ValueError("face_markers must be a 1D sequence of integers")
+    if F_markers.shape[0] != F.shape[0]:
+        raise ValueError("face_markers must have the same length as faces")
+    return F_markers
+
+
+def _prepare_plc(
+    vertices: np.ndarray,
+    faces: Union[np.ndarray, FacetCSR],
+    boundary_facets: BoundaryFacets,
+    face_markers: Optional[Sequence[int]],
+    require_boundary: bool = True,
+) -> Tuple[np.ndarray, np.ndarray, Optional[np.ndarray], Any, Dict[str, np.ndarray]]:
+    """
+    Normalize one PLC into the positional arguments of `_tetwrap._tetrahedralize`
+    plus the CSR keyword arguments (only present when CSR input is used).
+    """
+    extra: Dict[str, np.ndarray] = {}
+    if isinstance(faces, FacetCSR):
+        offsets, F, csr_markers = _ensure_csr(faces, "faces")
+        V = _ensure_vertices(vertices)
+        extra["mesh_facet_offsets"] = offsets
+        if face_markers is None:
+            face_markers = csr_markers
+        F_markers = _normalize_face_markers(face_markers, offsets[:-1])
+    else:
+        V, F = _ensure_ndarray(vertices, faces)
+        F_markers = _normalize_face_markers(face_markers, F)
+
+    if isinstance(boundary_facets, FacetCSR):
+        offsets, B, markers = _ensure_csr(boundary_facets, "boundary_facets")
+        if offsets.shape[0] < 2 and require_boundary:
+            raise ValueError("boundary_facets must contain at least one polygon")
+        extra["boundary_facet_offsets"] = offsets
+        if markers is not None:
+            if np.any(markers < 0):
+                raise ValueError("boundary_facets markers must be non-negative")
+            extra["boundary_facet_markers"] = markers
+    else:
+        B = _normalize_boundary_facets(boundary_facets, require_boundary)
+    return V, F, F_markers, B, extra
+
+
+def _control_kwargs(
+    progress: Optional[ProgressCallback],
+    cancel: Optional[CancelToken],
+    progress_interval: float,
+    time_budget_s: Optional[float] = None,
+    memory_budget_bytes: Optional[int] = None,
+) -> Dict[str, Any]:
+    """Native keyword arguments for progress / cancellation / budgets, empty when unused."""
+    kwargs: Dict[str, Any] = {}
+    if progress is not None or cancel is not None:
+        kwargs.update(progress=progress, cancel=cancel, progress_interval=float(progress_interval))
+    if time_budget_s is not None:
+        if time_budget_s <= 0:
+            raise ValueError("time_budget_s must be > 0")
+        kwargs["time_budget_s"] = float(time_budget_s)
+    if memory_budget_bytes is not None:
+        if memory_budget_bytes <= 0:
+            raise ValueError("memory_budget_bytes must be > 0")
+        kwargs["memory_budget_bytes"] = int(memory_budget_bytes)
+    return kwargs
+
+
+def _dump_kwargs(dump_dir: DumpDir) -> Dict[str, Any]:
+    """Native `dump_dir` argument; omitted for the default location."""
+    if dump_dir is None:
+        return {}
+    return {"dump_dir": dump_dir if isinstance(dump_dir, bool) else os.fspath(dump_dir)}
+
+
+def _sizing_kwargs(sizing: Optional[Sequence[SizingKernel]], points: np.ndarray) -> Dict[str, Any]:
+    if not sizing:
+        return {}
+    return {"sizing": native_sizing(sizing, points)}
+
+
+def _remap_progress_item(progress: ProgressCallback, items: Sequence[int], info: Dict[str, Any]) -> None:
+    progress({**info, "item": items[info["item"]]})
+
+
+def _build_switch_str(
+    switches_params: Optional[dict],
+    switches_overrides: Optional[dict],
+    *,
+    return_faces: bool,
+    return_edges: bool,
+    return_neighbors: bool,
+) -> str:
+    # Boundary faces do not need -f/-n: the native module recovers them from
+    # TetGen's default subface output.
+    s_params = dict(switches_params or {})
+    if return_faces:
+        s_params["output_faces"] = True
+    if return_edges:
+        s_params["output_edges"] = True
+    if return_neighbors:
+        s_params["output_neighbors"] = True
+
+    s_over = switches_overrides or {}
+    return switches.build_tetgen_switches(params=s_params, **s_over)
+
+
 def tetrahedralize(
     vertices: np.ndarray,
     faces: np.ndarray,
@@ -79,6 +267,15 @@ def tetrahedralize(
     return_boundary_faces: bool = False,
     return_edges: bool = False,
     return_neighbors: bool = False,
+    progress: Optional[ProgressCallback] = None,
+    cancel: Optional[CancelToken] = None,
+    progress_interval: float = 0.5,
+    time_budget_s: Optional[float] = None,
+    memory_budget_bytes: Optional[int] = None,
+    cache: Optional[CacheLike] = None,
+    output_dir: Optional[Union[str, "os.PathLike[str]"]] = None,
+    dump_dir: DumpDir = None,
+    sizing: Optional[Sequence[SizingKernel]] = None,
 ) -> Union[
     TetwrapIO,
     Tuple[
@@ -93,30 +290,69 @@ def tetrahedralize(
 ]:
     """
     Run TetGen on a PLC defined by `faces` (triangles) + `boundary_facets` (polygons).
-    """
-    V, F = _ensure_ndarray(vertices, faces)
-    B = _normalize_boundary_facets(boundary_facets)
 
-    F_markers = None
-    if face_markers is not None:
-        F_markers = np.asarray(face_markers, dtype=np.int32)
-        if F_markers.ndim != 1:
-            raise ValueError("face_markers must be a 1D sequence of integers")
-        if F_markers.shape[0] != F.shape[0]:
-            raise ValueError("face_markers must have the same length as faces")
+    Either may instead be a `FacetCSR` of arbitrary polygons; its indices are read
+    in place by the native module. Boundary markers from a `FacetCSR` replace the
+    default polygon index.
 
-    s_params = dict(switches_params or {})
-    if return_faces or return_boundary_faces:
-        s_params["output_faces"] = True
-    if return_edges:
-        s_params["output_edges"] = True
-    if return_neighbors or return_boundary_faces:
-        s_params["output_neighbors"] = True
+    `progress` is called from the meshing thread with a dict (`phase`, `tets`,
+    `points`, `elapsed`, `item`) at the start of each phase and at most every
+    `progress_interval` seconds; an exception it raises aborts the run and
+    propagates. Calling `cancel.cancel()` from any thread stops the run with
+    `MeshingAborted` (`code` 101).
 
-    s_over = switches_overrides or {}
-    switch_str = switches.build_tetgen_switches(params=s_params, **s_over)
+    `time_budget_s` and `memory_budget_bytes` bound TetGen's wall time and the
+    memory of its element pools; a run exceeding either is stopped cleanly with
+    `MeshingAborted` (`code` 102 or 103) and its memory released.
 
-    raw_io = _tetwrap._tetrahedralize(V, F, F_markers, B, switch_str, return_boundary_faces)
+    With `cache` (a `MeshCache` or a directory), results are stored keyed on a
+    hash of the PLC arrays, the final switch string and the wrapper and TetGen
+    versions; a repeated call skips TetGen and returns memory-mapped arrays
+    from disk.
+
+    With `output_dir`, the large outputs (points, point_markers, tets, neighbors,
+    tet_attr and the boundary_tri_* arrays) are written by the native module
+    straight into memory-mapped `<name>.npy` files in that directory and returned
+    as views of them, so they live in the page cache instead of next to TetGen's
+    own structures on the heap. Linear tets only.
+    The files stay after the call (`np.load(..., mmap_mode="r")` reopens them).
+    `cache` is not consulted in this mode.
+
+    When TetGen fails, the native module saves the PLC and switches as a
+    binary repro bundle (``.tetplc``) in `dump_dir` and names it in the
+    error; the default is ``$TETWRAP_DUMP_DIR`` or the temp directory, and
+    ``dump_dir=False`` disables it. `repro.replay(path)` reruns a bundle.
+
+    `sizing` is a list of native kernels from `dtcc_tetgen_wrapper.sizing`
+    (`HeightSizing`, `SurfaceDistanceSizing`, `BoxZone`, `SphereZone`,
+    `GridSizing`) giving a target edge length field that TetGen's refinement follows (``-q`` is added),
+    instead of a global ``max_volume``. Repro bundles do not record it.
+    """
+    V, F, F_markers, B, extra = _prepare_plc(vertices, faces, boundary_facets, face_markers)
+    control = _control_kwargs(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes)
+    control.update(_dump_kwargs(dump_dir))
+    field = _sizing_kwargs(sizing, V)
+
+    switch_str = _build_switch_str(
+        switches_params,
+        switches_overrides,
+        return_faces=return_faces,
+        return_edges=return_edges,
+        return_neighbors=return_neighbors,
+    )
+
+    if output_dir is not None:
+        extra["output_dir"] = os.fspath(output_dir)
+        cache = None  # the caller wants the files in output_dir
+    store = as_cache(cache)
+    key = mesh_key(V, F, F_markers, B, switch_str, return_boundary_faces, extra, field.get("sizing")) if store else ""
+    raw_io = store.get(key) if store else None
+    if raw_io is None:
+        raw_io = _tetwrap._tetrahedralize(
+            V, F, F_markers, B, switch_str, return_boundary_faces, **extra, **control, **field
+        )
+        if store:
+            store.put(key, raw_io)  # before TetwrapIO normalizes the markers in place
     io = TetwrapIO(raw_io, interior_default=interior_default)
 
     if return_io:
@@ -141,4 +377,335 @@ def tetrahedralize(
     )
 
 
-__all__ = ["tetrahedralize", "TetwrapIO"]
+def tetrahedralize_batch(
+    plcs: Sequence[Mapping[str, Any]],
+    *,
+    switches_params: Optional[dict] = None,
+    switches_overrides: Optional[dict] = None,
+    interior_default: Optional[int] = -10,
+    return_faces: bool = False,
+    return_boundary_faces: bool = False,
+    return_edges: bool = False,
+    return_neighbors: bool = False,
+    num_threads: int = 0,
+    progress: Optional[ProgressCallback] = None,
+    cancel: Optional[CancelToken] = None,
+    progress_interval: float = 0.5,
+    time_budget_s: Optional[float] = None,
+    memory_budget_bytes: Optional[int] = None,
+    cache: Optional[CacheLike] = None,
+    dump_dir: DumpDir = None,
+) -> List[TetwrapIO]:
+    """
+    Mesh many PLCs concurrently on a native thread pool.
+
+    Each entry of `plcs` is a mapping with `vertices`, `faces`, `boundary_facets` and
+    optionally `face_markers`, `switches_params` and `switches_overrides` (which take
+    precedence over the shared ones). `num_threads <= 0` uses all hardware threads.
+    Results are returned in input order.
+
+    `progress` and `cancel` work as in `tetrahedralize`, shared by all PLCs;
+    the dict's `item` is the PLC index. Cancelling stops the running PLCs and
+    skips the remaining ones. Budgets apply to each PLC separately.
+
+    With `cache`, PLCs found in it are not sent to the thread pool. Failing
+    PLCs leave repro bundles in `dump_dir` as in `tetrahedralize`.
+    """
+    store = as_cache(cache)
+    keys: List[str] = []
+    raw_plcs = []
+    for i, plc in enumerate(plcs):
+        try:
+            V, F, F_markers, B, extra = _prepare_plc(
+                plc["vertices"], plc["faces"], plc.get("boundary_facets"), plc.get("face_markers")
+            )
+        except KeyError as exc:
+            raise ValueError(f"PLC {i} is missing {exc.args[0]!r}") from None
+        except ValueError as exc:
+            raise ValueError(f"PLC {i}: {exc}") from None
+
+        switch_str = _build_switch_str(
+            plc.get("switches_params", switches_params),
+            plc.get("switches_overrides", switches_overrides),
+            return_faces=return_faces,
+            return_edges=return_edges,
+            return_neighbors=return_neighbors,
+        )
+        raw_plc = (V, F, F_markers, B, switch_str)
+        if extra:
+            raw_plc += tuple(
+                extra.get(key)
+                for key in ("mesh_facet_offsets", "boundary_facet_offsets", "boundary_facet_markers")
+            )
+        raw_plcs.append(raw_plc)
+        if store:
+            keys.append(mesh_key(V, F, F_markers, B, switch_str, return_boundary_faces, extra))
+
+    raw_ios: List[Any] = [store.get(key) for key in keys] if store else [None] * len(raw_plcs)
+    misses = [i for i, raw_io in enumerate(raw_ios) if raw_io is None]
+    if misses:
+        report = progress
+        if progress is not None and len(misses) < len(raw_plcs):
+            # Report indices into `plcs`, not into the list of misses
+            report = functools.partial(_remap_progress_item, progress, misses)
+        control = _control_kwargs(report, cancel, progress_interval, time_budget_s, memory_budget_bytes)
+        control.update(_dump_kwargs(dump_dir))
+        fresh = _tetwrap._tetrahedralize_batch(
+            [raw_plcs[i] for i in misses], return_boundary_faces, num_threads, **control
+        )
+        for i, raw_io in zip(misses, fresh):
+            raw_ios[i] = raw_io
+            if store:
+                store.put(keys[i], raw_io)
+    return [TetwrapIO(raw_io, interior_default=interior_default) for raw_io in raw_ios]
+
+
+def tetrahedralize_tiled(
+    vertices: np.ndarray,
+    faces: Union[np.ndarray, FacetCSR],
+    boundary_facets: BoundaryFacets,
+    *,
+    tiles: Tuple[int, int] = (2, 2),
+    spacing: Optional[float] = None,
+    face_markers: Optional[Sequence[int]] = None,
+    switches_params: Optional[dict] = None,
+    switches_overrides: Optional[dict] = None,
+    interior_default: Optional[int] = -10,
+    return_faces: bool = False,
+    return_boundary_faces: bool = False,
+    return_neighbors: bool = False,
+    num_threads: int = 0,
+    progress: Optional[ProgressCallback] = None,
+    cancel: Optional[CancelToken] = None,
+    progress_interval: float = 0.5,
+    time_budget_s: Optional[float] = None,
+    memory_budget_bytes: Optional[int] = None,
+    dump_dir: DumpDir = None,
+    sizing: Optional[Sequence[SizingKernel]] = None,
+) -> TetwrapIO:
+    """
+    Mesh one large domain as ``tiles = (nx, ny)`` XY tiles meshed concurrently,
+    stitched into a single `TetwrapIO`.
+
+    The PLC must describe a box: a flat top polygon at the highest z, side
+    polygons in the four vertical planes of the bounding box, and a 2.5D surface
+    in between (terrain with the building footprints cut out, buildings). The
+    tile cuts are placed in gaps between vertex coordinates near the even split;
+    surface facets crossing a cut must be convex. Sides and top are rebuilt per
+    tile with their markers, and the walls between tiles are triangulated once
+    with edges of about `spacing` and shared by both tiles. TetGen keeps them as
+    given (``-Y``), so the tiles conform and only their shared points are merged.
+    Because the surface is kept as given too, it should already be at the target
+    resolution.
+
+    `spacing` defaults to the edge of a regular tet of `max_volume` when that
+    switch is set, else to the median surface edge. Points are the input points
+    in order (except those only used by the side and top polygons, which the
+    tiles rebuild), then the generated wall/top points, then each tile's Steiner
+    points. Boundary faces and markers exclude the interfaces; with
+    `return_faces` the interface faces appear once with the interior marker.
+    Edges (``-e``), refinement (``-r``) and ``-o2`` are not supported. `progress`
+    reports the tile index as `item`, and a failing tile leaves its own repro
+    bundle. `sizing` is as in `tetrahedralize` and refines the tile interiors.
+    """
+    nx, ny = (int(n) for n in tiles)
+    if nx < 1 or ny < 1:
+        raise ValueError("tiles must be at least (1, 1)")
+    V, F, F_markers, B, extra = _prepare_plc(vertices, faces, boundary_facets, face_markers)
+    control = _control_kwargs(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes)
+    control.update(_dump_kwargs(dump_dir))
+
+    switch_str = _build_switch_str(
+        switches_params,
+        switches_overrides,
+        return_faces=return_faces,
+        return_edges=False,
+        return_neighbors=return_neighbors,
+    )
+    if spacing is None:
+        max_volume = {**(switches_params or {}), **(switches_overrides or {})}.get("max_volume")
+        use_volume = max_volume is not None and not isinstance(max_volume, bool) and max_volume > 0
+        spacing = (6.0 * np.sqrt(2.0) * max_volume) ** (1.0 / 3.0) if use_volume else 0.0
+    elif spacing <= 0:
+        raise ValueError("spacing must be > 0")
+
+    raw_io = _tetwrap._tetrahedralize_tiled(
+        V,
+        F,
+        F_markers,
+        B,
+        switch_str,
+        return_boundary_faces,
+        tiles_x=nx,
+        tiles_y=ny,
+        spacing=float(spacing),
+        num_threads=num_threads,
+        **extra,
+        **control,
+        **_sizing_kwargs(sizing, V),
+    )
+    return TetwrapIO(raw_io, interior_default=interior_default)
+
+
+def remesh_region(
+    io: TetwrapIO,
+    box_min: Sequence[float],
+    box_max: Sequence[float],
+    vertices: Optional[np.ndarray] = None,
+    faces: Optional[Union[np.ndarray, FacetCSR]] = None,
+    boundary_facets: Optional[BoundaryFacets] = None,
+    *,
+    face_markers: Optional[Sequence[int]] = None,
+    switches_params: Optional[dict] = None,
+    switches_overrides: Optional[dict] = None,
+    interior_default: Optional[int] = -10,
+    return_boundary_faces: bool = True,
+    progress: Optional[ProgressCallback] = None,
+    cancel: Optional[CancelToken] = None,
+    progress_interval: float = 0.5,
+    time_budget_s: Optional[float] = None,
+    memory_budget_bytes: Optional[int] = None,
+    dump_dir: DumpDir = None,
+    sizing: Optional[Sequence[SizingKernel]] = None,
+) -> RemeshResult:
+    """
+    Remesh the part of an existing mesh inside the box ``[box_min, box_max]``
+    and splice it back, without touching the rest of the domain.
+
+    `io` must have linear tets and its boundary faces (``return_boundary_faces``);
+    its neighbors, if present, are kept up to date. The tets whose bounding boxes
+    meet the box are removed and their cavity is meshed again by TetGen, with the
+    interface to the kept tets preserved (``-Y``), so only the region's size
+    drives the TetGen time; `sizing` (as in `tetrahedralize`) applies there
+    too. The optional patch PLC (`vertices`, `faces` with
+    `face_markers`, `boundary_facets`) changes the domain there: its rim (the
+    edges of only one patch facet) must run along boundary edges inside the
+    region, with vertices equal to mesh points, and the boundary faces it cuts
+    off (e.g. the terrain under a new building, or the walls and roof of a
+    removed one) are replaced by the patch. Switches are built as in
+    `tetrahedralize`, typically with the parameters of the original run.
+
+    Kept points and tets come first, in their old order, then the new ones.
+    Boundary markers of kept faces are preserved; tri faces, edges, point
+    markers and attributes are not returned.
+    """
+    if io.corners != 4:
+        raise ValueError("remesh_region needs linear tets")
+    if io.boundary_tri_faces is None or io.boundary_tri_tets is None or io.boundary_tri_local_faces is None:
+        raise ValueError("io has no boundary faces (mesh it with return_boundary_faces=True)")
+    if vertices is None:
+        vertices = np.empty((0, 3))
+    if faces is None:
+        faces = np.empty((0, 3), dtype=np.int32)
+    V, F, F_markers, B, extra = _prepare_plc(vertices, faces, boundary_facets, face_markers, require_boundary=False)
+    control = _control_kwargs(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes)
+    control.update(_dump_kwargs(dump_dir))
+
+    switch_str = _build_switch_str(
+        switches_params,
+        switches_overrides,
+        return_faces=False,
+        return_edges=False,
+        return_neighbors=io.neighbors is not None,
+    )
+    raw_io, point_map, tet_map = _tetwrap._remesh_region(
+        io.points,
+        io.tets,
+        io.neighbors,
+        io.boundary_tri_faces,
+        io.boundary_tri_tets,
+        io.boundary_tri_local_faces,
+        io.raw_markers("boundary_tri_markers"),
+        tuple(float(x) for x in box_min),
+        tuple(float(x) for x in box_max),
+        V,
+        F,
+        F_markers,
+        B,
+        switch_str,
+        return_boundary_faces,
+        **extra,
+        **control,
+        **_sizing_kwargs(sizing, io.points),
+    )
+    return RemeshResult(TetwrapIO(raw_io, interior_default=interior_default), point_map, tet_map)
+
+
+def refine(
+    io: TetwrapIO,
+    tet_volumes: Optional[np.ndarray] = None,
+    *,
+    switches_params: Optional[dict] = None,
+    switches_overrides: Optional[dict] = None,
+    interior_default: Optional[int] = -10,
+    return_faces: bool = False,
+    return_edges: bool = False,
+    return_neighbors: bool = False,
+    return_boundary_faces: bool = True,
+    progress: Optional[ProgressCallback] = None,
+    cancel: Optional[CancelToken] = None,
+    progress_interval: float = 0.5,
+    time_budget_s: Optional[float] = None,
+    memory_budget_bytes: Optional[int] = None,
+    sizing: Optional[Sequence[SizingKernel]] = None,
+) -> TetwrapIO:
+    """
+    Refine an existing mesh with TetGen's ``-r`` instead of meshing the PLC again.
+
+    The points, tets, constrained faces with their markers and the region
+    attributes of `io` are handed to TetGen in place; the faces are
+    ``io.tri_faces`` when the mesh was returned with faces, else its boundary
+    faces. `tet_volumes` (one value per tet, <= 0 for none) bounds the volume
+    of each tet and adds ``-a``, e.g. from an error estimate of the previous
+    solution; `sizing` adds native kernels as in `tetrahedralize`. Switches
+    are built as in `tetrahedralize` with ``-p`` off, so quality and volume
+    parameters apply to the whole mesh; boundary markers come back as in
+    `tetrahedralize`. On failure no repro bundle is written.
+    """
+    faces, markers = io.tri_faces, "tri_markers"
+    if faces is None:
+        faces, markers = io.boundary_tri_faces, "boundary_tri_markers"
+    if tet_volumes is not None:
+        tet_volumes = np.asarray(tet_volumes, dtype=np.float64)
+        if tet_volumes.shape != (len(io.tets),):
+            raise ValueError("tet_volumes must have one value per tet")
+    control = _control_kwargs(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes)
+
+    s_params = dict(switches_params or {})
+    s_params["plc"] = False
+    s_params["reconstruct"] = True
+    switch_str = _build_switch_str(
+        s_params,
+        switches_overrides,
+        return_faces=return_faces,
+        return_edges=return_edges,
+        return_neighbors=return_neighbors,
+    )
+    raw_io = _tetwrap._refine(
+        io.points,
+        io.tets,
+        faces,
+        io.raw_markers(markers),
+        tet_volumes,
+        io.tet_attr,
+        switch_str,
+        return_boundary_faces,
+        **control,
+        **_sizing_kwargs(sizing, io.points),
+    )
+    return TetwrapIO(raw_io, interior_default=interior_default)
+
+
+__all__ = [
+    "tetrahedralize",
+    "tetrahedralize_batch",
+    "tetrahedralize_tiled",
+    "remesh_region",
+    "refine",
+    "RemeshResult",
+    "FacetCSR",
+    "CancelToken",
+    "MeshingAborted",
+    "MeshCache",
+    "TetwrapIO",
+]
@@ -0,0 +1,228 @@
+"""
+Content-addressed on-disk cache of TetGen results.
+
+A run is keyed on a hash of everything that determines its output: the vertex
+and facet arrays, markers, boundary polygons, the final switch string and the
+versions of this package and of TetGen, so an upgrade never serves old meshes.
+Each entry is a directory of ``.npy`` files plus ``meta.json``, so a hit is
+served as memory-mapped arrays without running TetGen or reading the mesh into
+memory.
+
+    cache = MeshCache("~/.cache/dtcc-tetgen")
+    io = tetrahedralize(vertices, faces, boundary_facets, cache=cache)
+"""
+from __future__ import annotations
+
+import json
+import os
+import shutil
+import time
+import uuid
+from importlib.metadata import PackageNotFoundError, version
+from pathlib import Path
+from typing import Any, Dict, Mapping, Optional, Sequence, Union
+
+import numpy as np
+
+from . import _tetwrap
+
+try:  # xxh3 when available, BLAKE2 from the standard library otherwise
+    import xxhash
+
+    def _hasher() -> Any:
+        return xxhash.xxh3_128()
+
+    _HASH_NAME = "xxh3"
+except ImportError:  # pragma: no cover - depends on the environment
+    import hashlib
+
+    def _hasher() -> Any:
+        return hashlib.blake2b(digest_size=16)
+
+    _HASH_NAME = "b2"
+
+
+# Bump when the key derivation or the entry layout changes
+CACHE_FORMAT = 1
+
+
+def _versions() -> str:
+    try:
+        package = version("dtcc-tetgen-wrapper")
+    except PackageNotFoundError:  # pragma: no cover - source tree without metadata
+        package = "unknown"
+    return f"{package};tetgen-{_tetwrap.tetgen_version}"
+
+
+# Wrapper and TetGen versions, part of every key
+_VERSIONS = _versions()
+
+# Array outputs of a raw TetwrapIO, stored as <name>.npy when present
+_ARRAY_FIELDS = (
+    "points",
+    "tets",
+    "tri_faces",
+    "tri_markers",
+    "boundary_tri_faces",
+    "boundary_tri_markers",
+    "boundary_tri_tets",
+    "boundary_tri_local_faces",
+    "edges",
+    "edge_markers",
+    "neighbors",
+    "point_markers",
+    "tet_attr",
+    "tet_vol",
+)
+
+
+class CachedIO:
+    """Raw result read back from the cache; mirrors the pybind11 TetwrapIO."""
+
+    def __init__(self, arrays: Mapping[str, np.ndarray], meta: Mapping[str, Any]) -> None:
+        for name in _ARRAY_FIELDS:
+            setattr(self, name, arrays.get(name))
+        self.corners = int(meta.get("corners", 4))
+        self.switches = str(meta.get("switches", ""))
+        self.stats: Dict[str, Any] = dict(meta.get("stats", {}))
+
+
+def _update_array(h: Any, a: Optional[np.ndarray]) -> None:
+    if a is None:
+        h.update(b"none;")
+        return
+    a = np.ascontiguousarray(a)
+    h.update(f"{a.dtype.str}{a.shape};".encode())
+    h.update(memoryview(a).cast("B"))
+
+
+def _polygon_arrays(polygons: Sequence[Sequence[int]]) -> tuple:
+    sizes = np.fromiter((len(p) for p in polygons), dtype=np.int64, count=len(polygons))
+    flat = np.fromiter((int(i) for p in polygons for i in p), dtype=np.int64, count=int(sizes.sum()))
+    return sizes, flat
+
+
+def mesh_key(
+    vertices: np.ndarray,
+    faces: np.ndarray,
+    face_markers: Optional[np.ndarray],
+    boundary_facets: Union[np.ndarray, Sequence[Sequence[int]]],
+    switches: str,
+    compute_boundary_faces: bool,
+    extra: Optional[Mapping[str, np.ndarray]] = None,
+    sizing: Optional[Sequence[Mapping[str, Any]]] = None,
+) -> str:
+    """
+    Cache key of one native call, from the arguments `_prepare_plc` produced.
+
+    Arrays are hashed with their dtype and shape, so equal values stored in
+    different dtypes give different keys (and the native result is the same
+    either way, only the lookup misses).
+    """
+    h = _hasher()
+    h.update(f"tetwrap-cache/{CACHE_FORMAT};{_VERSIONS};{switches};{int(bool(compute_boundary_faces))};".encode())
+    _update_array(h, vertices)
+    _update_array(h, faces)
+    _update_array(h, face_markers)
+    if isinstance(boundary_facets, np.ndarray):
+        _update_array(h, boundary_facets)
+    else:
+        for a in _polygon_arrays(boundary_facets):
+            _update_array(h, a)
+    for name in sorted(extra or {}):
+        h.update(f"{name};".encode())
+        _update_array(h, extra[name])
+    for kernel in sizing or ():
+        for name in sorted(kernel):
+            value = kernel[name]
+            if isinstance(value, np.ndarray):
+                h.update(f"sizing.{name};".encode())
+                _update_array(h, value)
+            else:
+                h.update(f"sizing.{name}={value!r};".encode())
+    return f"{_HASH_NAME}-{h.hexdigest()}"
+
+
+class MeshCache:
+    """
+    Directory of cached results, safe to share between processes.
+
+    Entries are written to a temporary directory and renamed into place, so
+    readers never see a partial entry; concurrent writers of the same key keep
+    whichever finished first.
+    """
+
+    def __init__(self, root: Union[str, "os.PathLike[str]"]) -> None:
+        self.root = Path(root).expanduser()
+
+    def _entry(self, key: str) -> Path:
+        return self.root / key[-2:] / key
+
+    def get(self, key: str) -> Optional[CachedIO]:
+        """Return the cached result for `key` with memory-mapped arrays, or None."""
+        entry = self._entry(key)
+        t0 = time.perf_counter()
+        try:
+            meta = json.loads((entry / "meta.json").read_text())
+        except (OSError, ValueError):
+            return None
+        # Copy-on-write maps: marker normalization writes to private pages.
+        # Empty arrays cannot be mapped and are read normally.
+        arrays = {
+            name: np.load(entry / f"{name}.npy", mmap_mode="c" if size > 0 else None)
+            for name, size in meta.get("arrays", {}).items()
+        }
+        io = CachedIO(arrays, meta)
+        elapsed = time.perf_counter() - t0
+        io.stats["time"] = {"cache_load": elapsed, "total": elapsed}
+        io.stats["cache_hit"] = 1
+        return io
+
+    def put(self, key: str, raw_io: Any) -> None:
+        """Store a raw (not yet marker-normalized) result under `key`."""
+        entry = self._entry(key)
+        if entry.exists():
+            return
+        entry.parent.mkdir(parents=True, exist_ok=True)
+        tmp = entry.parent / f".tmp-{uuid.uuid4().hex}"
+        tmp.mkdir()
+        try:
+            sizes = {}
+            for name in _ARRAY_FIELDS:
+                value = getattr(raw_io, name, None)
+                if value is None:
+                    continue
+                value = np.asarray(value)
+                np.save(tmp / f"{name}.npy", value, allow_pickle=False)
+                sizes[name] = int(value.size)
+            stats = dict(getattr(raw_io, "stats", None) or {})
+            meta = {
+                "format": CACHE_FORMAT,
+                "arrays": sizes,
+                "corners": int(getattr(raw_io, "corners", 4)),
+                "switches": str(getattr(raw_io, "switches", "")),
+                "stats": stats,
+            }
+            (tmp / "meta.json").write_text(json.dumps(meta))
+            os.rename(tmp, entry)
+        except OSError:
+            # Lost the race to another writer, or the disk is full: the result
+            # is still returned to the caller, just not cached.
+            shutil.rmtree(tmp, ignore_errors=True)
+
+    def clear(self) -> None:
+        """Remove every entry."""
+        shutil.rmtree(self.root, ignore_errors=True)
+
+
+CacheLike = Union[MeshCache, str, "os.PathLike[str]"]
+
+
+def as_cache(cache: Optional[CacheLike]) -> Optional[MeshCache]:
+    """Accept a MeshCache or a directory path."""
+    if cache is None or isinstance(cache, MeshCache):
+        return cache
+    return MeshCache(cache)
+
+
+__all__ = ["MeshCache", "CachedIO", "mesh_key", "as_cache"]
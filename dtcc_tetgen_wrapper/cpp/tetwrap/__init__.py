@@ -1,5 +1,6 @@
 from . import switches
 from ._tetwrap import _tetrahedralize  # returns TetwrapIO
+from ._tetwrap import _tetrahedralize_batch  # returns [TetwrapIO, ...]
 from ._tetwrap import build_volume_mesh  # returns (points, tets)
 from ._tetwrap import (
     TetwrapIO,
@@ -7,10 +8,12 @@ from ._tetwrap import (
 
 # Convenience alias
 tetrahedralize = _tetrahedralize
+tetrahedralize_batch = _tetrahedralize_batch
 
 __all__ = [
     "build_volume_mesh",
     "TetwrapIO",
     "tetrahedralize",
+    "tetrahedralize_batch",
     "switches",
 ]
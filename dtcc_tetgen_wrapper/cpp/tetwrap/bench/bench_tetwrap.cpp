@@ -0,0 +1,98 @@
+// google-benchmark driver for the C++ core: meshes synthetic city PLCs from
+// ~1k to ~10M tets through tetwrap::run_tetgen() and reports throughput,
+// the wrapper's own overhead and peak RSS.
+//
+//   cmake -S . -B build -DTETWRAP_BUILD_BENCHMARKS=ON
+//   cmake --build build --target tetwrap_bench
+//   build/tetwrap_bench --benchmark_filter='City/1000$|City/100000$'
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "city_plc.h"
+#include "tetwrap_core.h"
+
+namespace {
+
+// Process-wide high-water mark, so it only grows across benchmark cases
+double peak_rss_mb()
+{
+#if defined(_WIN32)
+    return 0.0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);  // bytes
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;             // KiB
+#endif
+#endif
+}
+
+double phase_seconds(const tetwrap::RunStats& stats, const char* phase)
+{
+    for (const auto& s : stats.seconds)
+        if (std::strcmp(s.first, phase) == 0) return s.second;
+    return 0.0;
+}
+
+void BM_City(benchmark::State& state)
+{
+    using namespace tetwrap;
+    const bench::CityParams params = bench::city_params_for(state.range(0));
+    const bench::CityPlc city = bench::make_city_plc(params);
+
+    PlcInput plc;
+    plc.vertices = city.vertices.data();
+    plc.num_vertices = static_cast<int>(city.vertices.size() / 3);
+    plc.mesh_facets.indices = city.faces.data();
+    plc.mesh_facets.num_indices = static_cast<std::int64_t>(city.faces.size());
+    plc.mesh_facets.count = static_cast<int>(city.face_markers.size());
+    plc.mesh_facet_markers = city.face_markers.data();
+    plc.boundary_facets.indices = city.boundary_indices.data();
+    plc.boundary_facets.offsets = city.boundary_offsets.data();
+    plc.boundary_facets.num_indices = static_cast<std::int64_t>(city.boundary_indices.size());
+    plc.boundary_facets.count = static_cast<int>(city.boundary_offsets.size() - 1);
+    const std::string sw = "pQq1.5a" + std::to_string(params.max_volume);
+    plc.switches.assign(sw.begin(), sw.end());
+    plc.switches.push_back('\0');
+
+    double tets = 0.0;
+    double tetgen_s = 0.0;
+    double overhead_s = 0.0;
+    for (auto _ : state) {
+        MeshResult mesh = run_tetgen(plc);
+        tets = mesh.out->numberoftetrahedra;
+        const double pack = phase_seconds(mesh.stats, "pack_input");
+        const double post = phase_seconds(mesh.stats, "boundary_faces");
+        double total = 0.0;
+        for (const auto& s : mesh.stats.seconds) total += s.second;
+        tetgen_s += total - pack - post;
+        overhead_s += pack + post;
+        benchmark::DoNotOptimize(mesh.boundary_faces.data());
+    }
+
+    const double iterations = static_cast<double>(state.iterations());
+    state.counters["tets"] = tets;
+    state.counters["tets_per_s"] = benchmark::Counter(tets, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["tetgen_s"] = tetgen_s / iterations;
+    state.counters["overhead_s"] = overhead_s / iterations;
+    state.counters["peak_rss_mb"] = peak_rss_mb();
+}
+
+}  // namespace
+
+BENCHMARK(BM_City)
+    ->Name("City")
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,168 @@
+// Synthetic city PLC: a height-field terrain with box buildings cut out of
+// the volume, closed by a flat top and four vertical side polygons.
+//
+// Mirrors benchmarks/city_plc.py; keep both generators in sync so the C++
+// and Python benchmarks mesh the same inputs.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tetwrap {
+namespace bench {
+
+struct CityParams {
+    int cells = 16;                  // terrain cells per side
+    int buildings = 2;               // buildings per side
+    int footprint = 3;               // building footprint in cells per side
+    double size = 1000.0;            // domain side length
+    double height = 200.0;           // domain top (z)
+    double relief = 10.0;            // terrain amplitude
+    double building_height = 30.0;   // roof height above the highest footprint vertex
+    double max_volume = 0.0;         // TetGen -a bound, 0 for none
+};
+
+struct CityPlc {
+    std::vector<double> vertices;              // (N,3)
+    std::vector<int> faces;                    // (M,3) terrain, walls and roofs
+    std::vector<int> face_markers;             // (M,) 0 terrain, 1 buildings
+    std::vector<int> boundary_indices;         // CSR: top, north, east, south, west
+    std::vector<std::int64_t> boundary_offsets;
+};
+
+// Parameters whose mesh has roughly `target_tets` tetrahedra under -q1.5.
+// The surface resolution follows the volume resolution; the -a bound
+// assumes quality tets average about half of it.
+inline CityParams city_params_for(long long target_tets)
+{
+    CityParams p;
+    const double volume = p.size * p.size * p.height;
+    p.max_volume = 2.0 * volume / static_cast<double>(std::max(1LL, target_tets));
+    const double edge = std::cbrt(p.max_volume);
+    p.cells = std::max(16, static_cast<int>(std::lround(p.size / edge)));
+    p.buildings = std::max(1, p.cells / 8);
+    p.footprint = 3;
+    return p;
+}
+
+inline double city_terrain_z(const CityParams& p, double x, double y)
+{
+    const double pi = 3.14159265358979323846;
+    return p.relief * (0.6 * std::sin(2.0 * pi * x / p.size) * std::cos(3.0 * pi * y / p.size) +
+                       0.4 * std::sin(5.0 * pi * (x + y) / p.size));
+}
+
+inline CityPlc make_city_plc(const CityParams& p)
+{
+    const int n = p.cells;
+    const int step = p.buildings > 0 ? n / p.buildings : n;
+    if (n < 2) throw std::invalid_argument("city: cells must be >= 2");
+    if (p.buildings > 0 && step < p.footprint + 2)
+        throw std::invalid_argument("city: " + std::to_string(p.buildings) + " buildings of " +
+                                    std::to_string(p.footprint) + " cells do not fit in " +
+                                    std::to_string(n) + " cells");
+
+    CityPlc plc;
+    auto add_vertex = [&](double x, double y, double z) {
+        plc.vertices.insert(plc.vertices.end(), {x, y, z});
+        return static_cast<int>(plc.vertices.size() / 3 - 1);
+    };
+    auto add_tri = [&](int a, int b, int c, int marker) {
+        plc.faces.insert(plc.faces.end(), {a, b, c});
+        plc.face_markers.push_back(marker);
+    };
+
+    // Terrain grid vertices (i along x, j along y)
+    const double h = p.size / n;
+    auto g = [&](int i, int j) { return j * (n + 1) + i; };
+    for (int j = 0; j <= n; ++j)
+        for (int i = 0; i <= n; ++i)
+            add_vertex(i * h, j * h, city_terrain_z(p, i * h, j * h));
+
+    // Footprints: cells [i0, i0+footprint) x [j0, j0+footprint), centered in their block
+    std::vector<char> built(static_cast<std::size_t>(n) * n, 0);
+    const int pad = (step - p.footprint) / 2;
+    for (int bj = 0; bj < p.buildings; ++bj) {
+        for (int bi = 0; bi < p.buildings; ++bi) {
+            const int i0 = bi * step + pad;
+            const int j0 = bj * step + pad;
+            const int k = p.footprint;
+            for (int j = j0; j < j0 + k; ++j)
+                for (int i = i0; i < i0 + k; ++i) built[static_cast<std::size_t>(j) * n + i] = 1;
+
+            double roof = -1e300;
+            for (int j = j0; j <= j0 + k; ++j)
+                for (int i = i0; i <= i0 + k; ++i) roof = std::max(roof, plc.vertices[3 * g(i, j) + 2]);
+            roof += p.building_height;
+
+            // Flat roof grid over the footprint
+            std::vector<int> r(static_cast<std::size_t>(k + 1) * (k + 1));
+            for (int j = 0; j <= k; ++j)
+                for (int i = 0; i <= k; ++i) r[j * (k + 1) + i] = add_vertex((i0 + i) * h, (j0 + j) * h, roof);
+            for (int j = 0; j < k; ++j) {
+                for (int i = 0; i < k; ++i) {
+                    const int a = r[j * (k + 1) + i], b = r[j * (k + 1) + i + 1];
+                    const int c = r[(j + 1) * (k + 1) + i + 1], d = r[(j + 1) * (k + 1) + i];
+                    add_tri(a, b, c, 1);
+                    add_tri(a, c, d, 1);
+                }
+            }
+
+            // Walls: perimeter walked counter-clockwise, one quad per cell edge
+            std::vector<std::pair<int, int>> ring;  // (i, j) offsets in the footprint
+            for (int i = 0; i < k; ++i) ring.emplace_back(i, 0);
+            for (int j = 0; j < k; ++j) ring.emplace_back(k, j);
+            for (int i = k; i > 0; --i) ring.emplace_back(i, k);
+            for (int j = k; j > 0; --j) ring.emplace_back(0, j);
+            for (std::size_t e = 0; e < ring.size(); ++e) {
+                const auto& u = ring[e];
+                const auto& v = ring[(e + 1) % ring.size()];
+                const int a = g(i0 + u.first, j0 + u.second), b = g(i0 + v.first, j0 + v.second);
+                const int A = r[u.second * (k + 1) + u.first], B = r[v.second * (k + 1) + v.first];
+                add_tri(a, b, B, 1);
+                add_tri(a, B, A, 1);
+            }
+        }
+    }
+
+    // Terrain triangles outside the footprints
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            if (built[static_cast<std::size_t>(j) * n + i]) continue;
+            add_tri(g(i, j), g(i + 1, j), g(i + 1, j + 1), 0);
+            add_tri(g(i, j), g(i + 1, j + 1), g(i, j + 1), 0);
+        }
+    }
+
+    // Closing polygons, in the order top, north, east, south, west
+    const int t00 = add_vertex(0.0, 0.0, p.height);
+    const int t10 = add_vertex(p.size, 0.0, p.height);
+    const int t11 = add_vertex(p.size, p.size, p.height);
+    const int t01 = add_vertex(0.0, p.size, p.height);
+    plc.boundary_offsets.push_back(0);
+    auto close_polygon = [&]() { plc.boundary_offsets.push_back(static_cast<std::int64_t>(plc.boundary_indices.size())); };
+    auto& bi = plc.boundary_indices;
+
+    bi.insert(bi.end(), {t00, t10, t11, t01});
+    close_polygon();
+    for (int i = n; i >= 0; --i) bi.push_back(g(i, n));
+    bi.insert(bi.end(), {t01, t11});
+    close_polygon();
+    for (int j = 0; j <= n; ++j) bi.push_back(g(n, j));
+    bi.insert(bi.end(), {t11, t10});
+    close_polygon();
+    for (int i = 0; i <= n; ++i) bi.push_back(g(i, 0));
+    bi.insert(bi.end(), {t10, t00});
+    close_polygon();
+    for (int j = n; j >= 0; --j) bi.push_back(g(0, j));
+    bi.insert(bi.end(), {t00, t01});
+    close_polygon();
+    return plc;
+}
+
+}  // namespace bench
+}  // namespace tetwrap
@@ -2,121 +2,83 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
-#include <vector>
-#include <stdexcept>
 #include <algorithm>
 #include <array>
-#include <map>
+#include <vector>
+#include <stdexcept>
 #include <cstddef>
-#include <fstream>
-#include <sstream>
-#include <iostream>
-#include <iomanip>
-#include <limits>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <exception>
 
-#include "tetgen.cxx"
+#include "tetwrap_core.h"
 
 namespace py = pybind11;
 
 // ===================== Helper conversions =====================
-static py::array_t<double> to_array_f64(const REAL* src, int n, int m)
+static_assert(std::is_same<REAL, double>::value, "TetGen must be built with REAL=double");
+
+// Hand a tetgenio-owned buffer to NumPy without copying. The capsule frees it
+// with delete[] (tetgenio allocates every list with new[]) and the source
+// pointer is cleared so the tetgenio destructor does not free it again.
+template <typename T>
+static py::array_t<T> take_buffer(T*& src, std::vector<ssize_t> shape)
 {
-    if (!src || n <= 0 || m <= 0) return py::array_t<double>();
-    py::array_t<double> A({n, m});
-    auto a = A.mutable_unchecked<2>();
-    for (int i = 0; i < n; ++i)
-        for (int j = 0; j < m; ++j)
-            a(i, j) = src[i * m + j];
-    return A;
+    ssize_t count = 1;
+    for (ssize_t d : shape) count *= d;
+    if (count <= 0) return py::array_t<T>(std::move(shape));   // e.g. (0,3), not (0,)
+    if (!src) return py::array_t<T>();
+    T* data = src;
+    src = nullptr;
+    py::capsule owner(data, [](void* p) { delete[] static_cast<T*>(p); });
+    return py::array_t<T>(std::move(shape), data, owner);
 }
 
-static py::array_t<int> to_array_i32(const int* src, int n, int m)
+static py::array_t<double> take_array_f64(REAL*& src, int n, int m)
 {
-    if (!src || n <= 0 || m <= 0) return py::array_t<int>();
-    py::array_t<int> A({n, m});
-    auto a = A.mutable_unchecked<2>();
-    for (int i = 0; i < n; ++i)
-        for (int j = 0; j < m; ++j)
-            a(i, j) = src[i * m + j];
-    return A;
+    return take_buffer<double>(src, {n, m});
 }
 
-static py::array_t<int> to_vector_i32(const int* src, int n)
+static py::array_t<int> take_array_i32(int*& src, int n, int m)
 {
-    if (!src || n <= 0) return py::array_t<int>();
-    py::array_t<int> A({n});
-    auto a = A.mutable_unchecked<1>();
-    for (int i = 0; i < n; ++i)
-        a(i) = src[i];
-    return A;
+    return take_buffer<int>(src, {n, m});
 }
 
-static py::array_t<double> to_vector_f64(const REAL* src, int n)
+static py::array_t<int> take_vector_i32(int*& src, int n)
 {
-    if (!src || n <= 0) return py::array_t<double>();
-    py::array_t<double> A({n});
-    auto a = A.mutable_unchecked<1>();
-    for (int i = 0; i < n; ++i)
-        a(i) = src[i];
-    return A;
+    return take_buffer<int>(src, {n});
 }
 
-// Write vertices and faces to CSV-ish files for debugging.
-static std::string dump_plc(const py::array_t<double, py::array::c_style | py::array::forcecast>& vertices,
-                            const py::array_t<int,    py::array::c_style | py::array::forcecast>& mesh_facets,
-                            const std::vector<std::vector<int>>& boundary_facets,
-                            const std::string& prefix)
+static py::array_t<double> take_vector_f64(REAL*& src, int n)
 {
-    std::vector<std::string> written;
-
-    try {
-        auto V = vertices.unchecked<2>();
-        auto F = mesh_facets.unchecked<2>();
-
-        const std::string v_path = prefix + "_vertices.csv";
-        std::ofstream vout(v_path);
-        if (vout) {
-            vout << "x,y,z\n";
-            vout << std::setprecision(17);
-            for (ssize_t i = 0; i < V.shape(0); ++i) {
-                vout << V(i, 0) << ',' << V(i, 1) << ',' << V(i, 2) << '\n';
-            }
-            written.push_back(v_path);
-        }
-
-        const std::string f_path = prefix + "_faces.csv";
-        std::ofstream fout(f_path);
-        if (fout) {
-            fout << "v0,v1,v2\n";
-            for (ssize_t i = 0; i < F.shape(0); ++i) {
-                fout << F(i, 0) << ',' << F(i, 1) << ',' << F(i, 2) << '\n';
-            }
-            written.push_back(f_path);
-        }
+    return take_buffer<double>(src, {n});
+}
 
-        const std::string b_path = prefix + "_boundary_facets.txt";
-        std::ofstream bout(b_path);
-        if (bout) {
-            for (size_t bi = 0; bi < boundary_facets.size(); ++bi) {
-                bout << "# facet " << bi << '\n';
-                const auto& poly = boundary_facets[bi];
-                for (size_t j = 0; j < poly.size(); ++j) {
-                    bout << poly[j] << (j + 1 == poly.size() ? '\n' : ' ');
-                }
-            }
-            written.push_back(b_path);
-        }
-    } catch (...) {
-        // Swallow dump errors; we'll simply return what we managed to write.
-    }
+// Same for buffers computed by the wrapper itself: the vector is moved into
+// the capsule so NumPy owns it.
+template <typename T>
+static py::array_t<T> take_vector(std::vector<T>&& v, std::vector<ssize_t> shape)
+{
+    auto* holder = new std::vector<T>(std::move(v));
+    py::capsule owner(holder, [](void* p) { delete static_cast<std::vector<T>*>(p); });
+    return py::array_t<T>(std::move(shape), holder->data(), owner);
+}
 
-    if (written.empty()) return std::string();
-    std::ostringstream os;
-    for (size_t i = 0; i < written.size(); ++i) {
-        if (i) os << ';';
-        os << written[i];
-    }
-    return os.str();
+// Streamed arrays: NumPy views of the mapped .npy files, each keeping its
+// mapping alive through the capsule.
+template <typename T>
+static py::array_t<T> take_mapped(tetwrap::NpyFile& file)
+{
+    std::vector<ssize_t> shape(file.shape().begin(), file.shape().end());
+    if (!file.data<T>()) return py::array_t<T>(std::move(shape));
+    auto* holder = new tetwrap::NpyFile(std::move(file));
+    py::capsule owner(holder, [](void* p) { delete static_cast<tetwrap::NpyFile*>(p); });
+    return py::array_t<T>(std::move(shape), holder->data<T>(), owner);
 }
 
 // ===================== Rich IO result =====================
@@ -127,6 +89,8 @@ struct TetwrapIO {
     py::object tri_markers;   // (F,) int32 or None
     py::object boundary_tri_faces; // (BF,3) int32 or None
     py::object boundary_tri_markers; // (BF,) int32 or None
+    py::object boundary_tri_tets; // (BF,) int32 owning tet or None
+    py::object boundary_tri_local_faces; // (BF,) int32 face id 0..3 or None
     py::object edges;         // (E,2) int32 or None
     py::object edge_markers;  // (E,) int32 or None
     py::object neighbors;     // (K,4) int32 or None
@@ -135,209 +99,12 @@ struct TetwrapIO {
     py::object tet_vol;       // (K,) float64 or None
     int corners = 4;
     std::string switches;
+    py::dict stats;           // {"time": {phase: seconds}, counter: value, ...}
 };
 
-// Convert TetGen output to NumPy (vertices, tets)
-static std::pair<py::array_t<double>, py::array_t<int>>
-to_numpy(const tetgenio &out)
+// Build switch buffer (NUL-terminated) from str, bytes or a 1D byte array
+static std::vector<char> switch_buffer(const py::object& tetgen_switches)
 {
-    const int N = out.numberofpoints;
-    const int K = out.numberoftetrahedra;
-    const int corners = out.numberofcorners; // typically 4, but could be 10 for higher order
-
-    py::array_t<double> V({N, 3});
-    {
-        auto v = V.mutable_unchecked<2>();
-        for (int i = 0; i < N; ++i)
-        {
-            v(i, 0) = out.pointlist[3 * i + 0];
-            v(i, 1) = out.pointlist[3 * i + 1];
-            v(i, 2) = out.pointlist[3 * i + 2];
-        }
-    }
-
-    py::array_t<int> T({K, corners});
-    {
-        auto t = T.mutable_unchecked<2>();
-        for (int i = 0; i < K; ++i)
-        {
-            for (int j = 0; j < corners; ++j)
-            {
-                t(i, j) = out.tetrahedronlist[i * corners + j];
-            }
-        }
-    }
-
-    return {V, T};
-}
-
-// (T,4) tets, (T,4) neighbors -> (B,3) boundary faces (indices into points)
-static py::array_t<int> compute_boundary_face_tris(
-    const py::array_t<int, py::array::c_style | py::array::forcecast>& tets_,
-    const py::array_t<int, py::array::c_style | py::array::forcecast>& nbrs_)
-{
-    if (tets_.ndim() != 2 || tets_.shape(1) != 4)
-        throw std::runtime_error("tets must have shape (T,4)");
-    if (nbrs_.ndim() != 2 || nbrs_.shape(1) != 4)
-        throw std::runtime_error("neighbors must have shape (T,4)");
-    if (tets_.shape(0) != nbrs_.shape(0))
-        throw std::runtime_error("tets and neighbors must have same length");
-
-    auto tets = tets_.unchecked<2>();
-    auto nbrs = nbrs_.unchecked<2>();
-    const ssize_t T = tets.shape(0);
-
-    // local face patterns: face opposite vertex k
-    const int faces_of_tet[4][3] = {
-        {1,2,3},  // opposite 0
-        {0,3,2},  // opposite 1
-        {0,1,3},  // opposite 2
-        {0,2,1}   // opposite 3
-    };
-
-    // First pass: count boundary faces
-    ssize_t B = 0;
-    for (ssize_t i = 0; i < T; ++i)
-        for (int lf = 0; lf < 4; ++lf)
-            if (nbrs(i, lf) < 0) ++B;
-
-    // Allocate (B,3) int32
-    py::array_t<int> faces({B, (ssize_t)3});
-    auto F = faces.mutable_unchecked<2>();
-
-    // Second pass: fill
-    ssize_t b = 0;
-    for (ssize_t i = 0; i < T; ++i) {
-        for (int lf = 0; lf < 4; ++lf) {
-            if (nbrs(i, lf) < 0) {
-                const int* pat = faces_of_tet[lf];
-                F(b,0) = tets(i, pat[0]);
-                F(b,1) = tets(i, pat[1]);
-                F(b,2) = tets(i, pat[2]);
-                ++b;
-            }
-        }
-    }
-    return faces;
-}
-
-// Core routine: run TetGen and produce rich IO
-static TetwrapIO tetrahedralize_core(
-    py::array_t<double, py::array::c_style | py::array::forcecast> vertices,
-    py::array_t<int,    py::array::c_style | py::array::forcecast> mesh_facets,
-    py::object mesh_facet_markers_obj,
-    const std::vector<std::vector<int>> &boundary_facets,
-    py::object tetgen_switches,
-    bool compute_boundary_faces = true  )
-{
-    // Basic shape checks
-    if (vertices.ndim() != 2 || vertices.shape(1) != 3)
-        throw std::runtime_error("vertices must have shape (N,3)");
-    if (mesh_facets.ndim() != 2 || mesh_facets.shape(1) != 3)
-        throw std::runtime_error("mesh_facets must have shape (M,3)");
-    if (boundary_facets.size() < 1)
-        throw std::runtime_error("boundary_facets must contain at least one polygon (list of vertex indices)");
-
-    auto V = vertices.unchecked<2>();
-    auto F = mesh_facets.unchecked<2>();
-    const int N = static_cast<int>(V.shape(0));
-    const int M = static_cast<int>(F.shape(0));
-    const int B = static_cast<int>(boundary_facets.size());
-    py::array_t<int, py::array::c_style | py::array::forcecast> mesh_facet_markers;
-    const int* mesh_facet_marker_ptr = nullptr;
-    if (!mesh_facet_markers_obj.is_none()) {
-        mesh_facet_markers = mesh_facet_markers_obj.cast<py::array_t<int, py::array::c_style | py::array::forcecast>>();
-        if (mesh_facet_markers.ndim() != 1)
-            throw std::runtime_error("mesh_facet_markers must be a 1D array");
-        if (mesh_facet_markers.shape(0) != M)
-            throw std::runtime_error("mesh_facet_markers length must match number of mesh facets");
-        mesh_facet_marker_ptr = mesh_facet_markers.data();
-    }
-
-    if (N <= 0) throw std::runtime_error("vertices: N <= 0");
-    if (M < 0)  throw std::runtime_error("mesh_facets: M < 0");
-
-    // Index range checks
-    for (int i = 0; i < M; ++i)
-    {
-        for (int k = 0; k < 3; ++k)
-        {
-            int vid = F(i, k);
-            if (vid < 0 || vid >= N)
-                throw std::runtime_error("mesh_facets index out of range at row " + std::to_string(i));
-        }
-    }
-    for (size_t bi = 0; bi < boundary_facets.size(); ++bi)
-    {
-        const auto &poly = boundary_facets[bi];
-        if (poly.size() < 3)
-            throw std::runtime_error("boundary facet has fewer than 3 vertices: polygon " + std::to_string(bi));
-        for (int vid : poly)
-        {
-            if (vid < 0 || vid >= N)
-                throw std::runtime_error("boundary_facets index out of range at polygon " + std::to_string(bi));
-        }
-    }
-
-    tetgenio in, out;
-
-    // Points
-    in.firstnumber = 0; // 0-based indexing
-    in.numberofpoints = N;
-    in.pointlist = new REAL[in.numberofpoints * 3];
-    for (int i = 0; i < N; ++i)
-    {
-        in.pointlist[3 * i + 0] = static_cast<REAL>(V(i, 0));
-        in.pointlist[3 * i + 1] = static_cast<REAL>(V(i, 1));
-        in.pointlist[3 * i + 2] = static_cast<REAL>(V(i, 2));
-    }
-
-    // Facets: mesh triangles + boundary polygons
-    const int T = M + B;
-    in.numberoffacets = T;
-    in.facetlist = new tetgenio::facet[in.numberoffacets]();
-    // Provide facet markers so output tri faces carry labels on boundary
-    in.facetmarkerlist = new int[in.numberoffacets];
-
-    // Mesh triangles (marker 0)
-    for (int fi = 0; fi < M; ++fi)
-    {
-        tetgenio::facet &fac = in.facetlist[fi];
-        fac.numberofholes = 0;
-        fac.holelist = nullptr;
-        fac.numberofpolygons = 1;
-        fac.polygonlist = new tetgenio::polygon[1];
-        tetgenio::polygon &poly = fac.polygonlist[0];
-        poly.numberofvertices = 3;
-        poly.vertexlist = new int[3];
-        poly.vertexlist[0] = F(fi, 0);
-        poly.vertexlist[1] = F(fi, 1);
-        poly.vertexlist[2] = F(fi, 2);
-        int marker_value = -1;
-        if (mesh_facet_marker_ptr) {
-            const int raw_marker = mesh_facet_marker_ptr[fi];
-            marker_value = (raw_marker < 0) ? -1 : (raw_marker + 1);
-        }
-        in.facetmarkerlist[fi] = marker_value;
-    }
-
-    // Boundary polygons (marker 1..B)
-    for (int bi = 0; bi < B; ++bi)
-    {
-        tetgenio::facet &fac = in.facetlist[M + bi];
-        fac.numberofholes = 0;
-        fac.holelist = nullptr;
-        fac.numberofpolygons = 1;
-        fac.polygonlist = new tetgenio::polygon[1];
-        tetgenio::polygon &poly = fac.polygonlist[0];
-        const auto &loop = boundary_facets[bi];
-        poly.numberofvertices = static_cast<int>(loop.size());
-        poly.vertexlist = new int[poly.numberofvertices];
-        for (int j = 0; j < poly.numberofvertices; ++j) poly.vertexlist[j] = loop[j];
-        in.facetmarkerlist[M + bi] =  - (bi + 2);
-    }
-
-    // Build switch buffer (NUL-terminated)
     std::vector<char> sw;
     if (py::isinstance<py::str>(tetgen_switches) || py::isinstance<py::bytes>(tetgen_switches))
     {
@@ -357,115 +124,37 @@ static TetwrapIO tetrahedralize_core(
     {
         throw std::runtime_error("tetgen_switches must be str, bytes, or 1D byte array");
     }
-    // Ensure neighbors are requested if boundary faces are needed
-    if (compute_boundary_faces) {
-        bool has_n = false;
-        bool has_f = false;
-        for (char c : sw) {
-            if (c == '\0') break;
-            if (c == 'n') has_n = true;
-            if (c == 'f') has_f = true;
-        }
-        if (!has_n || !has_f) {
-            if (!sw.empty() && sw.back() == '\0') sw.pop_back();
-            if (!has_n) sw.push_back('n');
-            if (!has_f) sw.push_back('f');
-            sw.push_back('\0');
-        }
-    }
-
-
-    // Tetrahedralize with exception handling
-    // try {
-    //     tetrahedralize(sw.data(), &in, &out);
-    // } catch (const std::exception& e) {
-    //     throw std::runtime_error(std::string("TetGen failed: ") + e.what());
-    // } catch (...) {
-    //     throw std::runtime_error("TetGen failed with an unknown error. This may be due to invalid input geometry or incompatible switches.");
-    // }
-    try {
-        tetrahedralize(sw.data(), &in, &out);
-    } catch (int code) {
-        std::string msg;
-        switch (code) {
-        case 1:  msg = "out of memory"; break;
-        case 2:  msg = "internal error (report bug)"; break;
-        case 3:  msg = "input surface has self-intersections"; break;
-        case 4:  msg = "very small input feature size (use -T to relax)"; break;
-        case 5:  msg = "two very close input facets (try -Y)"; break;
-        case 10: msg = "input error"; break;
-        case 200: msg = "boundary contains Steiner points (-YY)"; break;
-        default: msg = "unknown TetGen code"; break;
-        }
-
-        // Reconstruct switch string (strip trailing NUL if present)
-        std::string sw_str;
-        if (!sw.empty()) {
-            const bool has_nul = sw.back() == '\0';
-            sw_str.assign(sw.begin(), sw.begin() + static_cast<std::ptrdiff_t>(sw.size() - (has_nul ? 1 : 0)));
-        }
-
-        // Basic input summary
-        std::ostringstream summary;
-        summary << "TetGen failed (code " << code << "): " << msg
-                << " | switches=\"" << sw_str << "\""
-                << " | points=" << N
-                << ", mesh_facets=" << M
-                << ", boundary_polys=" << B;
-
-        // Dump PLC for repro
-        const std::string dump_paths = dump_plc(vertices, mesh_facets, boundary_facets, "tetgen_fail");
-        if (!dump_paths.empty()) {
-            summary << " | dump_files=" << dump_paths;
-        }
+    return sw;
+}
 
-        // Print to stderr for visibility, then raise to Python
-        std::cerr << summary.str() << std::endl;
-        throw std::runtime_error(summary.str());
-    } catch (const std::exception& e) {
-        throw std::runtime_error(std::string("TetGen failed: ") + e.what());
-    } catch (...) {
-        throw std::runtime_error("TetGen failed with an unknown error. This may be due to invalid input geometry or incompatible switches.");
-    }
+// Wrap the buffers of a finished run as NumPy arrays. Runs with the GIL held
+// but only allocates array headers; the data itself is never copied.
+static TetwrapIO to_tetwrap_io(tetwrap::MeshResult& mesh)
+{
+    tetgenio& out = *mesh.out;
 
-    // Populate result
     TetwrapIO res;
-    res.points   = to_array_f64(out.pointlist, out.numberofpoints, 3);
-    res.tets     = to_array_i32(out.tetrahedronlist, out.numberoftetrahedra, out.numberofcorners);
+    res.points   = take_array_f64(out.pointlist, out.numberofpoints, 3);
+    res.tets     = take_array_i32(out.tetrahedronlist, out.numberoftetrahedra, out.numberofcorners);
     res.corners  = out.numberofcorners;
-    // reconstruct switch string if provided as array
-    if (py::isinstance<py::str>(tetgen_switches)) res.switches = py::cast<std::string>(tetgen_switches);
-    else res.switches = ""; // optional
 
     // Output Faces (-f)
     if (out.numberoftrifaces > 0 && out.trifacelist) {
-        res.tri_faces = to_array_i32(out.trifacelist, out.numberoftrifaces, 3);
+        res.tri_faces = take_array_i32(out.trifacelist, out.numberoftrifaces, 3);
         if (out.trifacemarkerlist)
-            res.tri_markers = to_vector_i32(out.trifacemarkerlist, out.numberoftrifaces);
+            res.tri_markers = take_vector_i32(out.trifacemarkerlist, out.numberoftrifaces);
         else
             res.tri_markers = py::none();
     } else {
         res.tri_faces   = py::none();
         res.tri_markers = py::none();
     }
-    std::map<std::array<int, 3>, int> triface_marker_map;
-    if (out.numberoftrifaces > 0 && out.trifacelist && out.trifacemarkerlist) {
-        for (int i = 0; i < out.numberoftrifaces; ++i) {
-            std::array<int, 3> key = {
-                out.trifacelist[3 * i + 0],
-                out.trifacelist[3 * i + 1],
-                out.trifacelist[3 * i + 2]
-            };
-            std::sort(key.begin(), key.end());
-            triface_marker_map[key] = out.trifacemarkerlist[i];
-        }
-    }
 
     // Output Edges (-e)
     if (out.numberofedges > 0 && out.edgelist) {
-        res.edges = to_array_i32(out.edgelist, out.numberofedges, 2);
+        res.edges = take_array_i32(out.edgelist, out.numberofedges, 2);
         if (out.edgemarkerlist)
-            res.edge_markers = to_vector_i32(out.edgemarkerlist, out.numberofedges);
+            res.edge_markers = take_vector_i32(out.edgemarkerlist, out.numberofedges);
         else
             res.edge_markers = py::none();
     } else {
@@ -475,59 +164,1057 @@ static TetwrapIO tetrahedralize_core(
 
     // Output Neighbors (-n)
     if (out.neighborlist)
-        res.neighbors = to_array_i32(out.neighborlist, out.numberoftetrahedra, 4);
+        res.neighbors = take_array_i32(out.neighborlist, out.numberoftetrahedra, 4);
     else
         res.neighbors = py::none();
 
-    if (compute_boundary_faces && !res.neighbors.is_none()) {
-        py::array_t<int> boundary_faces =
-            compute_boundary_face_tris(
-                res.tets.cast<py::array_t<int>>(),
-                res.neighbors.cast<py::array_t<int>>());
-        res.boundary_tri_faces = boundary_faces;
-
-        if (!triface_marker_map.empty()) {
-            auto faces = boundary_faces.unchecked<2>();
-            py::array_t<int> boundary_markers({faces.shape(0)});
-            auto markers = boundary_markers.mutable_unchecked<1>();
-            for (ssize_t i = 0; i < faces.shape(0); ++i) {
-                std::array<int, 3> key = {faces(i, 0), faces(i, 1), faces(i, 2)};
-                std::sort(key.begin(), key.end());
-                auto it = triface_marker_map.find(key);
-                markers(i) = (it != triface_marker_map.end()) ? it->second : 0;
-            }
-            res.boundary_tri_markers = boundary_markers;
-        } else {
+    if (mesh.has_boundary_faces) {
+        const ssize_t BF = static_cast<ssize_t>(mesh.boundary_faces.size() / 3);
+        res.boundary_tri_faces = take_vector(std::move(mesh.boundary_faces), {BF, 3});
+        res.boundary_tri_tets = take_vector(std::move(mesh.boundary_tets), {BF});
+        res.boundary_tri_local_faces = take_vector(std::move(mesh.boundary_local_faces), {BF});
+        if (mesh.has_boundary_markers)
+            res.boundary_tri_markers = take_vector(std::move(mesh.boundary_markers), {BF});
+        else
             res.boundary_tri_markers = py::none();
-        }
     } else {
         res.boundary_tri_faces = py::none();
         res.boundary_tri_markers = py::none();
+        res.boundary_tri_tets = py::none();
+        res.boundary_tri_local_faces = py::none();
     }
     // Point markers
     if (out.pointmarkerlist)
-        res.point_markers = to_vector_i32(out.pointmarkerlist, out.numberofpoints);
+        res.point_markers = take_vector_i32(out.pointmarkerlist, out.numberofpoints);
     else
         res.point_markers = py::none();
 
     // Attributes (-A with regions)
     if (out.tetrahedronattributelist && out.numberoftetrahedronattributes > 0)
-        res.tet_attr = to_array_f64(out.tetrahedronattributelist, out.numberoftetrahedra, out.numberoftetrahedronattributes);
+        res.tet_attr = take_array_f64(out.tetrahedronattributelist, out.numberoftetrahedra, out.numberoftetrahedronattributes);
     else
         res.tet_attr = py::none();
 
     // Volumes (if present)
     if (out.tetrahedronvolumelist)
-        res.tet_vol = to_vector_f64(out.tetrahedronvolumelist, out.numberoftetrahedra);
+        res.tet_vol = take_vector_f64(out.tetrahedronvolumelist, out.numberoftetrahedra);
     else
         res.tet_vol = py::none();
 
+    // Arrays streamed to output_dir replace the (absent) tetgenio lists
+    if (mesh.streamed) {
+        tetwrap::StreamedMesh& s = *mesh.streamed;
+        if (s.points.is_open()) res.points = take_mapped<double>(s.points);
+        if (s.point_markers.is_open()) res.point_markers = take_mapped<int>(s.point_markers);
+        if (s.tets.is_open()) res.tets = take_mapped<int>(s.tets);
+        if (s.neighbors.is_open()) res.neighbors = take_mapped<int>(s.neighbors);
+        if (s.tet_attr.is_open()) res.tet_attr = take_mapped<double>(s.tet_attr);
+        if (s.boundary_faces.is_open()) {
+            res.boundary_tri_faces = take_mapped<int>(s.boundary_faces);
+            res.boundary_tri_tets = take_mapped<int>(s.boundary_tets);
+            res.boundary_tri_local_faces = take_mapped<int>(s.boundary_local_faces);
+            if (s.boundary_markers.is_open()) res.boundary_tri_markers = take_mapped<int>(s.boundary_markers);
+        }
+    }
+
+    return res;
+}
+
+using ArrayF64 = py::array_t<double, py::array::c_style | py::array::forcecast>;
+using ArrayI32 = py::array_t<int,    py::array::c_style | py::array::forcecast>;
+using ArrayI64 = py::array_t<std::int64_t, py::array::c_style | py::array::forcecast>;
+
+// Coordinates may be float32/float64 and indices int32/int64; such arrays are
+// borrowed as they are. Any other dtype, or a non C-contiguous layout, is
+// converted once to float64/int32.
+static py::array borrow_coords(const py::object& obj)
+{
+    if (py::isinstance<py::array_t<double, py::array::c_style>>(obj) ||
+        py::isinstance<py::array_t<float, py::array::c_style>>(obj))
+        return py::reinterpret_borrow<py::array>(obj);
+    return obj.cast<ArrayF64>();
+}
+
+static py::array borrow_indices(const py::object& obj)
+{
+    if (py::isinstance<py::array_t<std::int32_t, py::array::c_style>>(obj) ||
+        py::isinstance<py::array_t<std::int64_t, py::array::c_style>>(obj))
+        return py::reinterpret_borrow<py::array>(obj);
+    return obj.cast<ArrayI32>();
+}
+
+// Markers are small; convert them once to int32 if needed
+static ArrayI32 marker_array(const py::object& obj, int expected, const std::string& name, const char* what)
+{
+    ArrayI32 arr = obj.cast<ArrayI32>();
+    if (arr.ndim() != 1)
+        throw std::runtime_error(name + " must be a 1D array");
+    if (arr.shape(0) != expected)
+        throw std::runtime_error(name + " length must match number of " + what);
+    return arr;
+}
+
+// The arguments describing one PLC, as passed from Python. Facet lists are
+// either arrays ((M,3) triangles or flat CSR indices when `*_offsets` is
+// given) or, for boundary_facets only, a list of vertex index lists.
+struct PlcObjects {
+    py::object vertices;
+    py::object mesh_facets;
+    py::object mesh_facet_offsets = py::none();
+    py::object mesh_facet_markers = py::none();
+    py::object boundary_facets;
+    py::object boundary_facet_offsets = py::none();
+    py::object boundary_facet_markers = py::none();
+    py::object tetgen_switches;
+};
+
+// Python-side inputs of one PLC. The arrays stay alive here while `plc`
+// borrows their buffers.
+struct PlcArgs {
+    py::array vertices;
+    py::array mesh_facets;          // (M,3) or flat CSR indices
+    ArrayI64 mesh_facet_offsets;    // (M+1,) or empty for triangles
+    ArrayI32 mesh_facet_markers;
+    py::array boundary_facets;      // flat CSR indices
+    ArrayI64 boundary_facet_offsets; // (B+1,)
+    ArrayI32 boundary_facet_markers;
+    py::object tetgen_switches;
+    tetwrap::PlcInput plc;
+};
+
+// Point a FacetList at borrowed index (and optional offset) buffers
+static tetwrap::FacetList facet_list(const py::array& indices, const ArrayI64& offsets, int count)
+{
+    tetwrap::FacetList fl;
+    if (py::isinstance<py::array_t<std::int64_t>>(indices))
+        fl.indices_i64 = static_cast<const std::int64_t*>(indices.data());
+    else
+        fl.indices = static_cast<const std::int32_t*>(indices.data());
+    fl.offsets = offsets.size() > 0 ? offsets.data() : nullptr;  // default array_t is empty
+    fl.num_indices = static_cast<std::int64_t>(indices.size());
+    fl.count = count;
+    return fl;
+}
+
+// Borrow a CSR pair; returns the number of polygons
+static int bind_csr(py::array& indices, ArrayI64& offsets,
+                    const py::object& indices_obj, const py::object& offsets_obj, const std::string& name)
+{
+    indices = borrow_indices(indices_obj);
+    offsets = offsets_obj.cast<ArrayI64>();
+    if (indices.ndim() != 1)
+        throw std::runtime_error(name + " must be a 1D index array when offsets are given");
+    if (offsets.ndim() != 1 || offsets.shape(0) < 1)
+        throw std::runtime_error(name + " offsets must be a non-empty 1D array");
+    return static_cast<int>(offsets.shape(0) - 1);
+}
+
+// Flatten a list of vertex index lists into CSR arrays owned by `a`
+static int flatten_polygons(PlcArgs& a, const py::object& polygons)
+{
+    const auto loops = polygons.cast<std::vector<std::vector<int>>>();
+    std::size_t total = 0;
+    for (const auto& loop : loops) total += loop.size();
+
+    ArrayI32 indices(static_cast<ssize_t>(total));
+    ArrayI64 offsets(static_cast<ssize_t>(loops.size() + 1));
+    int* idx = indices.mutable_data();
+    std::int64_t* off = offsets.mutable_data();
+    std::size_t k = 0;
+    off[0] = 0;
+    for (std::size_t bi = 0; bi < loops.size(); ++bi) {
+        for (int vid : loops[bi]) idx[k++] = vid;
+        off[bi + 1] = static_cast<std::int64_t>(k);
+    }
+    a.boundary_facets = indices;
+    a.boundary_facet_offsets = offsets;
+    return static_cast<int>(loops.size());
+}
+
+// Shape-check the held arrays and point `a.plc` at their buffers.
+static void bind_plc(PlcArgs& a, const PlcObjects& o, bool compute_boundary_faces)
+{
+    // Basic shape checks
+    a.vertices = borrow_coords(o.vertices);
+    if (a.vertices.ndim() != 2 || a.vertices.shape(1) != 3)
+        throw std::runtime_error("vertices must have shape (N,3)");
+
+    int M = 0;
+    if (o.mesh_facet_offsets.is_none()) {
+        a.mesh_facets = borrow_indices(o.mesh_facets);
+        if (a.mesh_facets.ndim() != 2 || a.mesh_facets.shape(1) != 3)
+            throw std::runtime_error("mesh_facets must have shape (M,3)");
+        M = static_cast<int>(a.mesh_facets.shape(0));
+    } else {
+        M = bind_csr(a.mesh_facets, a.mesh_facet_offsets, o.mesh_facets, o.mesh_facet_offsets, "mesh_facets");
+    }
+    if (!o.mesh_facet_markers.is_none())
+        a.mesh_facet_markers = marker_array(o.mesh_facet_markers, M, "mesh_facet_markers", "mesh facets");
+
+    int B = 0;
+    if (o.boundary_facet_offsets.is_none())
+        B = flatten_polygons(a, o.boundary_facets);
+    else
+        B = bind_csr(a.boundary_facets, a.boundary_facet_offsets, o.boundary_facets, o.boundary_facet_offsets, "boundary_facets");
+    if (!o.boundary_facet_markers.is_none())
+        a.boundary_facet_markers = marker_array(o.boundary_facet_markers, B, "boundary_facet_markers", "boundary facets");
+
+    if (py::isinstance<py::array_t<float>>(a.vertices))
+        a.plc.vertices_f32 = static_cast<const float*>(a.vertices.data());
+    else
+        a.plc.vertices = static_cast<const double*>(a.vertices.data());
+    a.plc.num_vertices = static_cast<int>(a.vertices.shape(0));
+    a.plc.mesh_facets = facet_list(a.mesh_facets, a.mesh_facet_offsets, M);
+    a.plc.mesh_facet_markers = o.mesh_facet_markers.is_none() ? nullptr : a.mesh_facet_markers.data();
+    a.plc.boundary_facets = facet_list(a.boundary_facets, a.boundary_facet_offsets, B);
+    a.plc.boundary_facet_markers = o.boundary_facet_markers.is_none() ? nullptr : a.boundary_facet_markers.data();
+    a.tetgen_switches = o.tetgen_switches;
+    a.plc.switches = switch_buffer(a.tetgen_switches);
+    a.plc.compute_boundary_faces = compute_boundary_faces;
+}
+
+// Sizing kernels given as a list of dicts with a "kind" ("height", "distance",
+// "box", "sphere" or "grid") and its parameters. The arrays stay alive here:
+// "distance" surfaces until the field, which copies them, is built, "grid"
+// values (float32/float64, read in place) for the whole run.
+struct SizingArgs {
+    std::vector<tetwrap::SizingKernel> kernels;
+    std::vector<py::array> keep;
+    std::unique_ptr<tetwrap::SizingField> field;
+
+    // Validate the kernels and build the field; runs without the GIL
+    const tetwrap::SizingField* build()
+    {
+        if (!kernels.empty() && !field) field.reset(new tetwrap::SizingField(std::move(kernels)));
+        return field.get();
+    }
+};
+
+static double sizing_value(const py::dict& d, const char* key, double fallback)
+{
+    return d.contains(key) && !d[key].is_none() ? d[key].cast<double>() : fallback;
+}
+
+static void sizing_point(const py::dict& d, const char* key, double* out)
+{
+    if (!d.contains(key)) throw std::runtime_error(std::string("sizing: missing ") + key);
+    const std::vector<double> v = d[key].cast<std::vector<double>>();
+    if (v.size() != 3) throw std::runtime_error(std::string("sizing: ") + key + " must have 3 coordinates");
+    std::copy(v.begin(), v.end(), out);
+}
+
+static void bind_sizing(SizingArgs& a, const py::object& sizing)
+{
+    if (sizing.is_none()) return;
+    for (py::handle item : sizing) {
+        const py::dict d = item.cast<py::dict>();
+        const std::string kind = d.contains("kind") ? d["kind"].cast<std::string>() : "";
+        tetwrap::SizingKernel k;
+        k.size = sizing_value(d, "size", 0.0);
+        if (kind == "height" || kind == "distance") {
+            k.kind = kind == "height" ? tetwrap::SizingKernel::kHeight : tetwrap::SizingKernel::kDistance;
+            k.growth = sizing_value(d, "growth", 0.0);
+            k.max_size = sizing_value(d, "max_size", k.max_size);
+            k.ground_z = sizing_value(d, "ground_z", 0.0);
+        } else if (kind == "box") {
+            k.kind = tetwrap::SizingKernel::kBox;
+            sizing_point(d, "lo", k.lo);
+            sizing_point(d, "hi", k.hi);
+        } else if (kind == "sphere") {
+            k.kind = tetwrap::SizingKernel::kSphere;
+            sizing_point(d, "center", k.center);
+            k.radius = sizing_value(d, "radius", 0.0);
+        } else if (kind == "grid") {
+            k.kind = tetwrap::SizingKernel::kGrid;
+            sizing_point(d, "origin", k.grid_origin);
+            sizing_point(d, "spacing", k.grid_spacing);
+            if (!d.contains("values")) throw std::runtime_error("sizing: grid kernels need values");
+            py::array values = borrow_coords(d["values"]);
+            if (values.ndim() != 3) throw std::runtime_error("sizing: grid values must have shape (nx,ny,nz)");
+            for (int a = 0; a < 3; ++a) k.grid_shape[a] = static_cast<std::int64_t>(values.shape(a));
+            if (py::isinstance<py::array_t<float>>(values))
+                k.grid_values_f32 = static_cast<const float*>(values.data());
+            else
+                k.grid_values = static_cast<const double*>(values.data());
+            a.keep.push_back(values);
+        } else {
+            throw std::runtime_error("sizing: unknown kind '" + kind + "'");
+        }
+        if (k.kind == tetwrap::SizingKernel::kDistance) {
+            if (!d.contains("points") || !d.contains("triangles"))
+                throw std::runtime_error("sizing: distance kernels need points and triangles");
+            ArrayF64 points = d["points"].cast<ArrayF64>();
+            ArrayI32 triangles = d["triangles"].cast<ArrayI32>();
+            if (points.ndim() != 2 || points.shape(1) != 3) throw std::runtime_error("sizing: points must have shape (P,3)");
+            if (triangles.ndim() != 2 || triangles.shape(1) != 3)
+                throw std::runtime_error("sizing: triangles must have shape (S,3)");
+            k.surface_points = points.data();
+            k.num_surface_points = static_cast<int>(points.shape(0));
+            k.surface_triangles = triangles.data();
+            k.num_surface_triangles = static_cast<int>(triangles.shape(0));
+            a.keep.push_back(points);
+            a.keep.push_back(triangles);
+        }
+        a.kernels.push_back(k);
+    }
+}
+
+// Phase times (plus their total) under "time", TetGen counters at top level
+static py::dict stats_dict(const tetwrap::RunStats& stats)
+{
+    py::dict time;
+    double total = 0.0;
+    for (const auto& phase : stats.seconds) {
+        time[phase.first] = phase.second;
+        total += phase.second;
+    }
+    time["total"] = total;
+
+    py::dict d;
+    d["time"] = time;
+    for (const auto& counter : stats.counters) d[counter.first] = counter.second;
+    return d;
+}
+
+static TetwrapIO finish_io(tetwrap::MeshResult& mesh, const py::object& tetgen_switches)
+{
+    tetwrap::PhaseClock clock(mesh.stats);
+    TetwrapIO res = to_tetwrap_io(mesh);
+    clock.lap("to_numpy");
+    res.stats = stats_dict(mesh.stats);
+    // reconstruct switch string if provided as array
+    if (py::isinstance<py::str>(tetgen_switches)) res.switches = py::cast<std::string>(tetgen_switches);
+    else res.switches = ""; // optional
     return res;
 }
 
+// ===================== Progress / cancellation =====================
+// Flag shared between Python and a running mesher; cancel() may be called
+// from any thread.
+struct CancelToken {
+    std::shared_ptr<std::atomic<bool>> flag = std::make_shared<std::atomic<bool>>(false);
+};
+
+// Python side of a RunControl. The callback runs with the GIL re-acquired;
+// a Python exception it raises aborts the run and is re-raised unchanged
+// once TetGen has unwound. Batch workers call in one at a time: the GIL
+// alone does not serialize them on a free-threaded build.
+struct PyRunControl {
+    tetwrap::RunControl control;
+    py::object callback;
+    std::shared_ptr<std::atomic<bool>> cancel;
+    std::mutex mutex;           // guards callback calls and error
+    std::exception_ptr error;   // the first callback error only
+
+    // Re-raise a callback error, if any (GIL held, workers finished)
+    void rethrow()
+    {
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            e = std::exchange(error, nullptr);
+        }
+        if (e) std::rethrow_exception(e);
+    }
+};
+
+static std::unique_ptr<PyRunControl> make_control(py::object progress, py::object cancel, double interval,
+                                                  double time_budget_s, long long memory_budget_bytes)
+{
+    if (progress.is_none() && cancel.is_none() && time_budget_s <= 0.0 && memory_budget_bytes <= 0)
+        return nullptr;
+    std::unique_ptr<PyRunControl> pc(new PyRunControl());
+    pc->control.time_budget_s = time_budget_s;
+    pc->control.memory_budget_bytes = memory_budget_bytes;
+    if (!cancel.is_none()) {
+        pc->cancel = py::cast<const CancelToken&>(cancel).flag;
+        pc->control.cancel = pc->cancel.get();
+    }
+    pc->control.progress_interval_s = interval;
+    if (!progress.is_none()) {
+        if (!PyCallable_Check(progress.ptr())) throw std::runtime_error("progress must be callable");
+        pc->callback = progress;
+        PyRunControl* self = pc.get();
+        pc->control.progress = [self](const tetwrap::Progress& p) {
+            // Mutex before GIL: a caller waiting on the mutex must not hold the GIL
+            std::lock_guard<std::mutex> lock(self->mutex);
+            py::gil_scoped_acquire gil;
+            // A batch stops reporting (and meshing) after the first error
+            if (self->error) throw tetwrap::RunAborted(tetwrap::kAbortCancelled, "progress callback raised");
+            try {
+                py::dict d;
+                d["phase"] = p.phase;
+                d["tets"] = p.tets;
+                d["points"] = p.points;
+                d["elapsed"] = p.elapsed_s;
+                d["item"] = p.item;
+                self->callback(d);
+            } catch (py::error_already_set&) {
+                if (!self->error) self->error = std::current_exception();
+                throw tetwrap::RunAborted(tetwrap::kAbortCancelled, "progress callback raised");
+            }
+        };
+    }
+    return pc;
+}
+
+// dump_dir: None for the default location, False for no repro bundle, or a directory
+static void set_dump_dir(tetwrap::RunOptions& options, const py::object& dump_dir)
+{
+    if (dump_dir.is_none()) return;
+    if (py::isinstance<py::bool_>(dump_dir)) options.dump_on_failure = dump_dir.cast<bool>();
+    else options.dump_dir = py::str(dump_dir);
+}
+
+// Core routine: run TetGen and produce rich IO
+static TetwrapIO tetrahedralize_core(
+    py::object vertices,
+    py::object mesh_facets,
+    py::object mesh_facet_markers_obj,
+    py::object boundary_facets,
+    py::object tetgen_switches,
+    bool compute_boundary_faces = true,
+    py::object mesh_facet_offsets = py::none(),
+    py::object boundary_facet_offsets = py::none(),
+    py::object boundary_facet_markers = py::none(),
+    py::object progress = py::none(),
+    py::object cancel = py::none(),
+    double progress_interval = 0.5,
+    double time_budget_s = 0.0,
+    long long memory_budget_bytes = 0,
+    py::object output_dir = py::none(),
+    py::object dump_dir = py::none(),
+    py::object sizing = py::none())
+{
+    PlcObjects o;
+    o.vertices = vertices;
+    o.mesh_facets = mesh_facets;
+    o.mesh_facet_offsets = mesh_facet_offsets;
+    o.mesh_facet_markers = mesh_facet_markers_obj;
+    o.boundary_facets = boundary_facets;
+    o.boundary_facet_offsets = boundary_facet_offsets;
+    o.boundary_facet_markers = boundary_facet_markers;
+    o.tetgen_switches = tetgen_switches;
+
+    PlcArgs args;
+    bind_plc(args, o, compute_boundary_faces);
+    std::unique_ptr<PyRunControl> control =
+        make_control(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes);
+    tetwrap::RunOptions options;
+    options.control = control ? &control->control : nullptr;
+    if (!output_dir.is_none()) options.output_dir = py::str(output_dir);
+    set_dump_dir(options, dump_dir);
+    SizingArgs field;
+    bind_sizing(field, sizing);
 
+    // Validation, packing, TetGen and boundary post-processing are pure C++
+    tetwrap::MeshResult mesh;
+    try {
+        py::gil_scoped_release release;
+        args.plc.sizing = field.build();
+        mesh = tetwrap::run_tetgen(args.plc, options);
+    } catch (const tetwrap::RunAborted&) {
+        if (control) control->rethrow();
+        throw;
+    }
+    return finish_io(mesh, tetgen_switches);
+}
+
+// Look up a PLC field by key (dict) or by position (tuple/list)
+static py::object plc_field(const py::handle& item, const char* key, std::size_t pos, bool required)
+{
+    if (py::isinstance<py::dict>(item)) {
+        py::dict d = py::reinterpret_borrow<py::dict>(item);
+        if (d.contains(key)) return d[key];
+    } else {
+        py::sequence seq = py::reinterpret_borrow<py::sequence>(item);
+        if (pos < seq.size()) return seq[pos];
+    }
+    if (required)
+        throw std::runtime_error(std::string("PLC entry is missing '") + key + "'");
+    return py::none();
+}
+
+// Batch routine: mesh many PLCs on a native thread pool
+static std::vector<TetwrapIO> tetrahedralize_batch(
+    py::sequence plcs,
+    bool compute_boundary_faces = true,
+    int num_threads = 0,
+    py::object progress = py::none(),
+    py::object cancel = py::none(),
+    double progress_interval = 0.5,
+    double time_budget_s = 0.0,
+    long long memory_budget_bytes = 0,
+    py::object dump_dir = py::none())
+{
+    // Convert every PLC while holding the GIL; workers only see raw buffers
+    std::vector<std::unique_ptr<PlcArgs>> args;
+    std::vector<const tetwrap::PlcInput*> inputs;
+    args.reserve(plcs.size());
+    inputs.reserve(plcs.size());
+    for (std::size_t i = 0; i < plcs.size(); ++i) {
+        py::object item = plcs[i];
+        if (!py::isinstance<py::dict>(item) && !py::isinstance<py::sequence>(item))
+            throw std::runtime_error("PLC " + std::to_string(i) + " must be a tuple or dict");
+        try {
+            PlcObjects o;
+            o.vertices = plc_field(item, "vertices", 0, true);
+            o.mesh_facets = plc_field(item, "mesh_facets", 1, true);
+            o.mesh_facet_markers = plc_field(item, "mesh_facet_markers", 2, false);
+            o.boundary_facets = plc_field(item, "boundary_facets", 3, true);
+            o.tetgen_switches = plc_field(item, "tetgen_switches", 4, true);
+            o.mesh_facet_offsets = plc_field(item, "mesh_facet_offsets", 5, false);
+            o.boundary_facet_offsets = plc_field(item, "boundary_facet_offsets", 6, false);
+            o.boundary_facet_markers = plc_field(item, "boundary_facet_markers", 7, false);
+            std::unique_ptr<PlcArgs> a(new PlcArgs());
+            bind_plc(*a, o, compute_boundary_faces);
+            inputs.push_back(&a->plc);
+            args.push_back(std::move(a));
+        } catch (const std::exception& e) {
+            throw std::runtime_error("PLC " + std::to_string(i) + ": " + e.what());
+        }
+    }
+
+    std::unique_ptr<PyRunControl> control =
+        make_control(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes);
+    tetwrap::RunOptions options;
+    options.control = control ? &control->control : nullptr;
+    set_dump_dir(options, dump_dir);
+    std::vector<tetwrap::BatchItem> items;
+    {
+        py::gil_scoped_release release;
+        items = tetwrap::run_tetgen_batch(inputs, num_threads, options);
+    }
+    if (control) control->rethrow();
+
+    std::vector<TetwrapIO> results;
+    results.reserve(items.size());
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        if (items[i].error) {
+            try {
+                std::rethrow_exception(items[i].error);
+            } catch (const tetwrap::RunAborted& e) {
+                throw tetwrap::RunAborted(e.code, "PLC " + std::to_string(i) + ": " + e.what());
+            } catch (const std::exception& e) {
+                throw std::runtime_error("PLC " + std::to_string(i) + ": " + e.what());
+            }
+        }
+        results.push_back(finish_io(items[i].mesh, args[i]->tetgen_switches));
+    }
+    return results;
+}
+
+
+// Tiled routine: split one PLC into XY tiles and mesh them concurrently
+static TetwrapIO tetrahedralize_tiled(
+    py::object vertices,
+    py::object mesh_facets,
+    py::object mesh_facet_markers_obj,
+    py::object boundary_facets,
+    py::object tetgen_switches,
+    bool compute_boundary_faces = true,
+    py::object mesh_facet_offsets = py::none(),
+    py::object boundary_facet_offsets = py::none(),
+    py::object boundary_facet_markers = py::none(),
+    int tiles_x = 2,
+    int tiles_y = 2,
+    double spacing = 0.0,
+    int num_threads = 0,
+    py::object progress = py::none(),
+    py::object cancel = py::none(),
+    double progress_interval = 0.5,
+    double time_budget_s = 0.0,
+    long long memory_budget_bytes = 0,
+    py::object dump_dir = py::none(),
+    py::object sizing = py::none())
+{
+    PlcObjects o;
+    o.vertices = vertices;
+    o.mesh_facets = mesh_facets;
+    o.mesh_facet_offsets = mesh_facet_offsets;
+    o.mesh_facet_markers = mesh_facet_markers_obj;
+    o.boundary_facets = boundary_facets;
+    o.boundary_facet_offsets = boundary_facet_offsets;
+    o.boundary_facet_markers = boundary_facet_markers;
+    o.tetgen_switches = tetgen_switches;
+
+    PlcArgs args;
+    bind_plc(args, o, compute_boundary_faces);
+    std::unique_ptr<PyRunControl> control =
+        make_control(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes);
+    tetwrap::RunOptions options;
+    options.control = control ? &control->control : nullptr;
+    set_dump_dir(options, dump_dir);
+    tetwrap::TileOptions tiles;
+    tiles.tiles_x = tiles_x;
+    tiles.tiles_y = tiles_y;
+    tiles.spacing = spacing;
+    tiles.num_threads = num_threads;
+    SizingArgs field;
+    bind_sizing(field, sizing);
+
+    tetwrap::MeshResult mesh;
+    try {
+        py::gil_scoped_release release;
+        args.plc.sizing = field.build();
+        mesh = tetwrap::run_tetgen_tiled(args.plc, tiles, options);
+    } catch (const tetwrap::RunAborted&) {
+        if (control) control->rethrow();
+        throw;
+    }
+    return finish_io(mesh, tetgen_switches);
+}
+
+// Remesh a box of an existing mesh; returns (TetwrapIO, point_map, tet_map)
+static py::tuple remesh_region(
+    ArrayF64 points,
+    ArrayI32 tets,
+    py::object neighbors_obj,
+    ArrayI32 boundary_faces,
+    ArrayI32 boundary_tets,
+    ArrayI32 boundary_local_faces,
+    py::object boundary_markers_obj,
+    std::array<double, 3> box_min,
+    std::array<double, 3> box_max,
+    py::object vertices,
+    py::object mesh_facets,
+    py::object mesh_facet_markers_obj,
+    py::object boundary_facets,
+    py::object tetgen_switches,
+    bool compute_boundary_faces = true,
+    py::object mesh_facet_offsets = py::none(),
+    py::object boundary_facet_offsets = py::none(),
+    py::object boundary_facet_markers = py::none(),
+    py::object progress = py::none(),
+    py::object cancel = py::none(),
+    double progress_interval = 0.5,
+    double time_budget_s = 0.0,
+    long long memory_budget_bytes = 0,
+    py::object dump_dir = py::none(),
+    py::object sizing = py::none())
+{
+    if (points.ndim() != 2 || points.shape(1) != 3) throw std::runtime_error("points must have shape (N,3)");
+    if (tets.ndim() != 2 || tets.shape(1) != 4) throw std::runtime_error("tets must have shape (K,4) (linear tets)");
+    if (boundary_faces.ndim() != 2 || boundary_faces.shape(1) != 3)
+        throw std::runtime_error("boundary_faces must have shape (BF,3)");
+    const ssize_t BF = boundary_faces.shape(0);
+    if (boundary_tets.ndim() != 1 || boundary_tets.shape(0) != BF ||
+        boundary_local_faces.ndim() != 1 || boundary_local_faces.shape(0) != BF)
+        throw std::runtime_error("boundary_tets and boundary_local_faces must have shape (BF,)");
+    ArrayI32 neighbors, boundary_markers;
+    if (!neighbors_obj.is_none()) {
+        neighbors = neighbors_obj.cast<ArrayI32>();
+        if (neighbors.ndim() != 2 || neighbors.shape(0) != tets.shape(0) || neighbors.shape(1) != 4)
+            throw std::runtime_error("neighbors must have the shape of tets");
+    }
+    if (!boundary_markers_obj.is_none())
+        boundary_markers = marker_array(boundary_markers_obj, static_cast<int>(BF), "boundary_markers", "boundary faces");
+
+    tetwrap::TetMesh mesh;
+    mesh.points = points.data();
+    mesh.num_points = static_cast<int>(points.shape(0));
+    mesh.tets = tets.data();
+    mesh.num_tets = static_cast<int>(tets.shape(0));
+    mesh.neighbors = neighbors_obj.is_none() ? nullptr : neighbors.data();
+    mesh.boundary_faces = boundary_faces.data();
+    mesh.boundary_tets = boundary_tets.data();
+    mesh.boundary_local_faces = boundary_local_faces.data();
+    mesh.boundary_markers = boundary_markers_obj.is_none() ? nullptr : boundary_markers.data();
+    mesh.num_boundary_faces = static_cast<int>(BF);
+
+    PlcObjects o;
+    o.vertices = vertices;
+    o.mesh_facets = mesh_facets;
+    o.mesh_facet_offsets = mesh_facet_offsets;
+    o.mesh_facet_markers = mesh_facet_markers_obj;
+    o.boundary_facets = boundary_facets;
+    o.boundary_facet_offsets = boundary_facet_offsets;
+    o.boundary_facet_markers = boundary_facet_markers;
+    o.tetgen_switches = tetgen_switches;
+
+    PlcArgs args;
+    bind_plc(args, o, compute_boundary_faces);
+    std::unique_ptr<PyRunControl> control =
+        make_control(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes);
+    tetwrap::RunOptions options;
+    options.control = control ? &control->control : nullptr;
+    set_dump_dir(options, dump_dir);
+    SizingArgs field;
+    bind_sizing(field, sizing);
+
+    tetwrap::RemeshResult result;
+    try {
+        py::gil_scoped_release release;
+        args.plc.sizing = field.build();
+        result = tetwrap::run_tetgen_remesh(mesh, box_min.data(), box_max.data(), args.plc, options);
+    } catch (const tetwrap::RunAborted&) {
+        if (control) control->rethrow();
+        throw;
+    }
+    const ssize_t N = static_cast<ssize_t>(result.point_map.size());
+    const ssize_t K = static_cast<ssize_t>(result.tet_map.size());
+    TetwrapIO io = finish_io(result.mesh, tetgen_switches);
+    return py::make_tuple(io, take_vector(std::move(result.point_map), {N}), take_vector(std::move(result.tet_map), {K}));
+}
+
+// Refine an existing mesh with -r; the arrays are read in place
+static TetwrapIO refine_mesh(
+    ArrayF64 points,
+    ArrayI32 tets,
+    py::object faces_obj,
+    py::object face_markers_obj,
+    py::object tet_volumes_obj,
+    py::object tet_attr_obj,
+    py::object tetgen_switches,
+    bool compute_boundary_faces = true,
+    py::object progress = py::none(),
+    py::object cancel = py::none(),
+    double progress_interval = 0.5,
+    double time_budget_s = 0.0,
+    long long memory_budget_bytes = 0,
+    py::object sizing = py::none())
+{
+    if (points.ndim() != 2 || points.shape(1) != 3) throw std::runtime_error("points must have shape (N,3)");
+    if (tets.ndim() != 2 || (tets.shape(1) != 4 && tets.shape(1) != 10))
+        throw std::runtime_error("tets must have shape (K,4) or (K,10)");
+    const ssize_t K = tets.shape(0);
+    ArrayI32 faces, face_markers;
+    ArrayF64 tet_volumes, tet_attr;
+    if (!faces_obj.is_none()) {
+        faces = faces_obj.cast<ArrayI32>();
+        if (faces.ndim() != 2 || faces.shape(1) != 3) throw std::runtime_error("faces must have shape (F,3)");
+        if (!face_markers_obj.is_none())
+            face_markers = marker_array(face_markers_obj, static_cast<int>(faces.shape(0)), "face_markers", "faces");
+    }
+    if (!tet_volumes_obj.is_none()) {
+        tet_volumes = tet_volumes_obj.cast<ArrayF64>();
+        if (tet_volumes.ndim() != 1 || tet_volumes.shape(0) != K)
+            throw std::runtime_error("tet_volumes must have shape (K,)");
+    }
+    if (!tet_attr_obj.is_none()) {
+        tet_attr = tet_attr_obj.cast<ArrayF64>();
+        if (tet_attr.ndim() != 2 || tet_attr.shape(0) != K)
+            throw std::runtime_error("tet_attr must have shape (K,A)");
+    }
+
+    tetwrap::RefineInput mesh;
+    mesh.points = points.data();
+    mesh.num_points = static_cast<int>(points.shape(0));
+    mesh.tets = tets.data();
+    mesh.num_tets = static_cast<int>(K);
+    mesh.corners = static_cast<int>(tets.shape(1));
+    if (!faces_obj.is_none()) {
+        mesh.faces = faces.data();
+        mesh.face_markers = face_markers_obj.is_none() ? nullptr : face_markers.data();
+        mesh.num_faces = static_cast<int>(faces.shape(0));
+    }
+    mesh.tet_volumes = tet_volumes_obj.is_none() ? nullptr : tet_volumes.data();
+    if (!tet_attr_obj.is_none()) {
+        mesh.tet_attributes = tet_attr.data();
+        mesh.num_tet_attributes = static_cast<int>(tet_attr.shape(1));
+    }
+    mesh.switches = switch_buffer(tetgen_switches);
+    mesh.compute_boundary_faces = compute_boundary_faces;
+
+    std::unique_ptr<PyRunControl> control =
+        make_control(progress, cancel, progress_interval, time_budget_s, memory_budget_bytes);
+    tetwrap::RunOptions options;
+    options.control = control ? &control->control : nullptr;
+    SizingArgs field;
+    bind_sizing(field, sizing);
+
+    tetwrap::MeshResult result;
+    try {
+        py::gil_scoped_release release;
+        mesh.sizing = field.build();
+        result = tetwrap::run_tetgen_refine(mesh, options);
+    } catch (const tetwrap::RunAborted&) {
+        if (control) control->rethrow();
+        throw;
+    }
+    return finish_io(result, tetgen_switches);
+}
+
+// Shared by _write_vtu / _write_xdmf: check shapes, then write without the GIL
+static void write_mesh_file(bool xdmf, const std::string& path, ArrayF64 points, ArrayI32 tets,
+                            py::object faces, py::object face_markers, bool compress, int num_threads)
+{
+    if (points.ndim() != 2 || points.shape(1) != 3) throw std::runtime_error("points must have shape (N, 3)");
+    if (tets.ndim() != 2 || tets.shape(1) != 4) throw std::runtime_error("tets must have shape (K, 4) (linear tets)");
+    tetwrap::MeshView view;
+    view.points = points.data();
+    view.num_points = points.shape(0);
+    view.tets = tets.data();
+    view.num_tets = tets.shape(0);
+
+    ArrayI32 face_buf, marker_buf;
+    if (!faces.is_none()) {
+        face_buf = faces.cast<ArrayI32>();
+        if (face_buf.ndim() != 2 || face_buf.shape(1) != 3) throw std::runtime_error("faces must have shape (F, 3)");
+        view.faces = face_buf.data();
+        view.num_faces = face_buf.shape(0);
+        if (!face_markers.is_none()) {
+            marker_buf = marker_array(face_markers, static_cast<int>(view.num_faces), "face_markers", "faces");
+            view.face_markers = marker_buf.data();
+        }
+    }
+
+    tetwrap::WriteOptions options;
+    options.compress = compress;
+    options.num_threads = num_threads;
+    py::gil_scoped_release release;
+    if (xdmf) tetwrap::write_xdmf(path, view, options);
+    else tetwrap::write_vtu(path, view, options);
+}
+
+
+// ===================== TetGen files =====================
+static py::object optional_f64(std::vector<double>&& v, ssize_t rows, ssize_t cols)
+{
+    if (cols <= 0) return py::none();
+    return take_vector(std::move(v), {rows, cols});
+}
+
+static py::object optional_i32(std::vector<int>&& v, ssize_t rows)
+{
+    if (v.empty() && rows > 0) return py::none();
+    return take_vector(std::move(v), {rows});
+}
+
+static py::dict read_node_file(const std::string& path, int num_threads)
+{
+    tetwrap::TetgenNodes nodes;
+    {
+        py::gil_scoped_release release;
+        nodes = tetwrap::read_tetgen_node(path, num_threads);
+    }
+    const ssize_t n = static_cast<ssize_t>(nodes.count);
+    py::dict d;
+    d["points"] = take_vector(std::move(nodes.points), {n, 3});
+    d["attributes"] = optional_f64(std::move(nodes.attributes), n, nodes.num_attributes);
+    d["markers"] = optional_i32(std::move(nodes.markers), n);
+    d["first_index"] = nodes.first_index;
+    return d;
+}
+
+static py::dict read_ele_file(const std::string& path, int first_index, int num_threads)
+{
+    tetwrap::TetgenElements ele;
+    {
+        py::gil_scoped_release release;
+        ele = tetwrap::read_tetgen_ele(path, first_index, num_threads);
+    }
+    const ssize_t n = static_cast<ssize_t>(ele.count);
+    py::dict d;
+    d["tets"] = take_vector(std::move(ele.tets), {n, static_cast<ssize_t>(ele.corners)});
+    d["attributes"] = optional_f64(std::move(ele.attributes), n, ele.num_attributes);
+    return d;
+}
+
+static py::dict read_face_file(const std::string& path, int first_index, int num_threads)
+{
+    tetwrap::TetgenFaces faces;
+    {
+        py::gil_scoped_release release;
+        faces = tetwrap::read_tetgen_face(path, first_index, num_threads);
+    }
+    const ssize_t n = static_cast<ssize_t>(faces.count);
+    py::dict d;
+    d["faces"] = take_vector(std::move(faces.faces), {n, 3});
+    d["markers"] = optional_i32(std::move(faces.markers), n);
+    return d;
+}
+
+static py::array_t<int> read_neigh_file(const std::string& path, int first_index, int num_threads)
+{
+    std::vector<int> neighbors;
+    {
+        py::gil_scoped_release release;
+        neighbors = tetwrap::read_tetgen_neigh(path, first_index, num_threads);
+    }
+    const ssize_t n = static_cast<ssize_t>(neighbors.size() / 4);
+    return take_vector(std::move(neighbors), {n, 4});
+}
+
+static py::dict read_smesh_file(const std::string& path, int first_index)
+{
+    tetwrap::TetgenSmesh smesh;
+    {
+        py::gil_scoped_release release;
+        smesh = tetwrap::read_tetgen_smesh(path, first_index);
+    }
+    const ssize_t n = static_cast<ssize_t>(smesh.nodes.count);
+    const ssize_t facets = static_cast<ssize_t>(smesh.facet_offsets.size()) - 1;
+    const ssize_t indices = static_cast<ssize_t>(smesh.facet_indices.size());
+    const ssize_t holes = static_cast<ssize_t>(smesh.holes.size() / 3);
+    const ssize_t regions = static_cast<ssize_t>(smesh.regions.size() / 5);
+    py::dict d;
+    d["points"] = n > 0 ? py::object(take_vector(std::move(smesh.nodes.points), {n, 3})) : py::none();
+    d["point_markers"] = n > 0 ? optional_i32(std::move(smesh.nodes.markers), n) : py::none();
+    d["first_index"] = n > 0 ? smesh.nodes.first_index : first_index;
+    d["facet_offsets"] = take_vector(std::move(smesh.facet_offsets), {facets + 1});
+    d["facet_indices"] = take_vector(std::move(smesh.facet_indices), {indices});
+    d["facet_markers"] = optional_i32(std::move(smesh.facet_markers), facets);
+    d["holes"] = take_vector(std::move(smesh.holes), {holes, 3});
+    d["regions"] = take_vector(std::move(smesh.regions), {regions, 5});
+    return d;
+}
+
+// Borrow an optional (rows, cols) / (rows,) array, checking its shape
+template <typename Array>
+static const typename Array::value_type* optional_rows(const py::object& obj, Array& keep, ssize_t rows,
+                                                       ssize_t cols, const char* name)
+{
+    if (obj.is_none()) return nullptr;
+    keep = obj.cast<Array>();
+    const bool ok = cols > 0 ? keep.ndim() == 2 && keep.shape(0) == rows && keep.shape(1) == cols
+                             : keep.ndim() == 1 && keep.shape(0) == rows;
+    if (!ok) throw std::runtime_error(std::string(name) + " has the wrong shape");
+    return keep.data();
+}
+
+static void write_node_file(const std::string& path, ArrayF64 points, py::object attributes, py::object markers,
+                            int first_index, int num_threads)
+{
+    if (points.ndim() != 2 || points.shape(1) != 3) throw std::runtime_error("points must have shape (N, 3)");
+    const ssize_t n = points.shape(0);
+    ArrayF64 attr_buf;
+    ArrayI32 marker_buf;
+    const int num_attributes = attributes.is_none() ? 0 : static_cast<int>(attributes.cast<ArrayF64>().shape(1));
+    const double* attr = optional_rows(attributes, attr_buf, n, num_attributes, "attributes");
+    const int* mark = optional_rows(markers, marker_buf, n, 0, "markers");
+    py::gil_scoped_release release;
+    tetwrap::write_tetgen_node(path, points.data(), n, attr, num_attributes, mark, first_index, num_threads);
+}
+
+static void write_ele_file(const std::string& path, ArrayI32 tets, py::object attributes, int first_index,
+                           int num_threads)
+{
+    if (tets.ndim() != 2 || (tets.shape(1) != 4 && tets.shape(1) != 10))
+        throw std::runtime_error("tets must have shape (K, 4) or (K, 10)");
+    const ssize_t n = tets.shape(0);
+    ArrayF64 attr_buf;
+    const int num_attributes = attributes.is_none() ? 0 : static_cast<int>(attributes.cast<ArrayF64>().shape(1));
+    const double* attr = optional_rows(attributes, attr_buf, n, num_attributes, "attributes");
+    py::gil_scoped_release release;
+    tetwrap::write_tetgen_ele(path, tets.data(), n, static_cast<int>(tets.shape(1)), attr, num_attributes,
+                              first_index, num_threads);
+}
+
+static void write_face_file(const std::string& path, ArrayI32 faces, py::object markers, int first_index,
+                            int num_threads)
+{
+    if (faces.ndim() != 2 || faces.shape(1) != 3) throw std::runtime_error("faces must have shape (F, 3)");
+    ArrayI32 marker_buf;
+    const int* mark = optional_rows(markers, marker_buf, faces.shape(0), 0, "markers");
+    py::gil_scoped_release release;
+    tetwrap::write_tetgen_face(path, faces.data(), faces.shape(0), mark, first_index, num_threads);
+}
+
+static void write_neigh_file(const std::string& path, ArrayI32 neighbors, int first_index, int num_threads)
+{
+    if (neighbors.ndim() != 2 || neighbors.shape(1) != 4)
+        throw std::runtime_error("neighbors must have shape (K, 4)");
+    py::gil_scoped_release release;
+    tetwrap::write_tetgen_neigh(path, neighbors.data(), neighbors.shape(0), first_index, num_threads);
+}
+
+static void write_smesh_file(const std::string& path, ArrayI64 facet_offsets, ArrayI32 facet_indices,
+                             py::object facet_markers, py::object holes, int first_index)
+{
+    if (facet_offsets.ndim() != 1 || facet_offsets.shape(0) < 1 || facet_indices.ndim() != 1)
+        throw std::runtime_error("facets must be CSR offsets (M+1,) and indices");
+    const ssize_t facets = facet_offsets.shape(0) - 1;
+    const std::int64_t* off = facet_offsets.data();
+    for (ssize_t i = 0; i < facets; ++i)
+        if (off[i] > off[i + 1]) throw std::runtime_error("facet offsets must be non-decreasing");
+    if (off[0] != 0 || off[facets] != facet_indices.shape(0))
+        throw std::runtime_error("facet offsets must span the index array");
+    ArrayI32 marker_buf;
+    ArrayF64 hole_buf;
+    const int* mark = optional_rows(facet_markers, marker_buf, facets, 0, "facet_markers");
+    const ssize_t num_holes = holes.is_none() ? 0 : holes.cast<ArrayF64>().shape(0);
+    const double* hole = optional_rows(holes, hole_buf, num_holes, 3, "holes");
+    py::gil_scoped_release release;
+    tetwrap::write_tetgen_smesh(path, off, facet_indices.data(), facets, mark, hole, num_holes, first_index);
+}
+
+
+// ===================== Repro bundles =====================
+// Keyword arguments of _tetrahedralize for the bundled PLC, plus the
+// bundle's error_code and tetgen_version
+static py::dict load_plc_bundle(const std::string& path)
+{
+    tetwrap::PlcBundle b;
+    {
+        py::gil_scoped_release release;
+        b = tetwrap::read_plc_bundle(path);
+    }
+    auto optional_markers = [](std::vector<int>&& v) -> py::object {
+        if (v.empty()) return py::none();
+        const ssize_t n = static_cast<ssize_t>(v.size());
+        return take_vector(std::move(v), {n});
+    };
+
+    py::dict d;
+    const ssize_t n = static_cast<ssize_t>(b.vertices.size() / 3);
+    d["vertices"] = take_vector(std::move(b.vertices), {n, 3});
+    const ssize_t mesh_indices = static_cast<ssize_t>(b.mesh_indices.size());
+    if (b.mesh_offsets.empty()) {
+        d["mesh_facets"] = take_vector(std::move(b.mesh_indices), {mesh_indices / 3, 3});
+        d["mesh_facet_offsets"] = py::none();
+    } else {
+        const ssize_t offsets = static_cast<ssize_t>(b.mesh_offsets.size());
+        d["mesh_facets"] = take_vector(std::move(b.mesh_indices), {mesh_indices});
+        d["mesh_facet_offsets"] = take_vector(std::move(b.mesh_offsets), {offsets});
+    }
+    d["mesh_facet_markers"] = optional_markers(std::move(b.mesh_markers));
+    const ssize_t boundary_indices = static_cast<ssize_t>(b.boundary_indices.size());
+    const ssize_t boundary_offsets = static_cast<ssize_t>(b.boundary_offsets.size());
+    d["boundary_facets"] = take_vector(std::move(b.boundary_indices), {boundary_indices});
+    d["boundary_facet_offsets"] = take_vector(std::move(b.boundary_offsets), {boundary_offsets});
+    d["boundary_facet_markers"] = optional_markers(std::move(b.boundary_markers));
+    d["tetgen_switches"] = b.switches;
+    d["compute_boundary_faces"] = b.compute_boundary_faces;
+    d["error_code"] = b.error_code;
+    d["tetgen_version"] = b.tetgen_version;
+    return d;
+}
+
+
+// The module keeps no Python-visible global state and drops the GIL around
+// TetGen, so it is safe to load without re-enabling the GIL on free-threaded
+// (3.13t) interpreters.
+#if PYBIND11_VERSION_HEX >= 0x020D0000
+PYBIND11_MODULE(_tetwrap, m, py::mod_gil_not_used())
+#else
 PYBIND11_MODULE(_tetwrap, m)
+#endif
 {
+    // True when concurrent TetGen runs are isolated rather than serialized
+    m.attr("tetgen_threadsafe") = py::bool_(TETWRAP_TETGEN_THREADSAFE != 0);
+    // Version of the vendored TetGen sources, "unknown" when not found
+    m.attr("tetgen_version") = tetwrap::tetgen_version();
+
+    py::class_<CancelToken>(m, "CancelToken", "Cooperative cancellation flag for tetrahedralize().")
+        .def(py::init<>())
+        .def("cancel", [](CancelToken& t) { t.flag->store(true); },
+             "Ask every run holding this token to stop at its next check.")
+        .def_property_readonly("cancelled", [](const CancelToken& t) { return t.flag->load(); });
+
+    // RuntimeError subclass carrying the abort code (101: cancelled,
+    // 102: time budget, 103: memory budget)
+    static py::handle aborted_type = py::exception<tetwrap::RunAborted>(m, "MeshingAborted", PyExc_RuntimeError).release();
+    py::register_exception_translator([](std::exception_ptr p) {
+        try {
+            if (p) std::rethrow_exception(p);
+        } catch (const tetwrap::RunAborted& e) {
+            py::object err = py::reinterpret_borrow<py::object>(aborted_type)(e.what());
+            err.attr("code") = e.code;
+            PyErr_SetObject(aborted_type.ptr(), err.ptr());
+        }
+    });
+
     // Expose rich result class
     py::class_<TetwrapIO>(m, "TetwrapIO")
         .def_readonly("points", &TetwrapIO::points)
@@ -536,6 +1223,8 @@ PYBIND11_MODULE(_tetwrap, m)
         .def_readonly("tri_markers", &TetwrapIO::tri_markers)
         .def_readonly("boundary_tri_faces", &TetwrapIO::boundary_tri_faces)
         .def_readonly("boundary_tri_markers", &TetwrapIO::boundary_tri_markers)
+        .def_readonly("boundary_tri_tets", &TetwrapIO::boundary_tri_tets)
+        .def_readonly("boundary_tri_local_faces", &TetwrapIO::boundary_tri_local_faces)
         .def_readonly("edges", &TetwrapIO::edges)
         .def_readonly("edge_markers", &TetwrapIO::edge_markers)
         .def_readonly("neighbors", &TetwrapIO::neighbors)
@@ -543,7 +1232,8 @@ PYBIND11_MODULE(_tetwrap, m)
         .def_readonly("tet_attr", &TetwrapIO::tet_attr)
         .def_readonly("tet_vol", &TetwrapIO::tet_vol)
         .def_readonly("corners", &TetwrapIO::corners)
-        .def_readonly("switches", &TetwrapIO::switches);
+        .def_readonly("switches", &TetwrapIO::switches)
+        .def_readonly("stats", &TetwrapIO::stats);
 
     // Back-compat: return (points, tets)
     m.def("build_volume_mesh",
@@ -551,7 +1241,7 @@ PYBIND11_MODULE(_tetwrap, m)
              py::array_t<int,    py::array::c_style | py::array::forcecast> mesh_facets,
              const std::vector<std::vector<int>> &boundary_facets,
              py::object tetgen_switches) {
-                TetwrapIO io = tetrahedralize_core(vertices, mesh_facets, py::none(), boundary_facets, tetgen_switches);
+                TetwrapIO io = tetrahedralize_core(vertices, mesh_facets, py::none(), py::cast(boundary_facets), tetgen_switches);
                 return std::make_pair(io.points.cast<py::array_t<double>>(), io.tets.cast<py::array_t<int>>());
           },
           py::arg("vertices"),
@@ -571,8 +1261,230 @@ PYBIND11_MODULE(_tetwrap, m)
           py::arg("boundary_facets"),
           py::arg("tetgen_switches"),
           py::arg("compute_boundary_faces") = true,
+          py::arg("mesh_facet_offsets") = py::none(),
+          py::arg("boundary_facet_offsets") = py::none(),
+          py::arg("boundary_facet_markers") = py::none(),
+          py::arg("progress") = py::none(),
+          py::arg("cancel") = py::none(),
+          py::arg("progress_interval") = 0.5,
+          py::arg("time_budget_s") = 0.0,
+          py::arg("memory_budget_bytes") = 0,
+          py::arg("output_dir") = py::none(),
+          py::arg("dump_dir") = py::none(),
+          py::arg("sizing") = py::none(),
           R"pbdoc(
               Build a TetGen volume mesh and return a TetwrapIO object.
               Use TetGen switches to request faces (-f), edges (-e), neighbors (-n).
+              vertices may be float32/float64 and mesh_facets int32/int64; C-contiguous
+              arrays of those dtypes are read in place without conversion.
+              Facets may also be given in CSR form: with mesh_facet_offsets (M+1,),
+              mesh_facets is a flat index array and polygon i uses
+              mesh_facets[offsets[i]:offsets[i+1]]; likewise boundary_facets with
+              boundary_facet_offsets. boundary_facet_markers (>= 0) default to the
+              polygon index.
+              progress(dict) is called with keys phase, tets, points, elapsed and item at
+              the start of each phase and at most every progress_interval seconds; an
+              exception it raises aborts the run and propagates. A CancelToken passed as
+              cancel stops the run with MeshingAborted (code 101). time_budget_s and
+              memory_budget_bytes (> 0) bound TetGen's wall time and element pool memory;
+              exceeding them raises MeshingAborted with code 102 / 103.
+              With output_dir, points, point_markers, tets, neighbors, tet_attr and the
+              boundary_tri_* arrays are written straight into memory-mapped <name>.npy
+              files there and returned as views of those mappings (linear tets only).
+              When TetGen fails, the PLC and switches are saved as a repro bundle
+              (.tetplc) in dump_dir (default: $TETWRAP_DUMP_DIR or the temp directory;
+              False disables it) and its path is part of the error message.
+              sizing, a list of dicts, selects native target edge length kernels: {"kind":
+              "height", "size", "growth", "max_size", "ground_z"}, {"kind": "distance",
+              "points" (P,3), "triangles" (S,3), "size", "growth", "max_size"}, {"kind":
+              "box", "lo", "hi", "size"}, {"kind": "sphere", "center", "radius", "size"} and
+              {"kind": "grid", "origin", "spacing", "values" (nx,ny,nz) float32/float64 read
+              in place}, interpolated trilinearly between the grid nodes and clamped to them.
+              The field is their minimum; TetGen's refinement (-q is added) splits tets
+              whose longest edge exceeds it at their centroid. Repro bundles omit it.
+          )pbdoc");
+
+    m.def("_tetrahedralize_batch",
+          &tetrahedralize_batch,
+          py::arg("plcs"),
+          py::arg("compute_boundary_faces") = true,
+          py::arg("num_threads") = 0,
+          py::arg("progress") = py::none(),
+          py::arg("cancel") = py::none(),
+          py::arg("progress_interval") = 0.5,
+          py::arg("time_budget_s") = 0.0,
+          py::arg("memory_budget_bytes") = 0,
+          py::arg("dump_dir") = py::none(),
+          R"pbdoc(
+              Mesh many PLCs concurrently on a native thread pool and return a list of TetwrapIO.
+              Each PLC is a tuple (vertices, mesh_facets, mesh_facet_markers, boundary_facets,
+              tetgen_switches[, mesh_facet_offsets, boundary_facet_offsets, boundary_facet_markers])
+              or a dict with those keys. num_threads <= 0 uses all hardware threads.
+              progress, cancel and the budgets behave as in _tetrahedralize, budgets per PLC;
+              "item" is the PLC index and the callback may be invoked from several worker
+              threads (one at a time).
+          )pbdoc");
+
+    m.def("_tetrahedralize_tiled",
+          &tetrahedralize_tiled,
+          py::arg("vertices"),
+          py::arg("mesh_facets"),
+          py::arg("mesh_facet_markers") = py::none(),
+          py::arg("boundary_facets"),
+          py::arg("tetgen_switches"),
+          py::arg("compute_boundary_faces") = true,
+          py::arg("mesh_facet_offsets") = py::none(),
+          py::arg("boundary_facet_offsets") = py::none(),
+          py::arg("boundary_facet_markers") = py::none(),
+          py::arg("tiles_x") = 2,
+          py::arg("tiles_y") = 2,
+          py::arg("spacing") = 0.0,
+          py::arg("num_threads") = 0,
+          py::arg("progress") = py::none(),
+          py::arg("cancel") = py::none(),
+          py::arg("progress_interval") = 0.5,
+          py::arg("time_budget_s") = 0.0,
+          py::arg("memory_budget_bytes") = 0,
+          py::arg("dump_dir") = py::none(),
+          py::arg("sizing") = py::none(),
+          R"pbdoc(
+              Mesh one box-shaped PLC as tiles_x * tiles_y XY tiles on a native thread pool
+              and return the stitched mesh as one TetwrapIO. The PLC needs a flat top
+              polygon, side polygons in the four vertical bounding box planes and a 2.5D
+              surface (mesh facets and any other boundary polygons) in between. Tile walls
+              and tops are triangulated with edges of about `spacing` (<= 0: the median
+              surface edge) and kept by TetGen (-Y is added), so the tiles conform.
+              Arguments otherwise as in _tetrahedralize; "item" in progress reports is
+              the tile index and a failing tile is dumped on its own. Not supported: -r,
+              -e and -o2. sizing as in _tetrahedralize; it refines tile interiors only.
+          )pbdoc");
+
+    m.def("_remesh_region",
+          &remesh_region,
+          py::arg("points"),
+          py::arg("tets"),
+          py::arg("neighbors"),
+          py::arg("boundary_faces"),
+          py::arg("boundary_tets"),
+          py::arg("boundary_local_faces"),
+          py::arg("boundary_markers"),
+          py::arg("box_min"),
+          py::arg("box_max"),
+          py::arg("vertices"),
+          py::arg("mesh_facets"),
+          py::arg("mesh_facet_markers") = py::none(),
+          py::arg("boundary_facets"),
+          py::arg("tetgen_switches"),
+          py::arg("compute_boundary_faces") = true,
+          py::arg("mesh_facet_offsets") = py::none(),
+          py::arg("boundary_facet_offsets") = py::none(),
+          py::arg("boundary_facet_markers") = py::none(),
+          py::arg("progress") = py::none(),
+          py::arg("cancel") = py::none(),
+          py::arg("progress_interval") = 0.5,
+          py::arg("time_budget_s") = 0.0,
+          py::arg("memory_budget_bytes") = 0,
+          py::arg("dump_dir") = py::none(),
+          py::arg("sizing") = py::none(),
+          R"pbdoc(
+              Replace the tets of an existing mesh whose bounding boxes meet [box_min, box_max]
+              by a new local mesh and splice it back. The mesh is given by its points, (K,4)
+              tets, optional neighbors and its boundary faces with raw TetGen markers (or
+              None). The patch PLC (vertices, mesh_facets, boundary_facets; both facet lists
+              may be empty) replaces the part of the domain boundary its rim cuts off inside
+              the region; rim vertices must coincide with boundary points there. Only the
+              region is meshed by TetGen (-pYJ are added). Returns (TetwrapIO, point_map,
+              tet_map); the maps give the new index of every old point / tet, or -1.
+              sizing as in _tetrahedralize, applied to the region.
+          )pbdoc");
+
+    m.def("_refine",
+          &refine_mesh,
+          py::arg("points"),
+          py::arg("tets"),
+          py::arg("faces") = py::none(),
+          py::arg("face_markers") = py::none(),
+          py::arg("tet_volumes") = py::none(),
+          py::arg("tet_attr") = py::none(),
+          py::arg("tetgen_switches"),
+          py::arg("compute_boundary_faces") = true,
+          py::arg("progress") = py::none(),
+          py::arg("cancel") = py::none(),
+          py::arg("progress_interval") = 0.5,
+          py::arg("time_budget_s") = 0.0,
+          py::arg("memory_budget_bytes") = 0,
+          py::arg("sizing") = py::none(),
+          R"pbdoc(
+              Rebuild an existing mesh in TetGen and refine it (-r is added, -p is rejected).
+              points (N,3) and tets (K,4) or (K,10) are read in place, as are the constrained
+              faces (F,3) with their raw TetGen markers; faces marked 0 are skipped.
+              tet_volumes (K,) gives a maximum volume per tet (<= 0: none) and adds -a;
+              tet_attr (K,A) carries region attributes over. Returns a TetwrapIO as
+              _tetrahedralize. No repro bundle is written on failure. sizing as in
+              _tetrahedralize.
+          )pbdoc");
+
+    m.def("_write_vtu",
+          [](const std::string& path, ArrayF64 points, ArrayI32 tets, py::object faces,
+             py::object face_markers, bool compress, int num_threads) {
+              write_mesh_file(false, path, points, tets, faces, face_markers, compress, num_threads);
+          },
+          py::arg("path"),
+          py::arg("points"),
+          py::arg("tets"),
+          py::arg("faces") = py::none(),
+          py::arg("face_markers") = py::none(),
+          py::arg("compress") = false,
+          py::arg("num_threads") = 0,
+          R"pbdoc(
+              Write tets and optional boundary triangles to a VTU file with raw appended
+              binary data. Faces become triangle cells after the tets; face_markers
+              become a "marker" cell array (-1 on tets). compress=True zlib-compresses
+              1 MiB blocks on num_threads threads (<= 0: all hardware threads).
           )pbdoc");
+
+    m.def("_write_xdmf",
+          [](const std::string& path, ArrayF64 points, ArrayI32 tets, py::object faces,
+             py::object face_markers) {
+              write_mesh_file(true, path, points, tets, faces, face_markers, false, 0);
+          },
+          py::arg("path"),
+          py::arg("points"),
+          py::arg("tets"),
+          py::arg("faces") = py::none(),
+          py::arg("face_markers") = py::none(),
+          R"pbdoc(
+              Write an XDMF 3 file with a tet grid and a boundary triangle grid sharing
+              the points; the arrays go to a raw binary file next to it (path with a
+              .bin extension).
+          )pbdoc");
+
+    m.def("_load_plc_bundle", &load_plc_bundle, py::arg("path"),
+          "Read a repro bundle: dict of _tetrahedralize keyword arguments plus error_code and tetgen_version.");
+
+    // TetGen's own formats; arrays are 0-based, files numbered from first_index
+    m.def("_read_tetgen_node", &read_node_file, py::arg("path"), py::arg("num_threads") = 0,
+          "Read a .node file: dict with points, attributes, markers (None if absent) and first_index.");
+    m.def("_read_tetgen_ele", &read_ele_file, py::arg("path"), py::arg("first_index") = -1,
+          py::arg("num_threads") = 0,
+          "Read a .ele file: dict with tets and attributes. first_index -1 uses the file's first record number.");
+    m.def("_read_tetgen_face", &read_face_file, py::arg("path"), py::arg("first_index") = -1,
+          py::arg("num_threads") = 0, "Read a .face file: dict with faces and markers.");
+    m.def("_read_tetgen_neigh", &read_neigh_file, py::arg("path"), py::arg("first_index") = -1,
+          py::arg("num_threads") = 0, "Read a .neigh file as a (K, 4) array, -1 for no neighbor.");
+    m.def("_read_tetgen_smesh", &read_smesh_file, py::arg("path"), py::arg("first_index") = -1,
+          "Read a .smesh or .poly file: dict with points (None when in a .node file), facets in CSR form, holes, "
+          "regions.");
+    m.def("_write_tetgen_node", &write_node_file, py::arg("path"), py::arg("points"),
+          py::arg("attributes") = py::none(), py::arg("markers") = py::none(), py::arg("first_index") = 0,
+          py::arg("num_threads") = 0);
+    m.def("_write_tetgen_ele", &write_ele_file, py::arg("path"), py::arg("tets"),
+          py::arg("attributes") = py::none(), py::arg("first_index") = 0, py::arg("num_threads") = 0);
+    m.def("_write_tetgen_face", &write_face_file, py::arg("path"), py::arg("faces"),
+          py::arg("markers") = py::none(), py::arg("first_index") = 0, py::arg("num_threads") = 0);
+    m.def("_write_tetgen_neigh", &write_neigh_file, py::arg("path"), py::arg("neighbors"),
+          py::arg("first_index") = 0, py::arg("num_threads") = 0);
+    m.def("_write_tetgen_smesh", &write_smesh_file, py::arg("path"), py::arg("facet_offsets"),
+          py::arg("facet_indices"), py::arg("facet_markers") = py::none(), py::arg("holes") = py::none(),
+          py::arg("first_index") = 0);
 }
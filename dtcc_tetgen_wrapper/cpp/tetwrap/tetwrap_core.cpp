@@ -0,0 +1,929 @@
+#include "tetwrap_core.h"
+#include "tetwrap_detail.h"
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <iostream>
+#include <ctime>
+#include <iterator>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+// Set by CMake from the TetGen sources
+#ifndef TETWRAP_TETGEN_VERSION
+#define TETWRAP_TETGEN_VERSION "unknown"
+#endif
+
+namespace tetwrap {
+
+const char* tetgen_version()
+{
+    return TETWRAP_TETGEN_VERSION;
+}
+
+// Call `fn` with the typed vertex / triangle pointer of a PLC
+template <typename Fn>
+static void with_vertices(const PlcInput& plc, Fn&& fn)
+{
+    if (plc.vertices_f32) fn(plc.vertices_f32);
+    else fn(plc.vertices);
+}
+
+template <typename Fn>
+static void with_indices(const FacetList& fl, Fn&& fn)
+{
+    if (fl.indices_i64) fn(fl.indices_i64);
+    else fn(fl.indices);
+}
+
+// tetgenio frees every list it points to. Lists that borrow caller memory
+// (or live in a FacetArena) are detached here before that happens; declare
+// after the guarded tetgenio.
+struct BorrowGuard {
+    tetgenio& io;
+    bool pointlist = false;
+    bool facetlist = false;
+    bool tetrahedronlist = false;
+    bool tetrahedronvolumelist = false;
+    bool tetrahedronattributelist = false;
+    bool trifacelist = false;               // with trifacemarkerlist
+
+    explicit BorrowGuard(tetgenio& io_) : io(io_) {}
+    ~BorrowGuard()
+    {
+        if (pointlist) io.pointlist = nullptr;
+        if (facetlist) {
+            io.facetlist = nullptr;
+            io.numberoffacets = 0;
+        }
+        if (tetrahedronlist) io.tetrahedronlist = nullptr;
+        if (tetrahedronvolumelist) io.tetrahedronvolumelist = nullptr;
+        if (tetrahedronattributelist) io.tetrahedronattributelist = nullptr;
+        if (trifacelist) {
+            io.trifacelist = nullptr;
+            io.trifacemarkerlist = nullptr;
+        }
+    }
+};
+
+// Facets, polygons and narrowed vertex lists of one run in three contiguous
+// blocks instead of two new[] per facet. int32 indices are not copied at all:
+// TetGen only reads vertexlist, so polygons point straight into the caller's
+// buffer. Everything is released at once when the arena goes out of scope.
+struct FacetArena {
+    std::vector<tetgenio::facet> facets;
+    std::vector<tetgenio::polygon> polygons;
+    std::vector<int> vertices;
+
+    void reserve(int num_facets, std::int64_t num_copied_indices)
+    {
+        facets.resize(static_cast<std::size_t>(num_facets));
+        polygons.resize(static_cast<std::size_t>(num_facets));
+        vertices.reserve(static_cast<std::size_t>(num_copied_indices));
+    }
+};
+
+#if !TETWRAP_TETGEN_THREADSAFE
+// The TetGen sources could not be patched for thread isolation (see
+// CMakeLists.txt), so concurrent callers take turns.
+static std::mutex tetgen_mutex;
+#endif
+
+// ===================== Repro bundles =====================
+// Layout (host byte order, checked on load): BundleHeader, the switch and
+// version strings, then vertices f64 (N,3), mesh offsets i64 (M+1, CSR
+// only), mesh indices i32, mesh markers i32 (M, if any), boundary offsets
+// i64 (B+1), boundary indices i32, boundary markers i32 (B, if any).
+namespace {
+
+constexpr char kBundleMagic[8] = {'T', 'E', 'T', 'W', 'P', 'L', 'C', '\n'};
+constexpr std::uint32_t kBundleVersion = 1;
+constexpr std::uint32_t kByteOrderProbe = 0x01020304;
+
+constexpr std::uint32_t kMeshCsr = 1;
+constexpr std::uint32_t kMeshMarkers = 2;
+constexpr std::uint32_t kBoundaryMarkers = 4;
+constexpr std::uint32_t kComputeBoundaryFaces = 8;
+
+struct BundleHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::int64_t num_vertices;
+    std::int64_t mesh_count;
+    std::int64_t mesh_indices;
+    std::int64_t boundary_count;
+    std::int64_t boundary_indices;
+    std::uint32_t flags;
+    std::int32_t error_code;
+    std::uint32_t switches_bytes;
+    std::uint32_t version_bytes;
+};
+static_assert(sizeof(BundleHeader) == 72, "BundleHeader must have no padding");
+
+template <typename T>
+void append(std::vector<char>& buf, const T* data, std::size_t count)
+{
+    const char* bytes = reinterpret_cast<const char*>(data);
+    buf.insert(buf.end(), bytes, bytes + count * sizeof(T));
+}
+
+template <typename T>
+void append_value(std::vector<char>& buf, T value)
+{
+    append(buf, &value, 1);
+}
+
+// Indices in the bundle's int32, offsets in int64 (generated for triangles)
+void append_facets(std::vector<char>& buf, const FacetList& fl, bool with_offsets)
+{
+    if (with_offsets) {
+        for (int i = 0; i < fl.count; ++i) append_value<std::int64_t>(buf, fl.begin(i));
+        append_value<std::int64_t>(buf, fl.num_indices);
+    }
+    with_indices(fl, [&](const auto* I) {
+        for (std::int64_t j = 0; j < fl.num_indices; ++j) append_value<std::int32_t>(buf, static_cast<std::int32_t>(I[j]));
+    });
+}
+
+// Bounds-checked reads from a loaded bundle
+class BundleReader {
+public:
+    BundleReader(const std::string& path, std::vector<char> data) : path_(path), data_(std::move(data)) {}
+
+    template <typename T>
+    void read(T* out, std::size_t count)
+    {
+        const std::size_t bytes = count * sizeof(T);
+        if (bytes / sizeof(T) != count || data_.size() - pos_ < bytes)
+            throw std::runtime_error(path_ + ": truncated repro bundle");
+        if (bytes) std::memcpy(out, data_.data() + pos_, bytes);
+        pos_ += bytes;
+    }
+
+    template <typename T>
+    std::vector<T> array(std::int64_t count)
+    {
+        if (count < 0) throw std::runtime_error(path_ + ": corrupt repro bundle");
+        std::vector<T> v(static_cast<std::size_t>(count));
+        read(v.data(), v.size());
+        return v;
+    }
+
+    std::string text(std::uint32_t bytes)
+    {
+        std::string s(bytes, '\0');
+        read(&s[0], s.size());
+        return s;
+    }
+
+private:
+    std::string path_;
+    std::vector<char> data_;
+    std::size_t pos_ = 0;
+};
+
+std::string default_dump_dir()
+{
+    if (const char* env = std::getenv("TETWRAP_DUMP_DIR"))
+        if (*env) return env;
+    std::error_code ec;
+    const std::filesystem::path tmp = std::filesystem::temp_directory_path(ec);
+    return ec ? std::string(".") : tmp.string();
+}
+
+// Unique per process and run, so concurrent jobs never overwrite each other
+std::string dump_path(const std::string& dir)
+{
+    static std::atomic<unsigned> counter{0};
+    const std::time_t now = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+#if defined(_WIN32)
+    const long pid = static_cast<long>(_getpid());
+#else
+    const long pid = static_cast<long>(::getpid());
+#endif
+    std::ostringstream name;
+    name << "tetwrap-fail-" << stamp << '-' << pid << '-' << counter.fetch_add(1) << ".tetplc";
+    return (std::filesystem::path(dir) / name.str()).string();
+}
+
+// Write the failure bundle; returns its path, or "" if it could not be written
+std::string dump_plc(const PlcInput& plc, int code, const RunOptions& options)
+{
+    try {
+        const std::string dir = options.dump_dir.empty() ? default_dump_dir() : options.dump_dir;
+        std::filesystem::create_directories(dir);
+        const std::string path = dump_path(dir);
+        write_plc_bundle(path, plc, code);
+        return path;
+    } catch (...) {
+        // The original error matters more than a missing dump
+        return std::string();
+    }
+}
+
+}  // namespace
+
+void write_plc_bundle(const std::string& path, const PlcInput& plc, int error_code)
+{
+    std::string switches(plc.switches.begin(), plc.switches.end());
+    while (!switches.empty() && switches.back() == '\0') switches.pop_back();
+    const std::string version = TETWRAP_TETGEN_VERSION;
+
+    const FacetList& mf = plc.mesh_facets;
+    const FacetList& bf = plc.boundary_facets;
+    BundleHeader h;
+    std::memcpy(h.magic, kBundleMagic, sizeof(h.magic));
+    h.version = kBundleVersion;
+    h.byte_order = kByteOrderProbe;
+    h.num_vertices = plc.num_vertices;
+    h.mesh_count = mf.count;
+    h.mesh_indices = mf.num_indices;
+    h.boundary_count = bf.count;
+    h.boundary_indices = bf.num_indices;
+    h.flags = (mf.offsets ? kMeshCsr : 0u) | (plc.mesh_facet_markers ? kMeshMarkers : 0u) |
+              (plc.boundary_facet_markers ? kBoundaryMarkers : 0u) |
+              (plc.compute_boundary_faces ? kComputeBoundaryFaces : 0u);
+    h.error_code = error_code;
+    h.switches_bytes = static_cast<std::uint32_t>(switches.size());
+    h.version_bytes = static_cast<std::uint32_t>(version.size());
+
+    // Assemble the whole bundle, then write it at once
+    std::vector<char> buf;
+    const std::size_t N3 = 3 * static_cast<std::size_t>(std::max(0, plc.num_vertices));
+    buf.reserve(sizeof(h) + switches.size() + version.size() + 8 * N3 +
+                12 * static_cast<std::size_t>(mf.num_indices + bf.num_indices + mf.count + bf.count + 2));
+    append_value(buf, h);
+    append(buf, switches.data(), switches.size());
+    append(buf, version.data(), version.size());
+    with_vertices(plc, [&](const auto* V) {
+        for (std::size_t i = 0; i < N3; ++i) append_value<double>(buf, static_cast<double>(V[i]));
+    });
+    append_facets(buf, mf, mf.offsets != nullptr);
+    if (plc.mesh_facet_markers) append(buf, plc.mesh_facet_markers, static_cast<std::size_t>(mf.count));
+    append_facets(buf, bf, true);
+    if (plc.boundary_facet_markers) append(buf, plc.boundary_facet_markers, static_cast<std::size_t>(bf.count));
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) throw std::runtime_error("cannot create " + path);
+    const bool ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+    if (std::fclose(f) != 0 || !ok) throw std::runtime_error("cannot write " + path);
+}
+
+PlcBundle read_plc_bundle(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(BundleHeader) || std::memcmp(data.data(), kBundleMagic, sizeof(kBundleMagic)) != 0)
+        throw std::runtime_error(path + " is not a tetwrap repro bundle");
+    BundleReader r(path, std::move(data));
+
+    BundleHeader h;
+    r.read(&h, 1);
+    if (h.byte_order != kByteOrderProbe)
+        throw std::runtime_error(path + " was written on a machine with a different byte order");
+    if (h.version != kBundleVersion)
+        throw std::runtime_error(path + ": unsupported repro bundle version " + std::to_string(h.version));
+
+    PlcBundle b;
+    b.switches = r.text(h.switches_bytes);
+    b.tetgen_version = r.text(h.version_bytes);
+    b.error_code = h.error_code;
+    b.compute_boundary_faces = (h.flags & kComputeBoundaryFaces) != 0;
+    b.vertices = r.array<double>(3 * h.num_vertices);
+    if (h.flags & kMeshCsr) b.mesh_offsets = r.array<std::int64_t>(h.mesh_count + 1);
+    b.mesh_indices = r.array<int>(h.mesh_indices);
+    if (h.flags & kMeshMarkers) b.mesh_markers = r.array<int>(h.mesh_count);
+    b.boundary_offsets = r.array<std::int64_t>(h.boundary_count + 1);
+    b.boundary_indices = r.array<int>(h.boundary_indices);
+    if (h.flags & kBoundaryMarkers) b.boundary_markers = r.array<int>(h.boundary_count);
+    return b;
+}
+
+PlcInput PlcBundle::view() const
+{
+    PlcInput plc;
+    plc.vertices = vertices.data();
+    plc.num_vertices = static_cast<int>(vertices.size() / 3);
+    plc.mesh_facets.indices = mesh_indices.data();
+    plc.mesh_facets.num_indices = static_cast<std::int64_t>(mesh_indices.size());
+    if (mesh_offsets.empty()) {
+        plc.mesh_facets.count = static_cast<int>(mesh_indices.size() / 3);
+    } else {
+        plc.mesh_facets.offsets = mesh_offsets.data();
+        plc.mesh_facets.count = static_cast<int>(mesh_offsets.size() - 1);
+    }
+    plc.mesh_facet_markers = mesh_markers.empty() ? nullptr : mesh_markers.data();
+    plc.boundary_facets.indices = boundary_indices.data();
+    plc.boundary_facets.num_indices = static_cast<std::int64_t>(boundary_indices.size());
+    plc.boundary_facets.offsets = boundary_offsets.data();
+    plc.boundary_facets.count = static_cast<int>(boundary_offsets.size() - 1);
+    plc.boundary_facet_markers = boundary_markers.empty() ? nullptr : boundary_markers.data();
+    plc.switches.assign(switches.begin(), switches.end());
+    plc.switches.push_back('\0');
+    plc.compute_boundary_faces = compute_boundary_faces;
+    return plc;
+}
+
+// Check CSR structure and index ranges of one facet list. `unit` names a
+// polygon in error messages ("row" for triangle arrays).
+static void validate_facets(const FacetList& fl, int N, const std::string& name)
+{
+    const std::string unit = fl.offsets ? "polygon" : "row";
+    if (fl.count < 0) throw std::runtime_error(name + ": count < 0");
+    if (fl.count > 0 && !fl.indices && !fl.indices_i64)
+        throw std::runtime_error(name + " buffer is missing");
+    if (fl.offsets) {
+        if (fl.offsets[0] != 0)
+            throw std::runtime_error(name + " offsets must start at 0");
+        for (int i = 0; i < fl.count; ++i) {
+            if (fl.end(i) - fl.begin(i) < 3)
+                throw std::runtime_error(name + " has fewer than 3 vertices: polygon " + std::to_string(i));
+        }
+        if (fl.offsets[fl.count] != fl.num_indices)
+            throw std::runtime_error(name + " offsets must end at the number of indices");
+    } else if (fl.num_indices != 3 * static_cast<std::int64_t>(fl.count)) {
+        throw std::runtime_error(name + " must have shape (M,3)");
+    }
+
+    // Index range checks (in the caller's index width, so int64 values
+    // beyond the int range are rejected rather than truncated)
+    with_indices(fl, [&](const auto* I) {
+        for (int i = 0; i < fl.count; ++i) {
+            for (std::int64_t j = fl.begin(i); j < fl.end(i); ++j) {
+                if (I[j] < 0 || I[j] >= N)
+                    throw std::runtime_error(name + " index out of range at " + unit + " " + std::to_string(i));
+            }
+        }
+    });
+}
+
+void validate_plc(const PlcInput& plc)
+{
+    if (plc.boundary_facets.count < 1)
+        throw std::runtime_error("boundary_facets must contain at least one polygon (list of vertex indices)");
+
+    const int N = plc.num_vertices;
+    if (N <= 0) throw std::runtime_error("vertices: N <= 0");
+    if (!plc.vertices && !plc.vertices_f32)
+        throw std::runtime_error("vertices buffer is missing");
+
+    validate_facets(plc.mesh_facets, N, "mesh_facets");
+    validate_facets(plc.boundary_facets, N, "boundary_facets");
+    if (plc.boundary_facet_markers) {
+        for (int bi = 0; bi < plc.boundary_facets.count; ++bi) {
+            if (plc.boundary_facet_markers[bi] < 0)
+                throw std::runtime_error("boundary_facet_markers must be >= 0 (polygon " + std::to_string(bi) + ")");
+        }
+    }
+}
+
+// Shapes and point index ranges of a mesh passed to run_tetgen_refine()
+static void validate_refine_input(const RefineInput& mesh, int num_threads)
+{
+    if (!mesh.points || mesh.num_points <= 0) throw std::runtime_error("refinement: points are missing");
+    if (!mesh.tets || mesh.num_tets <= 0) throw std::runtime_error("refinement: tets are missing");
+    if (mesh.corners != 4 && mesh.corners != 10) throw std::runtime_error("refinement: tets must have 4 or 10 corners");
+    if (mesh.num_faces < 0 || (mesh.num_faces > 0 && !mesh.faces))
+        throw std::runtime_error("refinement: faces are missing");
+    if (mesh.num_tet_attributes < 0) throw std::runtime_error("refinement: num_tet_attributes < 0");
+
+    auto check = [&](const int* ids, std::size_t n, const char* name) {
+        detail::parallel_chunks(n, std::size_t(1) << 16, num_threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                if (ids[i] < 0 || ids[i] >= mesh.num_points)
+                    throw std::runtime_error(std::string("refinement: ") + name + " refer to a point out of range");
+        });
+    };
+    check(mesh.tets, static_cast<std::size_t>(mesh.num_tets) * static_cast<std::size_t>(mesh.corners), "tets");
+    if (mesh.num_faces > 0) check(mesh.faces, 3 * static_cast<std::size_t>(mesh.num_faces), "faces");
+}
+
+bool has_switch(const std::vector<char>& sw, char flag)
+{
+    for (char c : sw) {
+        if (c == '\0') break;
+        if (c == flag) return true;
+    }
+    return false;
+}
+
+void add_switch(std::vector<char>& sw, char flag)
+{
+    if (has_switch(sw, flag)) return;
+    if (!sw.empty() && sw.back() == '\0') sw.pop_back();
+    sw.push_back(flag);
+    sw.push_back('\0');
+}
+
+using detail::FaceTable;
+using detail::faces_of_tet;
+using detail::parallel_chunks;
+using detail::sorted_face;
+
+BoundaryFaces compute_boundary_face_tris(const int* tets, const int* nbrs, int num_tets, int num_threads)
+{
+    const std::size_t T = num_tets > 0 ? static_cast<std::size_t>(num_tets) : 0;
+
+    // Per-chunk count of hull faces, then an exclusive scan gives every
+    // chunk its output offset so the fill pass writes without contention
+    // and in the same (tet, local face) order as a serial walk.
+    const std::size_t max_chunks = static_cast<std::size_t>(
+        num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::size_t> offset(max_chunks + 1, 0);
+    const std::size_t min_chunk = 1 << 16;
+    const std::size_t chunks = parallel_chunks(T, min_chunk, num_threads,
+        [&](std::size_t c, std::size_t begin, std::size_t end) {
+            std::size_t count = 0;
+            for (std::size_t i = begin; i < end; ++i)
+                for (int lf = 0; lf < 4; ++lf)
+                    if (nbrs[4 * i + lf] < 0) ++count;
+            offset[c + 1] = count;
+        });
+    for (std::size_t c = 0; c < chunks; ++c) offset[c + 1] += offset[c];
+
+    BoundaryFaces bf;
+    const std::size_t B = offset[chunks];
+    bf.faces.resize(3 * B);
+    bf.tets.resize(B);
+    bf.local_faces.resize(B);
+
+    parallel_chunks(T, min_chunk, num_threads,
+        [&](std::size_t c, std::size_t begin, std::size_t end) {
+            std::size_t b = offset[c];
+            for (std::size_t i = begin; i < end; ++i) {
+                for (int lf = 0; lf < 4; ++lf) {
+                    if (nbrs[4 * i + lf] < 0) {
+                        const int* pat = faces_of_tet[lf];
+                        bf.faces[3 * b + 0] = tets[4 * i + pat[0]];
+                        bf.faces[3 * b + 1] = tets[4 * i + pat[1]];
+                        bf.faces[3 * b + 2] = tets[4 * i + pat[2]];
+                        bf.tets[b] = static_cast<int>(i);
+                        bf.local_faces[b] = lf;
+                        ++b;
+                    }
+                }
+            }
+        });
+    return bf;
+}
+
+std::vector<int> boundary_face_markers(const int* boundary_faces, std::size_t num_boundary_faces,
+                                       const int* trifaces, const int* trimarkers, int num_trifaces)
+{
+    // Index only the boundary faces (far fewer than all tri faces), then
+    // stream the tri face list once and pick up the markers of hits.
+    FaceTable table(num_boundary_faces);
+    for (std::size_t i = 0; i < num_boundary_faces; ++i)
+        table.insert(sorted_face(boundary_faces + 3 * i), static_cast<int>(i));
+
+    std::vector<int> markers(num_boundary_faces, 0);
+    for (int i = 0; i < num_trifaces; ++i) {
+        const int bi = table.find(sorted_face(trifaces + 3 * static_cast<std::size_t>(i)));
+        if (bi >= 0) markers[bi] = trimarkers[i];
+    }
+    return markers;
+}
+
+BoundaryFaces hull_faces_from_trifaces(const int* tets, int num_tets,
+                                       const int* trifaces, const int* trimarkers, int num_trifaces)
+{
+    FaceTable table(static_cast<std::size_t>(std::max(num_trifaces, 0)));
+    for (int i = 0; i < num_trifaces; ++i)
+        table.insert(sorted_face(trifaces + 3 * static_cast<std::size_t>(i)), i);
+
+    // Count how many tets share each tri face and remember the last one;
+    // faces touched by exactly one tet lie on the hull.
+    std::vector<std::uint8_t> hits(static_cast<std::size_t>(std::max(num_trifaces, 0)), 0);
+    std::vector<std::int64_t> owner(hits.size(), -1);
+    for (std::int64_t i = 0; i < num_tets; ++i) {
+        const int* t = tets + 4 * i;
+        for (int lf = 0; lf < 4; ++lf) {
+            const int* pat = faces_of_tet[lf];
+            const int f[3] = {t[pat[0]], t[pat[1]], t[pat[2]]};
+            const int fi = table.find(sorted_face(f));
+            if (fi < 0) continue;
+            if (hits[fi] < 2) ++hits[fi];
+            owner[fi] = 4 * i + lf;
+        }
+    }
+
+    // Emit in (tet, local face) order, oriented as seen from the owning tet,
+    // so the result matches compute_boundary_face_tris().
+    std::vector<std::pair<std::int64_t, int>> hull;
+    for (std::size_t fi = 0; fi < hits.size(); ++fi)
+        if (hits[fi] == 1) hull.emplace_back(owner[fi], static_cast<int>(fi));
+    std::sort(hull.begin(), hull.end());
+
+    BoundaryFaces bf;
+    const std::size_t B = hull.size();
+    bf.faces.resize(3 * B);
+    bf.tets.resize(B);
+    bf.local_faces.resize(B);
+    if (trimarkers) bf.markers.resize(B);
+    for (std::size_t b = 0; b < B; ++b) {
+        const std::int64_t ti = hull[b].first / 4;
+        const int lf = static_cast<int>(hull[b].first % 4);
+        const int* pat = faces_of_tet[lf];
+        bf.faces[3 * b + 0] = tets[4 * ti + pat[0]];
+        bf.faces[3 * b + 1] = tets[4 * ti + pat[1]];
+        bf.faces[3 * b + 2] = tets[4 * ti + pat[2]];
+        bf.tets[b] = static_cast<int>(ti);
+        bf.local_faces[b] = lf;
+        if (trimarkers) bf.markers[b] = trimarkers[hull[b].second];
+    }
+    return bf;
+}
+
+// Fill arena facets [first ..] with one single-polygon facet per entry of
+// `fl`. The arena must have been reserved for every facet and copied index.
+static void pack_facets(FacetArena& arena, int first, const FacetList& fl)
+{
+    with_indices(fl, [&](const auto* I) {
+        using Index = std::remove_cv_t<std::remove_pointer_t<decltype(I)>>;
+        for (int i = 0; i < fl.count; ++i)
+        {
+            tetgenio::facet &fac = arena.facets[first + i];
+            tetgenio::polygon &poly = arena.polygons[first + i];
+            fac.numberofholes = 0;
+            fac.holelist = nullptr;
+            fac.numberofpolygons = 1;
+            fac.polygonlist = &poly;
+            const std::int64_t b = fl.begin(i);
+            poly.numberofvertices = static_cast<int>(fl.end(i) - b);
+            if constexpr (std::is_same<Index, int>::value) {
+                poly.vertexlist = const_cast<int*>(I + b);
+            } else {
+                // Validated to fit in int; reserve() keeps data() stable
+                const std::size_t at = arena.vertices.size();
+                arena.vertices.insert(arena.vertices.end(), I + b, I + fl.end(i));
+                poly.vertexlist = arena.vertices.data() + at;
+            }
+        }
+    });
+}
+
+// Write a wrapper-computed array into a mapped .npy file
+static NpyFile copy_to_npy(const std::string& path, const std::vector<int>& v, std::vector<std::int64_t> shape)
+{
+    NpyFile f = NpyFile::create<int>(path, std::move(shape));
+    if (!v.empty()) std::memcpy(f.data<int>(), v.data(), v.size() * sizeof(int));
+    return f;
+}
+
+// Boundary faces come from the neighbor list when the caller asked for it
+// (-n). Otherwise TetGen's default face output (the subfaces, with markers)
+// is matched against the tets, so neither the neighbor list nor every tri
+// face (-f) has to be built. With -F there is no face output at all and
+// neighbors are requested instead. Returns whether the tri faces are used.
+static bool boundary_face_switches(std::vector<char>& sw, bool compute_boundary_faces)
+{
+    if (!compute_boundary_faces || has_switch(sw, 'n')) return false;
+    if (!has_switch(sw, 'F')) return true;
+    add_switch(sw, 'n');
+    return false;
+}
+
+static void open_output_dir(MeshResult& result, const RunOptions& options)
+{
+    if (options.output_dir.empty()) return;
+    std::error_code ec;
+    std::filesystem::create_directories(options.output_dir, ec);
+    if (ec) throw std::runtime_error("cannot create output_dir " + options.output_dir + ": " + ec.message());
+    result.streamed.reset(new StreamedMesh());
+    result.streamed->dir = options.output_dir;
+}
+
+// Parse the switches and run TetGen on a packed input. TetGen's error codes
+// become RunAborted / std::runtime_error with `input` (a summary of the
+// input sizes) in the message; `dump`, when set, writes a repro file for a
+// failed run and returns its path. A sizing field is only consulted by the
+// quality refinement, so it adds -q.
+static void run_packed(tetgenio& in, std::vector<char>& sw, MeshResult& result, const RunOptions& options,
+                       const SizingField* sizing, const std::string& input,
+                       const std::function<std::string(int)>& dump)
+{
+    PhaseClock clock(result.stats);
+    StreamedMesh* streamed = result.streamed.get();
+    if (sizing) add_switch(sw, 'q');
+    SizingHook hook(in, sizing);
+    try {
+        tetgenbehavior behavior;
+        if (!behavior.parse_commandline(sw.data())) throw 10;
+        if (streamed && behavior.order == 2)
+            throw std::runtime_error("output_dir does not support second-order tets (-o2)");
+#if !TETWRAP_TETGEN_THREADSAFE
+        std::lock_guard<std::mutex> lock(tetgen_mutex);
+        clock.lap("tetgen_lock_wait");
+#endif
+        tetrahedralize_phased(behavior, &in, result.out.get(), result.stats, options, streamed);
+    } catch (int code) {
+        if (code == kAbortCancelled) throw RunAborted(code, "meshing cancelled");
+
+        const RunControl* control = options.control;
+        std::string msg;
+        switch (code) {
+        case 1:  msg = "out of memory"; break;
+        case 2:  msg = "internal error (report bug)"; break;
+        case 3:  msg = "input surface has self-intersections"; break;
+        case 4:  msg = "very small input feature size (use -T to relax)"; break;
+        case 5:  msg = "two very close input facets (try -Y)"; break;
+        case 10: msg = "input error"; break;
+        case 200: msg = "boundary contains Steiner points (-YY)"; break;
+        case kAbortTimeBudget: {
+            std::ostringstream os;
+            os << "time budget of " << control->time_budget_s << " s exceeded";
+            msg = os.str();
+            break;
+        }
+        case kAbortMemoryBudget:
+            msg = "memory budget of " + std::to_string(control->memory_budget_bytes) + " bytes exceeded";
+            break;
+        default: msg = "unknown TetGen code"; break;
+        }
+
+        // Reconstruct switch string (strip trailing NUL if present)
+        std::string sw_str;
+        if (!sw.empty()) {
+            const bool has_nul = sw.back() == '\0';
+            sw_str.assign(sw.begin(), sw.begin() + static_cast<std::ptrdiff_t>(sw.size() - (has_nul ? 1 : 0)));
+        }
+
+        // Basic input summary
+        std::ostringstream summary;
+        const bool over_budget = code == kAbortTimeBudget || code == kAbortMemoryBudget;
+        summary << (over_budget ? "TetGen aborted" : "TetGen failed") << " (code " << code << "): " << msg
+                << " | switches=\"" << sw_str << "\""
+                << " | " << input;
+
+        // Budget aborts are the caller's limits, not TetGen failures
+        if (over_budget) throw RunAborted(code, summary.str());
+
+        // Dump the input for repro
+        if (dump) {
+            const std::string path = dump(code);
+            if (!path.empty()) summary << " | repro=" << path;
+        }
+
+        // Print to stderr for visibility, then raise to Python
+        std::cerr << summary.str() << std::endl;
+        throw std::runtime_error(summary.str());
+    } catch (const RunAborted&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string("TetGen failed: ") + e.what());
+    } catch (...) {
+        throw std::runtime_error("TetGen failed with an unknown error. This may be due to invalid input geometry or incompatible switches.");
+    }
+}
+
+// Boundary faces from (T,4) neighbors, with markers looked up from the tri
+// faces, or straight from the tri faces
+static void extract_boundary_faces(MeshResult& result, bool hull_from_trifaces, const RunOptions& options)
+{
+    PhaseClock clock(result.stats);
+    const tetgenio& out = *result.out;
+    StreamedMesh* streamed = result.streamed.get();
+    const bool tets_streamed = streamed && streamed->tets.is_open();
+    const int* tets = tets_streamed ? streamed->tets.data<int>() : out.tetrahedronlist;
+    const int* neighbors = streamed && streamed->neighbors.is_open() ? streamed->neighbors.data<int>() : out.neighborlist;
+    if (hull_from_trifaces || neighbors) {
+        if (out.numberofcorners != 4)
+            throw std::runtime_error("tets must have shape (T,4)");
+        const bool have_markers = out.numberoftrifaces > 0 && out.trifacelist && out.trifacemarkerlist;
+        BoundaryFaces hull;
+        if (hull_from_trifaces) {
+            hull = hull_faces_from_trifaces(tets, out.numberoftetrahedra,
+                                            out.trifacelist, out.trifacemarkerlist,
+                                            out.trifacelist ? out.numberoftrifaces : 0);
+        } else {
+            hull = compute_boundary_face_tris(tets, neighbors, out.numberoftetrahedra, options.kernel_threads);
+            if (have_markers)
+                hull.markers = boundary_face_markers(
+                    hull.faces.data(), hull.faces.size() / 3,
+                    out.trifacelist, out.trifacemarkerlist, out.numberoftrifaces);
+        }
+        if (tets_streamed) {
+            const std::int64_t nf = static_cast<std::int64_t>(hull.tets.size());
+            streamed->boundary_faces = copy_to_npy(streamed->file("boundary_tri_faces"), hull.faces, {nf, 3});
+            streamed->boundary_tets = copy_to_npy(streamed->file("boundary_tri_tets"), hull.tets, {nf});
+            streamed->boundary_local_faces =
+                copy_to_npy(streamed->file("boundary_tri_local_faces"), hull.local_faces, {nf});
+            if (have_markers)
+                streamed->boundary_markers = copy_to_npy(streamed->file("boundary_tri_markers"), hull.markers, {nf});
+        } else {
+            result.boundary_faces = std::move(hull.faces);
+            result.boundary_tets = std::move(hull.tets);
+            result.boundary_local_faces = std::move(hull.local_faces);
+            if (have_markers) result.boundary_markers = std::move(hull.markers);
+        }
+        result.has_boundary_faces = true;
+        result.has_boundary_markers = have_markers;
+    }
+    clock.lap("boundary_faces");
+}
+
+MeshResult run_tetgen(const PlcInput& plc, const RunOptions& options)
+{
+    MeshResult result;
+    PhaseClock clock(result.stats);
+    validate_plc(plc);
+
+    const int N = plc.num_vertices;
+    const int M = plc.mesh_facets.count;
+    const int B = plc.boundary_facets.count;
+
+    result.out.reset(new tetgenio());
+    FacetArena arena;
+    tetgenio in;
+    BorrowGuard borrowed(in);
+
+    // Points: TetGen only reads the input list, so float64 coordinates are
+    // borrowed in place; float32 is widened once straight into the list.
+    in.firstnumber = 0; // 0-based indexing
+    in.numberofpoints = N;
+    if (plc.vertices) {
+        in.pointlist = const_cast<REAL*>(plc.vertices);
+        borrowed.pointlist = true;
+    } else {
+        in.pointlist = new REAL[3 * static_cast<std::size_t>(N)];
+        std::copy(plc.vertices_f32, plc.vertices_f32 + 3 * static_cast<std::size_t>(N), in.pointlist);
+    }
+
+    // Facets: mesh triangles + boundary polygons, packed into the arena
+    const int T = M + B;
+    std::int64_t copied = 0;
+    if (plc.mesh_facets.indices_i64) copied += plc.mesh_facets.num_indices;
+    if (plc.boundary_facets.indices_i64) copied += plc.boundary_facets.num_indices;
+    arena.reserve(T, copied);
+    in.numberoffacets = T;
+    in.facetlist = arena.facets.data();
+    borrowed.facetlist = true;
+    // Provide facet markers so output tri faces carry labels on boundary
+    in.facetmarkerlist = new int[in.numberoffacets];
+
+    // Mesh facets (marker = user marker + 1, or -1 when unmarked)
+    pack_facets(arena, 0, plc.mesh_facets);
+    for (int fi = 0; fi < M; ++fi)
+    {
+        int marker_value = -1;
+        if (plc.mesh_facet_markers) {
+            const int raw_marker = plc.mesh_facet_markers[fi];
+            marker_value = (raw_marker < 0) ? -1 : (raw_marker + 1);
+        }
+        in.facetmarkerlist[fi] = marker_value;
+    }
+
+    // Boundary polygons (marker -(m+2), m = 0..B-1 unless given)
+    pack_facets(arena, M, plc.boundary_facets);
+    for (int bi = 0; bi < B; ++bi)
+    {
+        const int m = plc.boundary_facet_markers ? plc.boundary_facet_markers[bi] : bi;
+        in.facetmarkerlist[M + bi] =  - (m + 2);
+    }
+
+    std::vector<char> sw = plc.switches;
+    if (sw.empty() || sw.back() != '\0') sw.push_back('\0');
+    const bool hull_from_trifaces = boundary_face_switches(sw, plc.compute_boundary_faces);
+    open_output_dir(result, options);
+    clock.lap("pack_input");
+
+    std::function<std::string(int)> dump;
+    if (options.dump_on_failure) dump = [&](int code) { return dump_plc(plc, code, options); };
+    run_packed(in, sw, result, options, plc.sizing,
+               "points=" + std::to_string(N) + ", mesh_facets=" + std::to_string(M) +
+                   ", boundary_polys=" + std::to_string(B),
+               dump);
+
+    if (plc.compute_boundary_faces) extract_boundary_faces(result, hull_from_trifaces, options);
+    return result;
+}
+
+MeshResult run_tetgen_refine(const RefineInput& mesh, const RunOptions& options)
+{
+    MeshResult result;
+    PhaseClock clock(result.stats);
+    validate_refine_input(mesh, options.kernel_threads);
+
+    result.out.reset(new tetgenio());
+    tetgenio in;
+    BorrowGuard borrowed(in);
+
+    // Every list is read in place. Constrained faces with marker 0 (the
+    // unconstrained interior faces of a -f output) are left out, which is
+    // the only case that copies.
+    in.firstnumber = 0;
+    in.numberofpoints = mesh.num_points;
+    in.pointlist = const_cast<REAL*>(mesh.points);
+    borrowed.pointlist = true;
+    in.numberoftetrahedra = mesh.num_tets;
+    in.numberofcorners = mesh.corners;
+    in.tetrahedronlist = const_cast<int*>(mesh.tets);
+    borrowed.tetrahedronlist = true;
+    if (mesh.tet_volumes) {
+        in.tetrahedronvolumelist = const_cast<REAL*>(mesh.tet_volumes);
+        borrowed.tetrahedronvolumelist = true;
+    }
+    if (mesh.tet_attributes && mesh.num_tet_attributes > 0) {
+        in.numberoftetrahedronattributes = mesh.num_tet_attributes;
+        in.tetrahedronattributelist = const_cast<REAL*>(mesh.tet_attributes);
+        borrowed.tetrahedronattributelist = true;
+    }
+    std::vector<int> kept_faces, kept_markers;
+    if (mesh.num_faces > 0) {
+        const std::size_t F = static_cast<std::size_t>(mesh.num_faces);
+        const bool interior = mesh.face_markers &&
+                              std::find(mesh.face_markers, mesh.face_markers + F, 0) != mesh.face_markers + F;
+        if (interior) {
+            for (std::size_t f = 0; f < F; ++f) {
+                if (mesh.face_markers[f] == 0) continue;
+                kept_faces.insert(kept_faces.end(), mesh.faces + 3 * f, mesh.faces + 3 * f + 3);
+                kept_markers.push_back(mesh.face_markers[f]);
+            }
+        }
+        in.numberoftrifaces = interior ? static_cast<int>(kept_markers.size()) : mesh.num_faces;
+        in.trifacelist = interior ? kept_faces.data() : const_cast<int*>(mesh.faces);
+        in.trifacemarkerlist = interior ? kept_markers.data() : const_cast<int*>(mesh.face_markers);
+        borrowed.trifacelist = true;
+    }
+
+    // -r, with -a (no value) when a volume list is given
+    std::vector<char> sw = mesh.switches;
+    if (sw.empty() || sw.back() != '\0') sw.push_back('\0');
+    add_switch(sw, 'r');
+    {
+        tetgenbehavior behavior;
+        std::vector<char> parsed = sw;
+        if (!behavior.parse_commandline(parsed.data())) throw std::runtime_error("refinement: invalid switches");
+        if (behavior.plc) throw std::runtime_error("refinement: -p cannot be combined with -r");
+        if (mesh.tet_volumes && !behavior.varvolume) sw.insert(sw.end() - 1, 'a');
+    }
+    const bool hull_from_trifaces = boundary_face_switches(sw, mesh.compute_boundary_faces);
+    open_output_dir(result, options);
+    clock.lap("pack_input");
+
+    run_packed(in, sw, result, options, mesh.sizing,
+               "points=" + std::to_string(mesh.num_points) + ", tets=" + std::to_string(mesh.num_tets) +
+                   ", faces=" + std::to_string(in.numberoftrifaces),
+               nullptr);
+
+    if (mesh.compute_boundary_faces) extract_boundary_faces(result, hull_from_trifaces, options);
+    return result;
+}
+
+std::vector<BatchItem> run_tetgen_batch(const std::vector<const PlcInput*>& plcs, int num_threads,
+                                        const RunOptions& options)
+{
+    std::vector<BatchItem> items(plcs.size());
+    if (plcs.empty()) return items;
+    if (!options.output_dir.empty()) throw std::runtime_error("output_dir is not supported for batches");
+
+    if (num_threads <= 0)
+        num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const std::size_t workers = std::min<std::size_t>(static_cast<std::size_t>(num_threads), plcs.size());
+
+    // Workers pull the next PLC index until the list is exhausted. With
+    // several workers busy, per-mesh kernels stay on their worker's thread.
+    const int kernel_threads = workers > 1 ? 1 : 0;
+    std::atomic<std::size_t> next{0};
+    auto work = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < plcs.size(); i = next.fetch_add(1)) {
+            try {
+                RunOptions item_options = options;
+                item_options.kernel_threads = kernel_threads;
+                item_options.item = static_cast<int>(i);
+                items[i].mesh = run_tetgen(*plcs[i], item_options);
+            } catch (...) {
+                items[i].error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t t = 1; t < workers; ++t) pool.emplace_back(work);
+    work();
+    for (auto& th : pool) th.join();
+    return items;
+}
+
+}  // namespace tetwrap
@@ -0,0 +1,565 @@
+// Pure C++ core of the TetGen wrapper.
+//
+// Nothing in this header (or tetwrap_core.cpp) touches the Python C API, so
+// everything here may run with the GIL released. The pybind11 layer in
+// tetwrap.cpp borrows NumPy buffers into a PlcInput, calls run_tetgen() and
+// wraps the resulting buffers as NumPy arrays afterwards.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tetgen.h"
+
+// Defined by CMake when the TetGen sources were patched for thread isolation.
+#ifndef TETWRAP_TETGEN_THREADSAFE
+#define TETWRAP_TETGEN_THREADSAFE 0
+#endif
+
+// Defined by CMake when TetGen's memorypool::alloc() calls tetwrap_alloc_hook.
+#ifndef TETWRAP_ALLOC_HOOK
+#define TETWRAP_ALLOC_HOOK 0
+#endif
+
+namespace tetwrap {
+
+class SizingField;
+
+// ===================== Input =====================
+// Borrowed list of polygons in CSR form: polygon i uses
+// indices[offsets[i] .. offsets[i+1]). Without offsets the list holds
+// triangles, i.e. an (count,3) index array. Set exactly one index pointer.
+struct FacetList {
+    const std::int32_t* indices = nullptr;
+    const std::int64_t* indices_i64 = nullptr;
+    const std::int64_t* offsets = nullptr;      // (count+1,) or nullptr
+    std::int64_t num_indices = 0;               // length of the index array
+    int count = 0;                              // number of polygons
+
+    std::int64_t begin(int i) const { return offsets ? offsets[i] : 3 * static_cast<std::int64_t>(i); }
+    std::int64_t end(int i) const { return offsets ? offsets[i + 1] : 3 * static_cast<std::int64_t>(i + 1); }
+};
+
+// Borrowed view of a PLC. All pointers reference caller-owned memory that
+// must stay alive (and unmodified) for the duration of run_tetgen().
+// Coordinates and indices are read in the caller's precision; set exactly
+// one vertex pointer.
+struct PlcInput {
+    const double* vertices = nullptr;           // (N,3) float64
+    const float* vertices_f32 = nullptr;        // (N,3) float32
+    int num_vertices = 0;
+    FacetList mesh_facets;                      // triangles or CSR polygons
+    const int* mesh_facet_markers = nullptr;    // (M,) or nullptr
+    FacetList boundary_facets;                  // CSR polygons, at least one
+    const int* boundary_facet_markers = nullptr; // (B,) >= 0, or nullptr for 0..B-1
+    std::vector<char> switches;                 // NUL-terminated TetGen switches
+    bool compute_boundary_faces = true;
+    const SizingField* sizing = nullptr;        // target edge lengths (adds -q), or nullptr
+};
+
+// ===================== Statistics =====================
+// Wall seconds per phase (in run order, skipped phases absent) and TetGen's
+// counters for one run. Names are string literals.
+struct RunStats {
+    std::vector<std::pair<const char*, double>> seconds;
+    std::vector<std::pair<const char*, long long>> counters;
+};
+
+// Records the wall time since the previous lap under a phase name
+class PhaseClock {
+public:
+    explicit PhaseClock(RunStats& stats) : stats_(stats), last_(std::chrono::steady_clock::now()) {}
+
+    void lap(const char* phase)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        stats_.seconds.emplace_back(phase, std::chrono::duration<double>(now - last_).count());
+        last_ = now;
+    }
+
+    // Restart without recording anything
+    void skip() { last_ = std::chrono::steady_clock::now(); }
+
+private:
+    RunStats& stats_;
+    std::chrono::steady_clock::time_point last_;
+};
+
+// ===================== Run control =====================
+// Abort codes thrown (as int, like TetGen's own errors) from inside a run.
+constexpr int kAbortCancelled = 101;
+constexpr int kAbortTimeBudget = 102;
+constexpr int kAbortMemoryBudget = 103;
+
+// Snapshot passed to progress callbacks.
+struct Progress {
+    const char* phase = "";                     // current phase (see RunStats)
+    long long tets = 0;                         // live tetrahedra
+    long long points = 0;                       // live points, incl. Steiner points
+    double elapsed_s = 0.0;                     // since TetGen started
+    int item = 0;                               // PLC index within a batch
+};
+
+// Optional observation / cancellation of runs. The progress callback runs
+// on the meshing thread, at most every `progress_interval_s` seconds plus
+// once at the start of each phase; it may throw to abort the run. The
+// cancel flag and the budgets are checked every 1024 TetGen pool
+// allocations (see TETWRAP_ALLOC_HOOK) and between phases. Budgets apply
+// to each run separately; <= 0 disables them.
+struct RunControl {
+    std::function<void(const Progress&)> progress;
+    double progress_interval_s = 0.5;
+    const std::atomic<bool>* cancel = nullptr;
+    double time_budget_s = 0.0;                 // TetGen wall time, lock wait excluded
+    long long memory_budget_bytes = 0;          // TetGen element pools + work arrays
+};
+
+// Per-run options that are not part of the PLC.
+struct RunOptions {
+    int kernel_threads = 0;                     // wrapper post-processing threads, <= 0: all
+    const RunControl* control = nullptr;
+    int item = 0;                               // reported in Progress::item
+    std::string output_dir;                     // non-empty: stream the large arrays here (see StreamedMesh)
+    bool dump_on_failure = true;                // write a PlcBundle when TetGen fails
+    std::string dump_dir;                       // where; empty: $TETWRAP_DUMP_DIR, else the temp directory
+};
+
+// Raised by run_tetgen() when a run was stopped through its RunControl.
+class RunAborted : public std::runtime_error {
+public:
+    RunAborted(int code_, const std::string& what) : std::runtime_error(what), code(code_) {}
+    int code;
+};
+
+// ===================== Output =====================
+// A freshly created .npy file (format 1.0, C order, native-endian dtype),
+// mapped read-write. The file stays on disk; the mapping is released with
+// the object. Empty arrays are written but not mapped (data() is null).
+class NpyFile {
+public:
+    NpyFile() = default;
+    NpyFile(const std::string& path, char kind, std::size_t itemsize, std::vector<std::int64_t> shape);
+    NpyFile(NpyFile&& other) noexcept;
+    NpyFile& operator=(NpyFile&& other) noexcept;
+    NpyFile(const NpyFile&) = delete;
+    NpyFile& operator=(const NpyFile&) = delete;
+    ~NpyFile();
+
+    template <typename T>
+    static NpyFile create(const std::string& path, std::vector<std::int64_t> shape);
+
+    template <typename T>
+    T* data() const { return static_cast<T*>(data_); }
+    bool is_open() const { return !path_.empty(); }
+    const std::string& path() const { return path_; }
+    const std::vector<std::int64_t>& shape() const { return shape_; }
+
+private:
+    void release() noexcept;
+
+    std::string path_;
+    std::vector<std::int64_t> shape_;
+    void* map_ = nullptr;
+    std::size_t map_bytes_ = 0;
+    void* data_ = nullptr;
+};
+
+template <>
+inline NpyFile NpyFile::create<double>(const std::string& path, std::vector<std::int64_t> shape)
+{
+    return NpyFile(path, 'f', sizeof(double), std::move(shape));
+}
+
+template <>
+inline NpyFile NpyFile::create<int>(const std::string& path, std::vector<std::int64_t> shape)
+{
+    return NpyFile(path, 'i', sizeof(int), std::move(shape));
+}
+
+// Output arrays written straight into memory-mapped .npy files in `dir`
+// (RunOptions::output_dir) instead of tetgenio lists, so they live in the
+// page cache rather than next to TetGen's pools on the heap. Files are
+// named after the TetwrapIO fields: points, point_markers (when TetGen
+// writes them), tets, neighbors (-n), tet_attr (-A) and the boundary_tri_*
+// arrays. Linear tets only.
+struct StreamedMesh {
+    std::string dir;
+    NpyFile points;                             // (N,3) float64
+    NpyFile point_markers;                      // (N,) int32
+    NpyFile tets;                               // (K,4) int32
+    NpyFile neighbors;                          // (K,4) int32
+    NpyFile tet_attr;                           // (K,A) float64
+    NpyFile boundary_faces;                     // (BF,3) int32
+    NpyFile boundary_markers;                   // (BF,) int32
+    NpyFile boundary_tets;                      // (BF,) int32
+    NpyFile boundary_local_faces;               // (BF,) int32
+
+    std::string file(const char* name) const { return dir + "/" + name + ".npy"; }
+};
+
+// Result of one TetGen run. `out` still owns TetGen's buffers; the binding
+// layer moves them into NumPy arrays without copying.
+struct MeshResult {
+    std::unique_ptr<tetgenio> out;
+    bool has_boundary_faces = false;
+    std::vector<int> boundary_faces;            // (BF,3) flattened
+    std::vector<int> boundary_tets;             // (BF,) owning tet
+    std::vector<int> boundary_local_faces;      // (BF,) face id 0..3 (opposite vertex)
+    bool has_boundary_markers = false;
+    std::vector<int> boundary_markers;          // (BF,)
+    std::unique_ptr<StreamedMesh> streamed;     // set with RunOptions::output_dir
+    RunStats stats;
+};
+
+// Throws std::runtime_error on shape/index problems.
+void validate_plc(const PlcInput& plc);
+
+// Whether the NUL-terminated switch buffer contains `flag`.
+bool has_switch(const std::vector<char>& sw, char flag);
+
+// Append `flag` to the switch buffer unless it is already present.
+void add_switch(std::vector<char>& sw, char flag);
+
+// Validate, pack into tetgenio, run TetGen and post-process boundary faces.
+// Throws RunAborted when cancelled, std::runtime_error on other failures.
+MeshResult run_tetgen(const PlcInput& plc, const RunOptions& options = RunOptions());
+
+// TetGen's tetrahedralize() for an already parsed behavior, run phase by
+// phase so every phase is timed and the mesh counters are collected into
+// `stats`. Throws TetGen's int error codes like tetrahedralize(), and the
+// kAbort* codes when `options.control` stops the run. With `streamed`,
+// points, point markers, tets, neighbors and tet attributes are written into its files
+// instead of `out` (which still receives the counts and all other lists).
+void tetrahedralize_phased(tetgenbehavior& b, tetgenio* in, tetgenio* out, RunStats& stats,
+                           const RunOptions& options = RunOptions(), StreamedMesh* streamed = nullptr);
+
+// ===================== Refinement =====================
+// Borrowed arrays of a finished mesh to rebuild and refine with -r, read in
+// place by TetGen. `faces` are the constrained faces (TetGen's default tri
+// face output) with their raw markers; faces marked 0 (the interior faces
+// of a -f output) are skipped. `tet_volumes` holds a maximum volume per tet
+// (<= 0: unconstrained) and turns on -a.
+struct RefineInput {
+    const double* points = nullptr;             // (N,3)
+    int num_points = 0;
+    const int* tets = nullptr;                  // (K,corners)
+    int num_tets = 0;
+    int corners = 4;                            // 4 or 10
+    const int* faces = nullptr;                 // (F,3) or nullptr
+    const int* face_markers = nullptr;          // (F,) or nullptr
+    int num_faces = 0;
+    const double* tet_volumes = nullptr;        // (K,) or nullptr
+    const double* tet_attributes = nullptr;     // (K,A) or nullptr
+    int num_tet_attributes = 0;
+    std::vector<char> switches;                 // NUL-terminated; -r is added, -p is rejected
+    bool compute_boundary_faces = true;
+    const SizingField* sizing = nullptr;        // as in PlcInput
+};
+
+// Rebuild `mesh` in TetGen and refine it according to the switches (-q,
+// -a, ...). Output and errors as in run_tetgen(), without a repro bundle.
+MeshResult run_tetgen_refine(const RefineInput& mesh, const RunOptions& options = RunOptions());
+
+// ===================== Sizing =====================
+// Built-in target edge length kernels for TetGen's quality refinement. Each
+// kernel gives a size at a point, infinity where it does not apply, and the
+// field is their minimum. A tet is split while its longest edge exceeds the
+// field at its centroid.
+struct SizingKernel {
+    enum Kind { kHeight, kDistance, kBox, kSphere, kGrid };
+    Kind kind = kHeight;
+    double size = 0.0;                          // at the ground / the surface / inside the zone
+    double growth = 0.0;                        // kHeight, kDistance: increase per unit height / distance
+    double max_size = std::numeric_limits<double>::infinity(); // kHeight, kDistance (finite for kDistance)
+    double ground_z = 0.0;                      // kHeight
+    double lo[3] = {0.0, 0.0, 0.0};             // kBox
+    double hi[3] = {0.0, 0.0, 0.0};
+    double center[3] = {0.0, 0.0, 0.0};         // kSphere
+    double radius = 0.0;
+    const double* surface_points = nullptr;     // kDistance: (P,3), read by the SizingField constructor only
+    int num_surface_points = 0;
+    const int* surface_triangles = nullptr;     // kDistance: (S,3)
+    int num_surface_triangles = 0;
+    double grid_origin[3] = {0.0, 0.0, 0.0};    // kGrid: node (i,j,k) at origin + (i,j,k) * spacing
+    double grid_spacing[3] = {0.0, 0.0, 0.0};
+    std::int64_t grid_shape[3] = {0, 0, 0};     // (nx,ny,nz)
+    const double* grid_values = nullptr;        // kGrid: (nx,ny,nz) C order, borrowed; set one pointer
+    const float* grid_values_f32 = nullptr;
+};
+
+// A validated set of kernels. kDistance kernels copy their triangles into a
+// uniform grid with cells no smaller than the distance at which the size
+// reaches max_size, so a query visits at most 27 cells (3 per axis). kGrid kernels are
+// interpolated trilinearly (clamped to the grid) from their values, which
+// are read in place and must outlive the field.
+class SizingField {
+public:
+    explicit SizingField(std::vector<SizingKernel> kernels);
+    ~SizingField();
+    SizingField(const SizingField&) = delete;
+    SizingField& operator=(const SizingField&) = delete;
+
+    double size_at(const double* p) const;
+    bool tet_too_large(const double* a, const double* b, const double* c, const double* d) const;
+
+private:
+    struct SurfaceGrid;
+    std::vector<SizingKernel> kernels_;
+    std::vector<std::unique_ptr<SurfaceGrid>> grids_; // per kernel, null unless kDistance
+};
+
+// Routes TetGen's tetunsuitable hook of `in` to `field` for runs on the
+// calling thread while in scope (the hook takes no user pointer). A null
+// field leaves `in` untouched.
+class SizingHook {
+public:
+    SizingHook(tetgenio& in, const SizingField* field);
+    ~SizingHook();
+    SizingHook(const SizingHook&) = delete;
+    SizingHook& operator=(const SizingHook&) = delete;
+
+private:
+    const SizingField* previous_;
+};
+
+// Outcome of one PLC in a batch: a mesh, or the exception its run raised.
+struct BatchItem {
+    MeshResult mesh;
+    std::exception_ptr error;
+};
+
+// Mesh every PLC on a pool of `num_threads` worker threads (<= 0 means one
+// per hardware thread). Results keep the input order. Every run uses
+// `options` (its control is shared; progress reports carry the PLC index);
+// kernel_threads and item are set per run, output_dir is not supported.
+std::vector<BatchItem> run_tetgen_batch(const std::vector<const PlcInput*>& plcs, int num_threads,
+                                        const RunOptions& options = RunOptions());
+
+// ===================== Tiled meshing =====================
+// Split a large box-shaped domain into tiles_x * tiles_y XY tiles, mesh the
+// tiles on a thread pool and stitch them into one mesh. The PLC must have a
+// flat top polygon at the highest z, side polygons in the four vertical
+// planes of its bounding box, and surface facets (the other mesh facets and
+// boundary polygons: terrain with building footprints cut out, buildings)
+// forming a closed 2.5D height field over the footprint. The cuts are moved
+// off the even split into gaps between vertex coordinates; surface facets
+// crossing one are clipped and must be convex. Sides and top are rebuilt
+// per tile with their markers, and every tile wall and top is triangulated
+// at `spacing`. TetGen keeps all tile boundaries as given (-Y), so the
+// surface facets should already have the target resolution.
+struct TileOptions {
+    int tiles_x = 2;
+    int tiles_y = 2;
+    double spacing = 0.0;                       // wall / top edge length, <= 0: median surface edge
+    int num_threads = 0;                        // concurrent tiles, <= 0: one per hardware thread
+};
+
+// Returns the merged mesh like run_tetgen() does: the input points in order
+// (without those only on the side and top polygons), then the generated
+// cut / wall / top points and each tile's Steiner points;
+// boundary faces without the interfaces; neighbors (-n) stitched across
+// tiles. Progress reports carry the tile index. -r, -e, -o2 and
+// RunOptions::output_dir are not supported.
+MeshResult run_tetgen_tiled(const PlcInput& plc, const TileOptions& tiles,
+                            const RunOptions& options = RunOptions());
+
+// ===================== Incremental remeshing =====================
+// Borrowed arrays of an existing linear tet mesh with its hull faces (as
+// returned by run_tetgen() with compute_boundary_faces). Boundary markers
+// are TetGen's raw values (MeshResult::boundary_markers).
+struct TetMesh {
+    const double* points = nullptr;             // (N,3)
+    int num_points = 0;
+    const int* tets = nullptr;                  // (K,4)
+    int num_tets = 0;
+    const int* neighbors = nullptr;             // (K,4) or nullptr
+    const int* boundary_faces = nullptr;        // (BF,3)
+    const int* boundary_tets = nullptr;         // (BF,)
+    const int* boundary_local_faces = nullptr;  // (BF,)
+    const int* boundary_markers = nullptr;      // (BF,) or nullptr
+    int num_boundary_faces = 0;
+};
+
+// The spliced mesh plus where the old points and tets went (-1: removed).
+struct RemeshResult {
+    MeshResult mesh;
+    std::vector<int> point_map;                 // (N,) old point -> new point
+    std::vector<int> tet_map;                   // (K,) old tet -> new tet
+};
+
+// Replace the tets whose bounding boxes meet [box_min, box_max] by a new
+// local mesh. The cavity's surface is kept, except that `patch` (facets
+// and boundary polygons as in run_tetgen(), either list may be empty)
+// replaces the parts of the domain boundary it encloses: the edges used by
+// one patch facet only form its rim, which must run along boundary edges
+// of the cavity (rim vertices match mesh points by exact coordinates), and
+// the boundary faces cut off by the rim inside the cavity are dropped. The
+// cavity is meshed on its own with the patch's switches (plus -pYJ, and -n
+// with neighbors), so its interface with the kept tets is not split, and
+// spliced back: kept tets in order, then the new tets; kept points in
+// order, then new points. Boundary faces (with compute_boundary_faces) and
+// neighbors are updated; other TetGen lists are not carried over. Throws
+// std::runtime_error when the patch does not fit the cavity or the new
+// mesh does not conform to the kept tets.
+RemeshResult run_tetgen_remesh(const TetMesh& mesh, const double box_min[3], const double box_max[3],
+                               const PlcInput& patch, const RunOptions& options = RunOptions());
+
+// Hull faces of a tet mesh, ordered by (tet, local face).
+struct BoundaryFaces {
+    std::vector<int> faces;                     // (B,3) flattened, indices into points
+    std::vector<int> tets;                      // (B,) owning tet
+    std::vector<int> local_faces;               // (B,) face id 0..3, the opposite corner
+    std::vector<int> markers;                   // (B,) when known, else empty
+};
+
+// (T,4) tets, (T,4) neighbors -> boundary faces. Parallel count / scan / fill
+// over `num_threads` threads (<= 0 means one per hardware thread).
+BoundaryFaces compute_boundary_face_tris(const int* tets, const int* nbrs, int num_tets, int num_threads = 0);
+
+// Boundary faces without a neighbor list: the hull faces among TetGen's
+// (F,3) tri faces (subfaces by default, all faces with -f), found with one
+// hashed pass over the (T,4) tets. Markers are filled when `trimarkers` is set.
+BoundaryFaces hull_faces_from_trifaces(const int* tets, int num_tets,
+                                       const int* trifaces, const int* trimarkers, int num_trifaces);
+
+// Marker of every boundary face, looked up from TetGen's (F,3) tri faces and
+// (F,) markers through a hash table; faces without a tri face get 0.
+std::vector<int> boundary_face_markers(const int* boundary_faces, std::size_t num_boundary_faces,
+                                       const int* trifaces, const int* trimarkers, int num_trifaces);
+
+// ===================== Repro bundles =====================
+// A PLC with its switches in one binary file, written by run_tetgen() when
+// TetGen fails (see RunOptions::dump_dir) so the failure can be replayed.
+// Vertices are stored as float64 and indices as int32, whatever the input
+// precision; TetGen sees the same values either way.
+struct PlcBundle {
+    std::vector<double> vertices;               // (N,3)
+    std::vector<std::int64_t> mesh_offsets;     // (M+1,), empty for (M,3) triangles
+    std::vector<int> mesh_indices;
+    std::vector<int> mesh_markers;              // (M,) or empty
+    std::vector<std::int64_t> boundary_offsets; // (B+1,)
+    std::vector<int> boundary_indices;
+    std::vector<int> boundary_markers;          // (B,) or empty
+    std::string switches;
+    bool compute_boundary_faces = true;
+    int error_code = 0;                         // TetGen's code for the failed run
+    std::string tetgen_version;                 // of the build that wrote the bundle
+
+    // Borrowing view for run_tetgen(); valid while the bundle lives
+    PlcInput view() const;
+};
+
+// Version of the TetGen sources the core was built from, "unknown" when
+// CMake could not read it.
+const char* tetgen_version();
+
+// Write `plc` to `path` in one buffered write; throws std::runtime_error.
+void write_plc_bundle(const std::string& path, const PlcInput& plc, int error_code = 0);
+PlcBundle read_plc_bundle(const std::string& path);
+
+// ===================== Mesh writers =====================
+// Borrowed arrays of a finished mesh. Faces (and their markers) are optional.
+struct MeshView {
+    const double* points = nullptr;             // (N,3)
+    std::int64_t num_points = 0;
+    const int* tets = nullptr;                  // (K,4)
+    std::int64_t num_tets = 0;
+    const int* faces = nullptr;                 // (F,3) boundary faces
+    const int* face_markers = nullptr;          // (F,)
+    std::int64_t num_faces = 0;
+};
+
+struct WriteOptions {
+    bool compress = false;                      // zlib blocks (VTU only, needs TETWRAP_HAVE_ZLIB)
+    int num_threads = 0;                        // compression threads, <= 0: all
+    int marker_fill = -1;                       // "marker" cell value of tets when faces have markers
+};
+
+// VTU (VTK XML unstructured grid) with all data in one appended raw binary
+// section: tets and boundary triangles as one mixed cell list, and a
+// "marker" cell array when face markers are given. Throws
+// std::runtime_error on I/O errors.
+void write_vtu(const std::string& path, const MeshView& mesh, const WriteOptions& options = WriteOptions());
+
+// XDMF 3 description plus a raw binary file in host byte order (`path` with its
+// extension replaced by .bin): a tet grid and a boundary triangle grid that
+// share the points, with face markers as a cell attribute.
+void write_xdmf(const std::string& path, const MeshView& mesh, const WriteOptions& options = WriteOptions());
+
+// ===================== TetGen files =====================
+// Contents of TetGen's .node/.ele/.face/.neigh/.smesh files as flat
+// row-major arrays, 0-based. Readers take `first_index`, the number of the
+// first node (TetGen's firstnumber; -1: the first record number of the file
+// itself), and rebase every index by it; writers number records from
+// `first_index`. Record bodies are split at line boundaries and parsed /
+// formatted on `num_threads` threads (<= 0: all). Errors throw
+// std::runtime_error naming the file and record.
+struct TetgenNodes {
+    std::int64_t count = 0;
+    int num_attributes = 0;
+    int first_index = 0;                        // as found in the file
+    std::vector<double> points;                 // (count,3)
+    std::vector<double> attributes;             // (count,num_attributes)
+    std::vector<int> markers;                   // (count,) or empty
+};
+
+struct TetgenElements {
+    std::int64_t count = 0;
+    int corners = 4;                            // 4 or 10
+    int num_attributes = 0;
+    std::vector<int> tets;                      // (count,corners)
+    std::vector<double> attributes;             // (count,num_attributes)
+};
+
+struct TetgenFaces {
+    std::int64_t count = 0;
+    std::vector<int> faces;                     // (count,3)
+    std::vector<int> markers;                   // (count,) or empty
+};
+
+// .smesh or .poly (by extension): facets in CSR form; `nodes` is empty when
+// the file refers to a separate .node file. Regions are (x, y, z, attribute,
+// max volume) rows. .poly facets must be one polygon without holes.
+struct TetgenSmesh {
+    TetgenNodes nodes;
+    std::vector<std::int64_t> facet_offsets{0}; // (facets+1,)
+    std::vector<int> facet_indices;
+    std::vector<int> facet_markers;             // (facets,) or empty
+    std::vector<double> holes;                  // (holes,3)
+    std::vector<double> regions;                // (regions,5)
+};
+
+TetgenNodes read_tetgen_node(const std::string& path, int num_threads = 0);
+TetgenElements read_tetgen_ele(const std::string& path, int first_index = -1, int num_threads = 0);
+TetgenFaces read_tetgen_face(const std::string& path, int first_index = -1, int num_threads = 0);
+// (count,4) element neighbors; -1 (no neighbor) is kept as -1
+std::vector<int> read_tetgen_neigh(const std::string& path, int first_index = -1, int num_threads = 0);
+TetgenSmesh read_tetgen_smesh(const std::string& path, int first_index = -1);
+
+// Writers take borrowed row-major arrays; optional ones may be null.
+void write_tetgen_node(const std::string& path, const double* points, std::int64_t count,
+                       const double* attributes, int num_attributes, const int* markers,
+                       int first_index = 0, int num_threads = 0);
+void write_tetgen_ele(const std::string& path, const int* tets, std::int64_t count, int corners,
+                      const double* attributes, int num_attributes, int first_index = 0, int num_threads = 0);
+void write_tetgen_face(const std::string& path, const int* faces, std::int64_t count, const int* markers,
+                       int first_index = 0, int num_threads = 0);
+void write_tetgen_neigh(const std::string& path, const int* neighbors, std::int64_t count,
+                        int first_index = 0, int num_threads = 0);
+// Facets inline, nodes in a separate .node file; a .poly path writes each
+// facet as one polygon
+void write_tetgen_smesh(const std::string& path, const std::int64_t* facet_offsets, const int* facet_indices,
+                        std::int64_t num_facets, const int* facet_markers, const double* holes,
+                        std::int64_t num_holes, int first_index = 0);
+
+}  // namespace tetwrap
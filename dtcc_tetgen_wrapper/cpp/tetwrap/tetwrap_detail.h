@@ -0,0 +1,243 @@
+// Internal helpers shared by the tetwrap_core translation units: a chunked
+// thread pool, a face hash table and buffered / mapped file access. Not
+// part of the API.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tetwrap {
+namespace detail {
+
+// Run fn(chunk, begin, end) over [0, n) split into at most `num_threads`
+// contiguous chunks of at least `min_chunk` items. Chunk 0 runs on the
+// calling thread. Returns the number of chunks.
+template <typename Fn>
+std::size_t parallel_chunks(std::size_t n, std::size_t min_chunk, int num_threads, Fn&& fn)
+{
+    if (num_threads <= 0)
+        num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(num_threads, n / min_chunk));
+    const std::size_t step = (n + chunks - 1) / chunks;
+
+    std::vector<std::thread> pool;
+    std::vector<std::exception_ptr> errors(chunks);
+    pool.reserve(chunks - 1);
+    auto run = [&](std::size_t c) {
+        try {
+            fn(c, std::min(n, c * step), std::min(n, (c + 1) * step));
+        } catch (...) {
+            errors[c] = std::current_exception();
+        }
+    };
+    for (std::size_t c = 1; c < chunks; ++c) pool.emplace_back(run, c);
+    run(0);
+    for (auto& th : pool) th.join();
+    for (auto& e : errors)
+        if (e) std::rethrow_exception(e);
+    return chunks;
+}
+
+// local face patterns: face opposite vertex k
+constexpr int faces_of_tet[4][3] = {
+    {1,2,3},  // opposite 0
+    {0,3,2},  // opposite 1
+    {0,1,3},  // opposite 2
+    {0,2,1}   // opposite 3
+};
+
+// Open-addressing table from a sorted vertex triple to a boundary face
+// index. Sized for a load factor of at most 1/2 and filled once, so linear
+// probing stays short and there is no per-entry allocation.
+class FaceTable {
+public:
+    explicit FaceTable(std::size_t n)
+    {
+        std::size_t cap = 16;
+        while (cap < 2 * n) cap <<= 1;
+        keys_.resize(cap);
+        values_.assign(cap, -1);
+        mask_ = cap - 1;
+    }
+
+    void insert(const std::array<int, 3>& key, int value)
+    {
+        std::size_t slot = hash(key) & mask_;
+        while (values_[slot] >= 0 && keys_[slot] != key) slot = (slot + 1) & mask_;
+        keys_[slot] = key;
+        values_[slot] = value;
+    }
+
+    int find(const std::array<int, 3>& key) const
+    {
+        for (std::size_t slot = hash(key) & mask_; values_[slot] >= 0; slot = (slot + 1) & mask_) {
+            if (keys_[slot] == key) return values_[slot];
+        }
+        return -1;
+    }
+
+private:
+    static std::size_t hash(const std::array<int, 3>& key)
+    {
+        std::uint64_t h = static_cast<std::uint32_t>(key[0]);
+        h = h * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint32_t>(key[1]);
+        h = h * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint32_t>(key[2]);
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ull;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+    std::vector<std::array<int, 3>> keys_;
+    std::vector<int> values_;
+    std::size_t mask_ = 0;
+};
+
+inline std::array<int, 3> sorted_face(const int* f)
+{
+    std::array<int, 3> key = {f[0], f[1], f[2]};
+    std::sort(key.begin(), key.end());
+    return key;
+}
+
+// Buffered binary output file with 64-bit positioning; throws on failure
+class OutFile {
+public:
+    explicit OutFile(const std::string& path, std::size_t buffer_bytes = std::size_t(8) << 20)
+        : path_(path), buffer_(buffer_bytes)
+    {
+        f_ = std::fopen(path.c_str(), "wb");
+        if (!f_) fail("open");
+        std::setvbuf(f_, buffer_.data(), _IOFBF, buffer_.size());
+    }
+    OutFile(const OutFile&) = delete;
+    OutFile& operator=(const OutFile&) = delete;
+    ~OutFile()
+    {
+        if (f_) std::fclose(f_);
+    }
+
+    void write(const void* data, std::size_t bytes)
+    {
+        if (bytes > 0 && std::fwrite(data, 1, bytes, f_) != bytes) fail("write to");
+    }
+    void write(const std::string& s) { write(s.data(), s.size()); }
+
+    std::int64_t tell()
+    {
+#if defined(_WIN32)
+        const std::int64_t pos = _ftelli64(f_);
+#else
+        const std::int64_t pos = ftello(f_);
+#endif
+        if (pos < 0) fail("tell in");
+        return pos;
+    }
+
+    void seek(std::int64_t pos)
+    {
+#if defined(_WIN32)
+        const int rc = _fseeki64(f_, pos, SEEK_SET);
+#else
+        const int rc = fseeko(f_, static_cast<off_t>(pos), SEEK_SET);
+#endif
+        if (rc != 0) fail("seek in");
+    }
+
+    void close()
+    {
+        std::FILE* f = f_;
+        f_ = nullptr;
+        if (std::fclose(f) != 0) fail("close");
+    }
+
+private:
+    [[noreturn]] void fail(const char* what) const
+    {
+        throw std::runtime_error(std::string("cannot ") + what + " " + path_ + ": " + std::strerror(errno));
+    }
+
+    std::string path_;
+    std::vector<char> buffer_;
+    std::FILE* f_ = nullptr;
+};
+
+// Whole file, read-only: mapped on POSIX, read into memory elsewhere
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path)
+    {
+#if defined(_WIN32)
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) fail("open", path);
+        char chunk[1 << 16];
+        for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), f)) > 0;) copy_.insert(copy_.end(), chunk, chunk + n);
+        const bool bad = std::ferror(f) != 0;
+        std::fclose(f);
+        if (bad) fail("read", path);
+        data_ = copy_.data();
+        size_ = copy_.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) fail("open", path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            fail("stat", path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd);
+                fail("map", path);
+            }
+            ::madvise(map, size_, MADV_SEQUENTIAL);
+            map_ = map;
+            data_ = static_cast<const char*>(map);
+        }
+        ::close(fd);
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile()
+    {
+#if !defined(_WIN32)
+        if (map_) ::munmap(map_, size_);
+#endif
+    }
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+
+private:
+    [[noreturn]] static void fail(const char* what, const std::string& path)
+    {
+        throw std::runtime_error(std::string("cannot ") + what + " " + path + ": " + std::strerror(errno));
+    }
+
+    const char* data_ = "";
+    std::size_t size_ = 0;
+    void* map_ = nullptr;
+    std::vector<char> copy_;
+};
+
+}  // namespace detail
+}  // namespace tetwrap
@@ -0,0 +1,380 @@
+// Phased TetGen driver.
+//
+// Mirrors tetrahedralize(tetgenbehavior*, ...) of TetGen 1.6.0 (the version
+// pinned by vendor_tetgen.sh) step by step, so the wrapper can time every
+// phase and read TetGen's counters before the mesh object is destroyed.
+// Keep the call sequence in sync when the vendored TetGen is updated.
+#include "tetwrap_core.h"
+
+namespace tetwrap {
+
+namespace {
+
+template <typename Pool>
+long long pool_bytes(const Pool* pool)
+{
+    return pool ? static_cast<long long>(pool->maxitems) * pool->itembytes : 0;
+}
+
+// High-water marks of TetGen's element pools plus its working arrays
+long long mesh_bytes(const tetgenmesh& m)
+{
+    return pool_bytes(m.tetrahedrons) + pool_bytes(m.subfaces) + pool_bytes(m.subsegs) +
+           pool_bytes(m.points) + pool_bytes(m.tet2subpool) + pool_bytes(m.tet2segpool) +
+           static_cast<long long>(m.totalworkmemory);
+}
+
+void collect_counters(const tetgenmesh& m, const tetgenio& in, RunStats& stats)
+{
+    auto& c = stats.counters;
+    const long long points = m.points ? m.points->items : 0;
+    c.emplace_back("input_points", in.numberofpoints);
+    c.emplace_back("steiner_points", points > in.numberofpoints ? points - in.numberofpoints : 0);
+    c.emplace_back("steiner_segment", m.st_segref_count);
+    c.emplace_back("steiner_facet", m.st_facref_count);
+    c.emplace_back("steiner_volume", m.st_volref_count);
+    c.emplace_back("tetrahedra", m.tetrahedrons ? m.tetrahedrons->items : 0);
+    c.emplace_back("subfaces", m.subfaces ? m.subfaces->items : 0);
+    c.emplace_back("subsegments", m.subsegs ? m.subsegs->items : 0);
+
+    const long long flips = m.flip14count + m.flip26count + m.flipn2ncount + m.flip23count +
+                            m.flip32count + m.flip44count + m.flip41count + m.flip31count + m.flip22count;
+    c.emplace_back("flips", flips);
+    c.emplace_back("flip23", m.flip23count);
+    c.emplace_back("flip32", m.flip32count);
+    c.emplace_back("flip44", m.flip44count);
+    c.emplace_back("point_locations", m.ptloc_count);
+    c.emplace_back("orient3d_calls", m.orient3dcount);
+    c.emplace_back("insphere_calls", m.inspherecount);
+    c.emplace_back("insphere_sos_calls", m.insphere_sos_count);
+    c.emplace_back("peak_pool_bytes", mesh_bytes(m));
+}
+
+// Streamed counterparts of TetGen's outnodes / outelements / outneighbors:
+// the same traversal order and numbering (0-based, run_tetgen() sets
+// firstnumber 0), written into mapped files. outnodes' point numbering and
+// outelements' element numbering are stored in the mesh exactly as TetGen
+// does, for the face, edge and neighbor output that follows.
+
+// outnodes' point marker: the input marker for input points, the marker of
+// the facet or segment a Steiner point lies on, 0 otherwise
+int point_marker(tetgenmesh& m, tetgenmesh::point p, long long index)
+{
+    if (index < m.in->numberofpoints) return m.in->pointmarkerlist[index];
+    const auto type = m.pointtype(p);
+    if (type == tetgenmesh::FREESEGVERTEX || type == tetgenmesh::FREEFACETVERTEX) {
+        tetgenmesh::face parent;
+        m.sdecode(m.point2sh(p), parent);
+        if (parent.sh) return m.shellmark(parent);
+    }
+    return 0;
+}
+
+void stream_nodes(tetgenmesh& m, tetgenio* out, StreamedMesh& s)
+{
+    const long long n = m.points->items;
+    // outnodes writes markers under the same condition
+    const bool markers = !m.b->nobound && m.in->pointmarkerlist;
+    s.points = NpyFile::create<double>(s.file("points"), {n, 3});
+    if (markers) s.point_markers = NpyFile::create<int>(s.file("point_markers"), {n});
+    double* xyz = s.points.data<double>();
+    int* pm = s.point_markers.data<int>();
+    long long index = 0;
+    m.points->traversalinit();
+    for (tetgenmesh::point p = m.pointtraverse(); p; p = m.pointtraverse(), ++index) {
+        if (index == n) throw std::runtime_error("streamed output: point count changed during output");
+        xyz[3 * index + 0] = p[0];
+        xyz[3 * index + 1] = p[1];
+        xyz[3 * index + 2] = p[2];
+        if (markers) pm[index] = point_marker(m, p, index);
+        m.setpointmark(p, static_cast<int>(index));
+    }
+    out->numberofpoints = static_cast<int>(index);
+}
+
+void stream_elements(tetgenmesh& m, tetgenio* out, StreamedMesh& s)
+{
+    const long long k = m.tetrahedrons->items - m.hullsize;
+    const int na = m.numelemattrib;
+    s.tets = NpyFile::create<int>(s.file("tets"), {k, 4});
+    if (na > 0) s.tet_attr = NpyFile::create<double>(s.file("tet_attr"), {k, na});
+    int* tl = s.tets.data<int>();
+    double* al = s.tet_attr.data<double>();
+    long long e = 0;
+    m.tetrahedrons->traversalinit();
+    for (tetgenmesh::tetrahedron* t = m.tetrahedrontraverse(); t; t = m.tetrahedrontraverse(), ++e) {
+        if (e == k) throw std::runtime_error("streamed output: tet count changed during output");
+        for (int c = 0; c < 4; ++c) tl[4 * e + c] = m.pointmark(reinterpret_cast<tetgenmesh::point>(t[4 + c]));
+        for (int a = 0; a < na; ++a) al[na * e + a] = m.elemattribute(t, a);
+        m.setelemindex(t, static_cast<int>(e));
+    }
+    out->numberoftetrahedra = static_cast<int>(e);
+    out->numberofcorners = 4;
+    out->numberoftetrahedronattributes = na;
+}
+
+// Neighbor i is across the face opposite vertex i, -1 on the hull
+void stream_neighbors(tetgenmesh& m, StreamedMesh& s)
+{
+    const long long k = m.tetrahedrons->items - m.hullsize;
+    s.neighbors = NpyFile::create<int>(s.file("neighbors"), {k, 4});
+    int* nl = s.neighbors.data<int>();
+    tetgenmesh::triface tet, adjacent;
+    m.tetrahedrons->traversalinit();
+    for (tet.tet = m.tetrahedrontraverse(); tet.tet; tet.tet = m.tetrahedrontraverse()) {
+        for (tet.ver = 0; tet.ver < 4; ++tet.ver) {
+            m.fsym(tet, adjacent);
+            *nl++ = m.ishulltet(adjacent) ? -1 : m.elemindex(adjacent.tet);
+        }
+    }
+}
+
+// Watches one run: times the phases, polls the cancel flag and the budgets
+// and throttles progress reports. Between phases it is driven by phase(); inside them by
+// the memorypool::alloc() hook, when the vendored TetGen carries it.
+class RunMonitor {
+public:
+    RunMonitor(const RunOptions& options, RunStats& stats)
+        : control_(options.control), item_(options.item), clock_(stats),
+          start_(std::chrono::steady_clock::now()), last_report_(start_)
+    {
+    }
+
+    void attach(const tetgenmesh* mesh) { mesh_ = mesh; }
+
+    // Time `fn` as `phase`, with a check and a progress report up front
+    template <typename Fn>
+    void phase(const char* name, Fn&& fn)
+    {
+        phase_ = name;
+        poll(true);
+        fn();
+        clock_.lap(name);
+    }
+
+    void skip() { clock_.skip(); }
+
+    // Called on every pool allocation; only every 1024th one looks at the
+    // flag, the clock and the pools.
+    void tick()
+    {
+        if ((++ticks_ & 1023u) == 0) poll(false);
+    }
+
+    static thread_local RunMonitor* active;
+
+private:
+    void poll(bool phase_start)
+    {
+        if (!control_) return;
+        if (control_->cancel && control_->cancel->load(std::memory_order_relaxed))
+            throw kAbortCancelled;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (control_->time_budget_s > 0.0 &&
+            std::chrono::duration<double>(now - start_).count() > control_->time_budget_s)
+            throw kAbortTimeBudget;
+        if (control_->memory_budget_bytes > 0 && mesh_ && mesh_bytes(*mesh_) > control_->memory_budget_bytes)
+            throw kAbortMemoryBudget;
+
+        if (!control_->progress) return;
+        if (!phase_start &&
+            std::chrono::duration<double>(now - last_report_).count() < control_->progress_interval_s)
+            return;
+        last_report_ = now;
+
+        Progress p;
+        p.phase = phase_;
+        p.tets = mesh_ && mesh_->tetrahedrons ? mesh_->tetrahedrons->items : 0;
+        p.points = mesh_ && mesh_->points ? mesh_->points->items : 0;
+        p.elapsed_s = std::chrono::duration<double>(now - start_).count();
+        p.item = item_;
+        control_->progress(p);
+    }
+
+    const RunControl* control_;
+    int item_;
+    PhaseClock clock_;
+    const tetgenmesh* mesh_ = nullptr;
+    const char* phase_ = "";
+    unsigned ticks_ = 0;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_report_;
+};
+
+thread_local RunMonitor* RunMonitor::active = nullptr;
+
+#if TETWRAP_ALLOC_HOOK
+void alloc_hook()
+{
+    if (RunMonitor::active) RunMonitor::active->tick();
+}
+#endif
+
+// Installs a monitor as the thread's active one for the guard's lifetime
+struct MonitorScope {
+    explicit MonitorScope(RunMonitor& monitor)
+    {
+        RunMonitor::active = &monitor;
+#if TETWRAP_ALLOC_HOOK
+        tetwrap_alloc_hook = alloc_hook;
+#endif
+    }
+    ~MonitorScope()
+    {
+        RunMonitor::active = nullptr;
+#if TETWRAP_ALLOC_HOOK
+        tetwrap_alloc_hook = nullptr;
+#endif
+    }
+};
+
+}  // namespace
+
+void tetrahedralize_phased(tetgenbehavior& b, tetgenio* in, tetgenio* out, RunStats& stats,
+                           const RunOptions& options, StreamedMesh* streamed)
+{
+    RunMonitor monitor(options, stats);
+
+    // File-only outputs (-g, -k) are left to TetGen's own driver. Its mesh is
+    // out of reach, so only the cancel flag, the time budget and progress
+    // (without counts) are watched, through the allocation hook.
+    if (b.meditview || b.vtkview) {
+        if (options.control && options.control->memory_budget_bytes > 0)
+            throw std::runtime_error("memory_budget_bytes is not supported with -g or -k");
+        MonitorScope scope(monitor);
+        monitor.phase("tetgen", [&]() { tetrahedralize(&b, in, out); });
+        return;
+    }
+
+    tetgenmesh m;
+    monitor.attach(&m);
+    MonitorScope scope(monitor);
+    monitor.skip();
+    m.b = &b;
+    m.in = in;
+    m.addin = nullptr;
+
+    monitor.phase("transfer_nodes", [&]() {
+        m.initializepools();
+        m.transfernodes();
+        exactinit(b.verbose, b.noexact, b.nostaticfilter,
+                  m.xmax - m.xmin, m.ymax - m.ymin, m.zmax - m.zmin);
+    });
+
+    clock_t ts = 0;
+    if (b.refine) {
+        monitor.phase("reconstruct_mesh", [&]() { m.reconstructmesh(); });
+    } else {
+        monitor.phase("delaunay", [&]() { m.incrementaldelaunay(ts); });
+    }
+
+    if (b.plc && !b.refine) {
+        monitor.phase("surface_mesh", [&]() { m.meshsurface(); });
+
+        if (b.diagnose) {
+            monitor.phase("self_intersection", [&]() { m.detectinterfaces(); });
+            if (m.subfaces->items > 0l) {
+                m.outnodes(out);
+                m.outsubfaces(out);
+            }
+            collect_counters(m, *in, stats);
+            return;
+        }
+    }
+
+    if (b.plc && !b.refine) {
+        monitor.phase("boundary_recovery", [&]() {
+            if (b.nobisect) {
+                m.recoverboundary(ts);
+            } else {
+                m.constraineddelaunay(ts);
+            }
+        });
+        monitor.phase("carve_holes", [&]() { m.carveholes(); });
+        if (b.nobisect && m.subvertstack->objects > 0l) {
+            monitor.phase("steiner_suppression", [&]() { m.suppresssteinerpoints(); });
+        }
+    }
+
+    if (b.coarsen) {
+        monitor.phase("coarsening", [&]() { m.meshcoarsening(); });
+    }
+    if ((b.plc && b.nobisect) || b.coarsen) {
+        monitor.phase("delaunay_recovery", [&]() { m.recoverdelaunay(); });
+    }
+    if (b.quality) {
+        monitor.phase("refinement", [&]() { m.delaunayrefinement(); });
+    }
+    if ((b.plc || b.refine) && b.optlevel > 0) {
+        monitor.phase("optimization", [&]() { m.optimizemesh(); });
+    }
+
+    // Counters before jettisoning, so Steiner points are not offset by
+    // removed duplicate / unused input vertices
+    collect_counters(m, *in, stats);
+
+    monitor.phase("tetgen_output", [&]() {
+        if (!b.nojettison && (m.dupverts > 0 || m.unuverts > 0 || (b.refine && in->numberofcorners == 10))) {
+            m.jettisonnodes();
+        }
+        if (b.order == 2 && !b.convex) {
+            m.highorder();
+        }
+
+        out->firstnumber = in->firstnumber;
+        out->mesh_dim = in->mesh_dim;
+
+        if (!b.nonodewritten && !b.noiterationnum) {
+            if (streamed) stream_nodes(m, out, *streamed);
+            else m.outnodes(out);
+        }
+        if (b.metric) {
+            m.outmetrics(out);
+        }
+        if (b.noelewritten) {
+            m.indexelements();
+        } else if (m.tetrahedrons->items > 0l) {
+            if (streamed) stream_elements(m, out, *streamed);
+            else m.outelements(out);
+        }
+        if (!b.nofacewritten) {
+            if (b.facesout) {
+                if (m.tetrahedrons->items > 0l) m.outfaces(out);
+            } else if (b.plc || b.refine) {
+                if (m.subfaces->items > 0l) m.outsubfaces(out);
+            } else if (m.tetrahedrons->items > 0l) {
+                m.outhullfaces(out);
+            }
+        }
+        if (b.edgesout) {
+            if (b.edgesout > 1) m.outedges(out);
+            else m.outsubsegments(out);
+        }
+        if (b.neighout) {
+            if (streamed) stream_neighbors(m, *streamed);
+            else m.outneighbors(out);
+        }
+        if (b.voroout) {
+            m.outvoronoi(out);
+        }
+    });
+
+    if (b.docheck) {
+        monitor.phase("check", [&]() {
+            m.check_mesh(0);
+            if (b.plc || b.refine) {
+                m.check_shells();
+                m.check_segments();
+            }
+            if (b.docheck > 1) {
+                m.check_delaunay();
+            }
+        });
+    }
+    if (!b.quiet) {
+        m.statistics();
+    }
+}
+
+}  // namespace tetwrap
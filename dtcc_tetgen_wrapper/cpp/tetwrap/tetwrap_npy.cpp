@@ -0,0 +1,128 @@
+// Memory-mapped .npy files for streamed output (see StreamedMesh).
+//
+// Writes NumPy format 1.0 headers itself so the core stays independent of
+// NumPy; np.load(path, mmap_mode=...) reads the files back.
+#include "tetwrap_core.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace tetwrap {
+
+namespace {
+
+bool host_is_little_endian()
+{
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Magic, version 1.0, header length, then the dict padded with spaces and a
+// newline so the data starts on a 64-byte boundary.
+std::string npy_header(char kind, std::size_t itemsize, const std::vector<std::int64_t>& shape)
+{
+    std::ostringstream dict;
+    dict << "{'descr': '" << (host_is_little_endian() ? '<' : '>') << kind << itemsize
+         << "', 'fortran_order': False, 'shape': (";
+    for (std::size_t d = 0; d < shape.size(); ++d) dict << (d ? ", " : "") << shape[d];
+    dict << (shape.size() == 1 ? ",), }" : "), }");
+
+    std::string text = dict.str();
+    const std::size_t prefix = 10;  // magic (6) + version (2) + length (2)
+    const std::size_t total = (prefix + text.size() + 1 + 63) / 64 * 64;
+    text.append(total - prefix - text.size() - 1, ' ');
+    text.push_back('\n');
+
+    std::string header("\x93NUMPY\x01\x00", 8);
+    header.push_back(static_cast<char>(text.size() & 0xff));
+    header.push_back(static_cast<char>((text.size() >> 8) & 0xff));
+    return header + text;
+}
+
+std::runtime_error os_error(const std::string& what, const std::string& path)
+{
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+NpyFile::NpyFile(const std::string& path, char kind, std::size_t itemsize, std::vector<std::int64_t> shape)
+    : path_(path), shape_(std::move(shape))
+{
+    std::size_t count = 1;
+    for (std::int64_t d : shape_) {
+        if (d < 0) throw std::runtime_error("npy: negative dimension for " + path);
+        count *= static_cast<std::size_t>(d);
+    }
+    const std::string header = npy_header(kind, itemsize, shape_);
+    const std::size_t bytes = header.size() + count * itemsize;
+
+#if defined(_WIN32)
+    (void)bytes;
+    throw std::runtime_error("streamed output (output_dir) is not supported on Windows");
+#else
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw os_error("cannot create", path);
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        const std::runtime_error err = os_error("cannot size", path);
+        ::close(fd);
+        throw err;
+    }
+    void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file referenced
+    if (map == MAP_FAILED) throw os_error("cannot map", path);
+
+    map_ = map;
+    map_bytes_ = bytes;
+    std::memcpy(map_, header.data(), header.size());
+    if (count > 0) data_ = static_cast<char*>(map_) + header.size();
+#endif
+}
+
+NpyFile::NpyFile(NpyFile&& other) noexcept
+    : path_(std::move(other.path_)), shape_(std::move(other.shape_)),
+      map_(std::exchange(other.map_, nullptr)), map_bytes_(std::exchange(other.map_bytes_, 0)),
+      data_(std::exchange(other.data_, nullptr))
+{
+    other.path_.clear();
+}
+
+NpyFile& NpyFile::operator=(NpyFile&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        path_ = std::move(other.path_);
+        shape_ = std::move(other.shape_);
+        map_ = std::exchange(other.map_, nullptr);
+        map_bytes_ = std::exchange(other.map_bytes_, 0);
+        data_ = std::exchange(other.data_, nullptr);
+        other.path_.clear();
+    }
+    return *this;
+}
+
+NpyFile::~NpyFile()
+{
+    release();
+}
+
+void NpyFile::release() noexcept
+{
+#if !defined(_WIN32)
+    if (map_) ::munmap(map_, map_bytes_);
+#endif
+    map_ = nullptr;
+    map_bytes_ = 0;
+    data_ = nullptr;
+}
+
+}  // namespace tetwrap
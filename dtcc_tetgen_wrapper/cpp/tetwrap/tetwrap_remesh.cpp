@@ -0,0 +1,543 @@
+// Incremental remeshing (run_tetgen_remesh): replace the tets in a box by a
+// fresh local mesh and splice it back into the existing one.
+//
+// The cavity (the tets whose bounding boxes meet the box) is bounded by
+// interface faces, shared with kept tets, and by faces of the domain
+// boundary. Those, minus the boundary surface the patch replaces, plus the
+// patch form a local PLC. TetGen meshes it with -Y, so the interface comes
+// back unsplit and the new tets meet the kept ones face to face. Apart
+// from one parallel pass over the tets to find the cavity and the
+// renumbering of the kept arrays, the work is proportional to the cavity.
+#include "tetwrap_core.h"
+#include "tetwrap_detail.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tetwrap {
+
+namespace {
+
+using detail::FaceTable;
+using detail::faces_of_tet;
+using detail::parallel_chunks;
+using detail::sorted_face;
+
+[[noreturn]] void fail(const std::string& what)
+{
+    throw std::runtime_error("remeshing: " + what);
+}
+
+std::uint64_t edge_key(int a, int b)
+{
+    if (a > b) std::swap(a, b);
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(a)) << 32) | static_cast<std::uint32_t>(b);
+}
+
+// Exact coordinates as a hash key; adding 0.0 folds -0.0 into 0.0
+struct Coord {
+    double x[3];
+
+    explicit Coord(const double* p) : x{p[0] + 0.0, p[1] + 0.0, p[2] + 0.0} {}
+    bool operator==(const Coord& o) const { return x[0] == o.x[0] && x[1] == o.x[1] && x[2] == o.x[2]; }
+};
+
+struct CoordHash {
+    std::size_t operator()(const Coord& c) const
+    {
+        std::size_t h = 0;
+        for (double v : c.x) h = h * 1000003u ^ std::hash<double>()(v);
+        return h;
+    }
+};
+
+int facet_index(const FacetList& fl, std::int64_t k)
+{
+    return fl.indices ? fl.indices[k] : static_cast<int>(fl.indices_i64[k]);
+}
+
+// Patch facets may be empty, so validate_plc() does not apply
+void check_facets(const FacetList& fl, int num_vertices, const std::string& name)
+{
+    if (fl.count < 0) fail(name + ": count < 0");
+    if (fl.count == 0) return;
+    if (!fl.indices && !fl.indices_i64) fail(name + ": no index array");
+    if (fl.begin(0) < 0 || fl.end(fl.count - 1) > fl.num_indices) fail(name + ": offsets out of range");
+    for (int i = 0; i < fl.count; ++i) {
+        if (fl.end(i) - fl.begin(i) < 3) fail(name + " polygon " + std::to_string(i) + " has fewer than 3 vertices");
+        for (std::int64_t k = fl.begin(i); k < fl.end(i); ++k) {
+            const int v = facet_index(fl, k);
+            if (v < 0 || v >= num_vertices)
+                fail(name + " polygon " + std::to_string(i) + ": vertex index out of range");
+        }
+    }
+}
+
+void check_inputs(const TetMesh& mesh, const double* box_min, const double* box_max, const PlcInput& patch)
+{
+    if (!mesh.points || !mesh.tets || mesh.num_points <= 0 || mesh.num_tets <= 0) fail("the mesh is empty");
+    if (mesh.num_tets > std::numeric_limits<int>::max() / 4) fail("the mesh is too large for 32-bit indices");
+    if (mesh.num_boundary_faces <= 0 || !mesh.boundary_faces || !mesh.boundary_tets || !mesh.boundary_local_faces)
+        fail("the mesh needs its boundary faces");
+    for (int a = 0; a < 3; ++a)
+        if (!(box_min[a] <= box_max[a])) fail("box_min must not exceed box_max");
+    if (patch.num_vertices < 0) fail("patch: num_vertices < 0");
+    if (patch.num_vertices > 0 && !patch.vertices && !patch.vertices_f32) fail("patch: no vertex array");
+    if (patch.num_vertices > std::numeric_limits<int>::max() - mesh.num_points) fail("patch: too many vertices");
+    check_facets(patch.mesh_facets, patch.num_vertices, "patch mesh_facets");
+    check_facets(patch.boundary_facets, patch.num_vertices, "patch boundary_facets");
+}
+
+int find_root(std::vector<int>& parent, int i)
+{
+    while (parent[i] != i) i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+// Polygons in CSR form with one marker each
+struct Polygons {
+    std::vector<std::int64_t> offsets{0};
+    std::vector<int> ids;
+    std::vector<int> markers;
+
+    int count() const { return static_cast<int>(markers.size()); }
+    void add(const int* f, int n, int marker)
+    {
+        ids.insert(ids.end(), f, f + n);
+        offsets.push_back(static_cast<std::int64_t>(ids.size()));
+        markers.push_back(marker);
+    }
+};
+
+// Phase times and counters of the local run, in its order
+void append_stats(RunStats& stats, const RunStats& local)
+{
+    stats.seconds.insert(stats.seconds.end(), local.seconds.begin(), local.seconds.end());
+    stats.counters.insert(stats.counters.end(), local.counters.begin(), local.counters.end());
+}
+
+}  // namespace
+
+RemeshResult run_tetgen_remesh(const TetMesh& mesh, const double box_min[3], const double box_max[3],
+                               const PlcInput& patch, const RunOptions& options)
+{
+    RemeshResult result;
+    RunStats& stats = result.mesh.stats;
+    PhaseClock clock(stats);
+    check_inputs(mesh, box_min, box_max, patch);
+    if (!options.output_dir.empty()) fail("output_dir is not supported");
+
+    const int N = mesh.num_points, K = mesh.num_tets;
+    const std::size_t NK = static_cast<std::size_t>(K);
+
+    // Cavity: the tets whose bounding box meets the box
+    std::vector<char> in_cavity(NK, 0);
+    parallel_chunks(NK, std::size_t(1) << 15, options.kernel_threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; ++t) {
+            const int* tet = mesh.tets + 4 * t;
+            bool meets = true;
+            for (int a = 0; a < 3; ++a) {
+                double lo = std::numeric_limits<double>::infinity(), hi = -lo;
+                for (int k = 0; k < 4; ++k) {
+                    if (tet[k] < 0 || tet[k] >= N) fail("tet " + std::to_string(t) + " has an out-of-range point index");
+                    const double x = mesh.points[3 * static_cast<std::size_t>(tet[k]) + a];
+                    lo = std::min(lo, x);
+                    hi = std::max(hi, x);
+                }
+                meets = meets && lo <= box_max[a] && hi >= box_min[a];
+            }
+            in_cavity[t] = meets;
+        }
+    });
+    std::vector<int> cavity;
+    for (int t = 0; t < K; ++t)
+        if (in_cavity[static_cast<std::size_t>(t)]) cavity.push_back(t);
+    if (cavity.empty()) fail("no tets meet the region");
+
+    // Cavity faces k = 4 * (cavity index) + local face: interior (seen
+    // twice), on the domain boundary, or on the interface with kept tets
+    enum : char { kInterface, kInterior, kBoundary };
+    const std::size_t C = cavity.size();
+    auto cavity_face = [&](std::size_t k, int* f) {
+        const int* tet = mesh.tets + 4 * static_cast<std::size_t>(cavity[k / 4]);
+        for (int j = 0; j < 3; ++j) f[j] = tet[faces_of_tet[k % 4][j]];
+    };
+    std::vector<char> state(4 * C, kInterface);
+    FaceTable faces(4 * C);
+    for (std::size_t k = 0; k < 4 * C; ++k) {
+        int f[3];
+        cavity_face(k, f);
+        const auto key = sorted_face(f);
+        const int other = faces.find(key);
+        if (other < 0) faces.insert(key, static_cast<int>(k));
+        else state[k] = state[static_cast<std::size_t>(other)] = kInterior;
+    }
+    std::vector<int> cb;                        // old boundary faces owned by cavity tets
+    for (int b = 0; b < mesh.num_boundary_faces; ++b) {
+        const int t = mesh.boundary_tets[b];
+        if (t < 0 || t >= K) fail("boundary face " + std::to_string(b) + " has an out-of-range tet");
+        if (!in_cavity[static_cast<std::size_t>(t)]) continue;
+        const int k = faces.find(sorted_face(mesh.boundary_faces + 3 * static_cast<std::size_t>(b)));
+        if (k < 0 || state[static_cast<std::size_t>(k)] != kInterface)
+            fail("boundary face " + std::to_string(b) + " is not a hull face of its tet");
+        state[static_cast<std::size_t>(k)] = kBoundary;
+        cb.push_back(b);
+    }
+    std::vector<int> interface;
+    for (std::size_t k = 0; k < 4 * C; ++k)
+        if (state[k] == kInterface) interface.push_back(static_cast<int>(k));
+    if (interface.empty()) fail("the region contains the whole mesh");
+    const std::size_t B = cb.size(), I = interface.size();
+    auto cb_face = [&](std::size_t i) { return mesh.boundary_faces + 3 * static_cast<std::size_t>(cb[i]); };
+
+    // Patch vertices on the cavity surface become those points; the others
+    // are new points N, N+1, ...
+    std::unordered_map<Coord, int, CoordHash> surface_points;
+    for (std::size_t i = 0; i < B; ++i)
+        for (int j = 0; j < 3; ++j) {
+            const int v = cb_face(i)[j];
+            surface_points.emplace(Coord(mesh.points + 3 * static_cast<std::size_t>(v)), v);
+        }
+    for (int k : interface) {
+        int f[3];
+        cavity_face(static_cast<std::size_t>(k), f);
+        for (int v : f) surface_points.emplace(Coord(mesh.points + 3 * static_cast<std::size_t>(v)), v);
+    }
+    std::vector<int> patch_ids(static_cast<std::size_t>(patch.num_vertices));
+    std::vector<double> new_points;
+    for (int i = 0; i < patch.num_vertices; ++i) {
+        double p[3];
+        for (int a = 0; a < 3; ++a)
+            p[a] = patch.vertices ? patch.vertices[3 * static_cast<std::size_t>(i) + a]
+                                  : static_cast<double>(patch.vertices_f32[3 * static_cast<std::size_t>(i) + a]);
+        auto it = surface_points.find(Coord(p));
+        if (it != surface_points.end()) {
+            patch_ids[static_cast<std::size_t>(i)] = it->second;
+        } else {
+            patch_ids[static_cast<std::size_t>(i)] = N + static_cast<int>(new_points.size() / 3);
+            new_points.insert(new_points.end(), p, p + 3);
+        }
+    }
+    Polygons patch_mesh, patch_boundary;
+    std::vector<int> poly;
+    auto read_patch = [&](const FacetList& fl, const int* markers, bool boundary, Polygons& out) {
+        for (int i = 0; i < fl.count; ++i) {
+            poly.clear();
+            for (std::int64_t k = fl.begin(i); k < fl.end(i); ++k)
+                poly.push_back(patch_ids[static_cast<std::size_t>(facet_index(fl, k))]);
+            const int marker = markers ? markers[i] : boundary ? i : -1;
+            if (boundary && marker < 0) fail("patch boundary markers must be >= 0");
+            out.add(poly.data(), static_cast<int>(poly.size()), marker);
+        }
+    };
+    read_patch(patch.mesh_facets, patch.mesh_facet_markers, false, patch_mesh);
+    read_patch(patch.boundary_facets, patch.boundary_facet_markers, true, patch_boundary);
+
+    // Rim: the patch edges used by one polygon only. They must be edges of
+    // the cavity's boundary faces.
+    std::unordered_map<std::uint64_t, int> patch_edges;
+    for (const Polygons* p : {&patch_mesh, &patch_boundary})
+        for (int i = 0; i < p->count(); ++i) {
+            const std::int64_t b = p->offsets[static_cast<std::size_t>(i)], e = p->offsets[static_cast<std::size_t>(i) + 1];
+            for (std::int64_t k = b; k < e; ++k)
+                ++patch_edges[edge_key(p->ids[static_cast<std::size_t>(k)],
+                                       p->ids[static_cast<std::size_t>(k + 1 < e ? k + 1 : b)])];
+        }
+    std::vector<std::uint64_t> rim;
+    std::unordered_set<int> rim_points;
+    for (const auto& e : patch_edges) {
+        if (e.second != 1) continue;
+        const int a = static_cast<int>(e.first >> 32), b = static_cast<int>(e.first & 0xffffffffu);
+        if (a >= N || b >= N) fail("a patch rim vertex does not match a boundary point in the region");
+        rim.push_back(e.first);
+        rim_points.insert(a);
+        rim_points.insert(b);
+    }
+    std::sort(rim.begin(), rim.end());
+
+    // Surfaces cut off by the rim: boundary faces joined across non-rim
+    // edges. A part is replaced when it touches the rim and does not
+    // continue outside the cavity (an edge with only one cavity face).
+    std::vector<std::pair<std::uint64_t, int>> cb_edges;
+    cb_edges.reserve(3 * B);
+    for (std::size_t i = 0; i < B; ++i)
+        for (int j = 0; j < 3; ++j)
+            cb_edges.emplace_back(edge_key(cb_face(i)[j], cb_face(i)[(j + 1) % 3]), static_cast<int>(i));
+    std::sort(cb_edges.begin(), cb_edges.end());
+    std::vector<int> parent(B);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto for_each_edge = [&](auto&& fn) {
+        for (std::size_t g = 0, h = 0; g < cb_edges.size(); g = h) {
+            for (h = g + 1; h < cb_edges.size() && cb_edges[h].first == cb_edges[g].first; ++h) {}
+            fn(g, h, std::binary_search(rim.begin(), rim.end(), cb_edges[g].first));
+        }
+    };
+    for_each_edge([&](std::size_t g, std::size_t h, bool on_rim) {
+        if (on_rim) return;
+        for (std::size_t j = g + 1; j < h; ++j)
+            parent[static_cast<std::size_t>(find_root(parent, cb_edges[j].second))] = find_root(parent, cb_edges[g].second);
+    });
+    std::vector<char> touches_rim(B, 0), escapes(B, 0);
+    std::size_t rim_found = 0;
+    for_each_edge([&](std::size_t g, std::size_t h, bool on_rim) {
+        if (on_rim) {
+            ++rim_found;
+            for (std::size_t j = g; j < h; ++j) touches_rim[static_cast<std::size_t>(find_root(parent, cb_edges[j].second))] = 1;
+        } else if (h - g == 1) {
+            escapes[static_cast<std::size_t>(find_root(parent, cb_edges[g].second))] = 1;
+        }
+    });
+    if (rim_found != rim.size()) fail("the patch rim must run along boundary edges inside the region");
+    std::vector<char> removed(B, 0);
+    for (std::size_t i = 0; i < B; ++i) {
+        const std::size_t r = static_cast<std::size_t>(find_root(parent, static_cast<int>(i)));
+        removed[i] = touches_rim[r] && !escapes[r];
+    }
+    for_each_edge([&](std::size_t g, std::size_t h, bool on_rim) {
+        if (!on_rim) return;
+        std::size_t gone = 0;
+        for (std::size_t j = g; j < h; ++j) gone += removed[static_cast<std::size_t>(cb_edges[j].second)];
+        // One side is replaced, the other kept (possibly outside the cavity)
+        if (gone == 0 || (gone == h - g && h - g > 1)) fail("the patch rim does not cut off a part of the boundary inside the region");
+    });
+    std::unordered_set<int> kept_points;
+    for (std::size_t i = 0; i < B; ++i)
+        if (!removed[i]) kept_points.insert(cb_face(i), cb_face(i) + 3);
+    for (int k : interface) {
+        int f[3];
+        cavity_face(static_cast<std::size_t>(k), f);
+        kept_points.insert(f, f + 3);
+    }
+    for (std::size_t i = 0; i < B; ++i)
+        if (removed[i])
+            for (int j = 0; j < 3; ++j) {
+                const int v = cb_face(i)[j];
+                if (!rim_points.count(v) && kept_points.count(v))
+                    fail("the region must contain all of the boundary surface the patch replaces");
+            }
+
+    // Local PLC: kept boundary faces and the patch, closed by the interface.
+    // Raw markers r of kept faces survive the round trip: r > 0 and -1 are
+    // mesh facet markers r - 1 (or none), r <= -2 boundary polygon -r - 2.
+    PlcBundle local;
+    std::vector<int> local_ids;                 // local point -> old point, or N + new patch point
+    std::unordered_map<int, int> to_local;
+    auto local_point = [&](int g) {
+        auto ins = to_local.emplace(g, static_cast<int>(local_ids.size()));
+        if (ins.second) {
+            local_ids.push_back(g);
+            const double* p = g < N ? mesh.points + 3 * static_cast<std::size_t>(g)
+                                    : new_points.data() + 3 * static_cast<std::size_t>(g - N);
+            local.vertices.insert(local.vertices.end(), p, p + 3);
+        }
+        return ins.first->second;
+    };
+    local.mesh_offsets.push_back(0);
+    local.boundary_offsets.push_back(0);
+    int max_marker = -1;
+    auto add_local = [&](const int* f, int n, int marker, bool boundary) {
+        std::vector<int>& ids = boundary ? local.boundary_indices : local.mesh_indices;
+        for (int j = 0; j < n; ++j) ids.push_back(local_point(f[j]));
+        (boundary ? local.boundary_offsets : local.mesh_offsets).push_back(static_cast<std::int64_t>(ids.size()));
+        (boundary ? local.boundary_markers : local.mesh_markers).push_back(marker);
+        if (boundary) max_marker = std::max(max_marker, marker);
+    };
+    for (std::size_t i = 0; i < B; ++i) {
+        if (removed[i]) continue;
+        const int r = mesh.boundary_markers ? mesh.boundary_markers[cb[i]] : 0;
+        if (r <= -2) add_local(cb_face(i), 3, -r - 2, true);
+        else add_local(cb_face(i), 3, r > 0 ? r - 1 : -1, false);
+    }
+    for (const Polygons* p : {&patch_mesh, &patch_boundary})
+        for (int i = 0; i < p->count(); ++i) {
+            const std::size_t b = static_cast<std::size_t>(p->offsets[static_cast<std::size_t>(i)]);
+            add_local(&p->ids[b], static_cast<int>(p->offsets[static_cast<std::size_t>(i) + 1] - p->offsets[static_cast<std::size_t>(i)]),
+                      p->markers[static_cast<std::size_t>(i)], p == &patch_boundary);
+        }
+    const int interface_marker = max_marker + 1;
+    for (int k : interface) {
+        int f[3];
+        cavity_face(static_cast<std::size_t>(k), f);
+        add_local(f, 3, interface_marker, true);
+    }
+
+    // Input points stay first and in order (-J), the interface is not
+    // split (-Y); neighbors are needed to stitch them back
+    std::vector<char> sw = patch.switches;
+    if (sw.empty() || sw.back() != '\0') sw.push_back('\0');
+    add_switch(sw, 'p');
+    add_switch(sw, 'Y');
+    add_switch(sw, 'J');
+    if (mesh.neighbors) add_switch(sw, 'n');
+    {
+        tetgenbehavior behavior;
+        std::vector<char> parsed = sw;
+        if (!behavior.parse_commandline(parsed.data())) fail("invalid switches");
+        if (behavior.refine) fail("-r is not supported");
+        if (behavior.order == 2) fail("-o2 is not supported");
+    }
+    local.switches.assign(sw.begin(), sw.end() - 1);
+    local.compute_boundary_faces = true;
+    const std::size_t n_in = local_ids.size();
+    clock.lap("select");
+
+    PlcInput view = local.view();
+    view.sizing = patch.sizing;
+    MeshResult fresh = run_tetgen(view, options);
+    append_stats(stats, fresh.stats);
+    clock.skip();
+    const tetgenio& o = *fresh.out;
+    if (o.numberofcorners != 4) fail("the local mesh must have linear tets");
+    if (static_cast<std::size_t>(o.numberofpoints) < n_in ||
+        !std::equal(local.vertices.begin(), local.vertices.end(), o.pointlist))
+        fail("TetGen renumbered the input points of the region");
+    if (mesh.neighbors && !o.neighborlist) fail("TetGen did not return neighbors");
+
+    // Numbering: kept tets in order, then the new ones; points of kept tets
+    // and kept surface points in order, then new patch and Steiner points
+    std::vector<int>& tet_map = result.tet_map;
+    std::vector<int>& point_map = result.point_map;
+    tet_map.assign(NK, -1);
+    point_map.assign(static_cast<std::size_t>(N), -1);
+    int kept_tets = 0;
+    for (std::size_t t = 0; t < NK; ++t) {
+        if (in_cavity[t]) continue;
+        tet_map[t] = kept_tets++;
+        for (int k = 0; k < 4; ++k) point_map[static_cast<std::size_t>(mesh.tets[4 * t + k])] = 0;
+    }
+    for (int g : local_ids)
+        if (g < N) point_map[static_cast<std::size_t>(g)] = 0;
+    int kept_points_count = 0;
+    for (int& p : point_map)
+        if (p == 0) p = kept_points_count++;
+    const std::size_t LP = static_cast<std::size_t>(o.numberofpoints);
+    std::vector<int> final_id(LP);
+    int num_points = kept_points_count;
+    for (std::size_t l = 0; l < LP; ++l) {
+        const bool old = l < n_in && local_ids[l] < N;
+        final_id[l] = old ? point_map[static_cast<std::size_t>(local_ids[l])] : num_points++;
+    }
+    const std::size_t new_tets = static_cast<std::size_t>(o.numberoftetrahedra);
+    const std::size_t T = static_cast<std::size_t>(kept_tets) + new_tets;
+    if (T > static_cast<std::size_t>(std::numeric_limits<int>::max()) / 4)
+        fail("the spliced mesh is too large for 32-bit indices");
+
+    result.mesh.out.reset(new tetgenio());
+    tetgenio& out = *result.mesh.out;
+    out.firstnumber = 0;
+    out.mesh_dim = 3;
+    out.numberofpoints = num_points;
+    out.pointlist = new REAL[3 * static_cast<std::size_t>(num_points)];
+    out.numberofcorners = 4;
+    out.numberoftetrahedra = static_cast<int>(T);
+    out.tetrahedronlist = new int[4 * T];
+    if (mesh.neighbors) out.neighborlist = new int[4 * T];
+
+    // Kept points and tets: disjoint destinations, so chunks run in parallel
+    parallel_chunks(static_cast<std::size_t>(N), std::size_t(1) << 15, options.kernel_threads,
+                    [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; ++p)
+            if (point_map[p] >= 0)
+                std::copy(mesh.points + 3 * p, mesh.points + 3 * p + 3, out.pointlist + 3 * static_cast<std::size_t>(point_map[p]));
+    });
+    parallel_chunks(NK, std::size_t(1) << 15, options.kernel_threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; ++t) {
+            if (tet_map[t] < 0) continue;
+            const std::size_t d = 4 * static_cast<std::size_t>(tet_map[t]);
+            for (int k = 0; k < 4; ++k) {
+                out.tetrahedronlist[d + k] = point_map[static_cast<std::size_t>(mesh.tets[4 * t + k])];
+                if (!mesh.neighbors) continue;
+                const int nb = mesh.neighbors[4 * t + k];
+                if (nb >= K) fail("tet " + std::to_string(t) + " has an out-of-range neighbor");
+                out.neighborlist[d + k] = nb < 0 ? -1 : tet_map[static_cast<std::size_t>(nb)];
+            }
+        }
+    });
+    for (std::size_t l = 0; l < LP; ++l)
+        if (final_id[l] >= kept_points_count)
+            std::copy(o.pointlist + 3 * l, o.pointlist + 3 * l + 3, out.pointlist + 3 * static_cast<std::size_t>(final_id[l]));
+    const std::size_t tet_base = static_cast<std::size_t>(kept_tets);
+    for (std::size_t i = 0; i < 4 * new_tets; ++i) {
+        out.tetrahedronlist[4 * tet_base + i] = final_id[static_cast<std::size_t>(o.tetrahedronlist[i])];
+        if (mesh.neighbors)
+            out.neighborlist[4 * tet_base + i] = o.neighborlist[i] < 0 ? -1 : o.neighborlist[i] + kept_tets;
+    }
+
+    // Boundary: the kept tets' faces, then the local hull faces except the
+    // interface, which must come back whole
+    MeshResult& spliced = result.mesh;
+    const bool markers = mesh.boundary_markers && fresh.has_boundary_markers;
+    if (patch.compute_boundary_faces)
+        for (int b = 0; b < mesh.num_boundary_faces; ++b) {
+            const int t = mesh.boundary_tets[b];
+            if (in_cavity[static_cast<std::size_t>(t)]) continue;
+            for (int j = 0; j < 3; ++j)
+                spliced.boundary_faces.push_back(point_map[static_cast<std::size_t>(mesh.boundary_faces[3 * static_cast<std::size_t>(b) + j])]);
+            spliced.boundary_tets.push_back(tet_map[static_cast<std::size_t>(t)]);
+            spliced.boundary_local_faces.push_back(mesh.boundary_local_faces[b]);
+            if (markers) spliced.boundary_markers.push_back(mesh.boundary_markers[b]);
+        }
+    FaceTable interface_faces(I);
+    for (std::size_t i = 0; i < I; ++i) {
+        int f[3];
+        cavity_face(static_cast<std::size_t>(interface[i]), f);
+        interface_faces.insert(sorted_face(f), static_cast<int>(i));
+    }
+    std::vector<int> matched(I, -1);            // new tet * 4 + local face
+    for (std::size_t b = 0; b < fresh.boundary_tets.size(); ++b) {
+        const int* f = &fresh.boundary_faces[3 * b];
+        const int tet = fresh.boundary_tets[b] + kept_tets;
+        int g[3];
+        bool old = true;
+        for (int j = 0; j < 3; ++j) {
+            const std::size_t l = static_cast<std::size_t>(f[j]);
+            old = old && l < n_in && local_ids[l] < N;
+            g[j] = old ? local_ids[l] : -1;
+        }
+        const int i = old ? interface_faces.find(sorted_face(g)) : -1;
+        if (i >= 0) {
+            if (matched[static_cast<std::size_t>(i)] >= 0) fail("an interface face was meshed twice");
+            matched[static_cast<std::size_t>(i)] = 4 * tet + fresh.boundary_local_faces[b];
+        } else if (patch.compute_boundary_faces) {
+            for (int j = 0; j < 3; ++j) spliced.boundary_faces.push_back(final_id[static_cast<std::size_t>(f[j])]);
+            spliced.boundary_tets.push_back(tet);
+            spliced.boundary_local_faces.push_back(fresh.boundary_local_faces[b]);
+            if (markers) spliced.boundary_markers.push_back(fresh.boundary_markers[b]);
+        }
+    }
+    for (std::size_t i = 0; i < I; ++i)
+        if (matched[i] < 0)
+            fail("the new mesh does not conform to the kept tets (does the region enclose kept tets?)");
+    if (mesh.neighbors)
+        for (std::size_t i = 0; i < I; ++i) {
+            const std::size_t k = static_cast<std::size_t>(interface[i]);
+            const int c = cavity[k / 4];
+            const int q = mesh.neighbors[4 * static_cast<std::size_t>(c) + k % 4];
+            if (q < 0 || in_cavity[static_cast<std::size_t>(q)]) fail("the neighbors do not match the tets");
+            const int* qn = mesh.neighbors + 4 * static_cast<std::size_t>(q);
+            const int lf = static_cast<int>(std::find(qn, qn + 4, c) - qn);
+            if (lf == 4) fail("the neighbors are not symmetric");
+            out.neighborlist[4 * static_cast<std::size_t>(tet_map[static_cast<std::size_t>(q)]) + lf] = matched[i] / 4;
+            out.neighborlist[matched[i]] = tet_map[static_cast<std::size_t>(q)];
+        }
+    spliced.has_boundary_faces = patch.compute_boundary_faces;
+    spliced.has_boundary_markers = patch.compute_boundary_faces && markers;
+
+    stats.counters.emplace_back("cavity_tets", static_cast<long long>(C));
+    stats.counters.emplace_back("new_tets", static_cast<long long>(new_tets));
+    stats.counters.emplace_back("interface_faces", static_cast<long long>(I));
+    clock.lap("splice");
+    return result;
+}
+
+}  // namespace tetwrap
@@ -0,0 +1,332 @@
+// Built-in sizing kernels (SizingField) and the tetunsuitable hook through
+// which TetGen's quality refinement consults them.
+//
+// TetGen calls the hook once per tet it checks, from the thread running
+// it, with the four corner coordinates and no user pointer; the field of
+// the current run is therefore kept in a thread_local, so concurrent runs
+// (batches, tiles) each see their own.
+#include "tetwrap_core.h"
+#include "tetwrap_detail.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tetwrap {
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+[[noreturn]] void fail(std::size_t kernel, const std::string& what)
+{
+    throw std::runtime_error("sizing: kernel " + std::to_string(kernel) + ": " + what);
+}
+
+double dot(const double* a, const double* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+// Squared distance from p to triangle t (9 coordinates), after Ericson,
+// Real-Time Collision Detection, 5.1.5
+double triangle_dist2(const double* p, const double* t)
+{
+    const double* a = t;
+    const double* b = t + 3;
+    const double* c = t + 6;
+    const double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const double ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    const double ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+    double q[3];
+    auto at = [&](const double* o, const double* e, double s) {
+        for (int k = 0; k < 3; ++k) q[k] = o[k] + s * e[k];
+    };
+
+    const double d1 = dot(ab, ap), d2 = dot(ac, ap);
+    if (d1 <= 0.0 && d2 <= 0.0) {
+        at(a, ab, 0.0);
+    } else {
+        const double bp[3] = {p[0] - b[0], p[1] - b[1], p[2] - b[2]};
+        const double d3 = dot(ab, bp), d4 = dot(ac, bp);
+        const double cp[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+        const double d5 = dot(ab, cp), d6 = dot(ac, cp);
+        const double vc = d1 * d4 - d3 * d2, vb = d5 * d2 - d1 * d6, va = d3 * d6 - d5 * d4;
+        if (d3 >= 0.0 && d4 <= d3) {
+            at(b, ab, 0.0);
+        } else if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+            at(a, ab, d1 / (d1 - d3));
+        } else if (d6 >= 0.0 && d5 <= d6) {
+            at(c, ac, 0.0);
+        } else if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+            at(a, ac, d2 / (d2 - d6));
+        } else if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+            const double bc[3] = {c[0] - b[0], c[1] - b[1], c[2] - b[2]};
+            at(b, bc, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        } else {
+            const double denom = 1.0 / (va + vb + vc);
+            const double v = vb * denom, w = vc * denom;
+            for (int k = 0; k < 3; ++k) q[k] = a[k] + v * ab[k] + w * ac[k];
+        }
+    }
+    const double d[3] = {p[0] - q[0], p[1] - q[1], p[2] - q[2]};
+    return dot(d, d);
+}
+
+// Trilinear interpolation of a kGrid kernel, clamped to the grid
+template <typename T>
+double trilinear(const SizingKernel& s, const T* v, const double* p)
+{
+    std::int64_t i[3];
+    double f[3];
+    for (int a = 0; a < 3; ++a) {
+        const std::int64_t n = s.grid_shape[a];
+        const double u = std::min(std::max((p[a] - s.grid_origin[a]) / s.grid_spacing[a], 0.0),
+                                  static_cast<double>(n - 1));
+        i[a] = std::min(static_cast<std::int64_t>(u), std::max<std::int64_t>(n - 2, 0));
+        f[a] = n > 1 ? u - static_cast<double>(i[a]) : 0.0;
+    }
+    const std::int64_t sy = s.grid_shape[2], sx = s.grid_shape[1] * sy;
+    const std::int64_t dx = s.grid_shape[0] > 1 ? sx : 0, dy = s.grid_shape[1] > 1 ? sy : 0,
+                       dz = s.grid_shape[2] > 1 ? 1 : 0;
+    const T* c = v + i[0] * sx + i[1] * sy + i[2];
+    auto lerp = [](double a, double b, double t) { return a + (b - a) * t; };
+    const double c00 = lerp(c[0], c[dx], f[0]), c10 = lerp(c[dy], c[dx + dy], f[0]);
+    const double c01 = lerp(c[dz], c[dx + dz], f[0]), c11 = lerp(c[dy + dz], c[dx + dy + dz], f[0]);
+    return lerp(lerp(c00, c10, f[1]), lerp(c01, c11, f[1]), f[2]);
+}
+
+template <typename T>
+void check_grid_values(std::size_t kernel, const T* v, std::size_t n)
+{
+    std::atomic<bool> bad{false};
+    detail::parallel_chunks(n, std::size_t(1) << 20, 0, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            if (!(v[i] > 0) || !std::isfinite(static_cast<double>(v[i]))) {
+                bad = true;
+                return;
+            }
+    });
+    if (bad) fail(kernel, "grid values must be positive and finite");
+}
+
+thread_local const SizingField* active_field = nullptr;
+
+bool tet_unsuitable(REAL* pa, REAL* pb, REAL* pc, REAL* pd, REAL*, REAL)
+{
+    return active_field && active_field->tet_too_large(pa, pb, pc, pd);
+}
+
+} // namespace
+
+// Surface triangles of a kDistance kernel bucketed by bounding box. Only
+// distances below `reach` matter (beyond it the size is max_size), and the
+// cells are at least `reach` wide, so the query box [p - reach, p + reach],
+// 2 * reach wide, meets at most 3 cells per axis (27 cells).
+struct SizingField::SurfaceGrid {
+    double reach = 0.0;
+    double origin[3] = {0.0, 0.0, 0.0};
+    double cell = 0.0;
+    std::int64_t n[3] = {1, 1, 1};
+    std::vector<double> coords;              // 9 per triangle
+    std::vector<std::int64_t> start;         // CSR over cells
+    std::vector<int> items;
+
+    std::int64_t cell_of(double x, int axis) const
+    {
+        const double c = std::floor((x - origin[axis]) / cell);
+        return static_cast<std::int64_t>(std::min(std::max(c, 0.0), static_cast<double>(n[axis] - 1)));
+    }
+
+    // Distance to the nearest triangle, capped at reach
+    double distance(const double* p) const
+    {
+        std::int64_t lo[3], hi[3];
+        for (int k = 0; k < 3; ++k) {
+            const double a = p[k] - reach, b = p[k] + reach;
+            if (b < origin[k] || a > origin[k] + cell * static_cast<double>(n[k])) return reach;
+            lo[k] = cell_of(a, k);
+            hi[k] = cell_of(b, k);
+        }
+        double best = reach * reach;
+        for (std::int64_t z = lo[2]; z <= hi[2]; ++z)
+            for (std::int64_t y = lo[1]; y <= hi[1]; ++y)
+                for (std::int64_t x = lo[0]; x <= hi[0]; ++x) {
+                    const std::int64_t c = (z * n[1] + y) * n[0] + x;
+                    for (std::int64_t i = start[c]; i < start[c + 1]; ++i)
+                        best = std::min(best, triangle_dist2(p, &coords[9 * static_cast<std::size_t>(items[i])]));
+                }
+        return std::sqrt(best);
+    }
+};
+
+SizingField::SizingField(std::vector<SizingKernel> kernels) : kernels_(std::move(kernels))
+{
+    grids_.resize(kernels_.size());
+    for (std::size_t k = 0; k < kernels_.size(); ++k) {
+        const SizingKernel& s = kernels_[k];
+        if (s.kind != SizingKernel::kGrid && (!(s.size > 0.0) || !std::isfinite(s.size)))
+            fail(k, "size must be positive");
+        switch (s.kind) {
+        case SizingKernel::kHeight:
+        case SizingKernel::kDistance:
+            if (!(s.growth >= 0.0) || !std::isfinite(s.growth)) fail(k, "growth must be >= 0");
+            if (!(s.max_size >= s.size)) fail(k, "max_size must be >= size");
+            break;
+        case SizingKernel::kBox:
+            for (int a = 0; a < 3; ++a)
+                if (!(s.lo[a] <= s.hi[a])) fail(k, "box lo must not exceed hi");
+            break;
+        case SizingKernel::kSphere:
+            if (!(s.radius > 0.0)) fail(k, "radius must be positive");
+            break;
+        case SizingKernel::kGrid: {
+            std::size_t n = 1;
+            for (int a = 0; a < 3; ++a) {
+                if (s.grid_shape[a] < 1) fail(k, "grid shape must be at least 1 per axis");
+                if (!(s.grid_spacing[a] > 0.0) || !std::isfinite(s.grid_spacing[a]))
+                    fail(k, "grid spacing must be positive");
+                if (!std::isfinite(s.grid_origin[a])) fail(k, "grid origin must be finite");
+                n *= static_cast<std::size_t>(s.grid_shape[a]);
+            }
+            if (!s.grid_values == !s.grid_values_f32) fail(k, "set exactly one grid value pointer");
+            if (s.grid_values) check_grid_values(k, s.grid_values, n);
+            else check_grid_values(k, s.grid_values_f32, n);
+            continue;   // no size parameter
+        }
+        default:
+            fail(k, "unknown kind");
+        }
+        if (s.kind != SizingKernel::kDistance) continue;
+
+        // The size is constant without growth or headroom
+        if (s.growth == 0.0 || s.max_size == s.size || s.num_surface_triangles == 0) continue;
+        const double reach = (s.max_size - s.size) / s.growth;
+        if (!std::isfinite(reach)) fail(k, "max_size must be finite");
+        if (!s.surface_points || !s.surface_triangles || s.num_surface_points <= 0 || s.num_surface_triangles < 0)
+            fail(k, "missing surface points or triangles");
+
+        std::unique_ptr<SurfaceGrid> g(new SurfaceGrid());
+        const std::size_t S = static_cast<std::size_t>(s.num_surface_triangles);
+        g->reach = reach;
+        g->coords.resize(9 * S);
+        double lo[3] = {kInf, kInf, kInf}, hi[3] = {-kInf, -kInf, -kInf};
+        for (std::size_t t = 0; t < S; ++t)
+            for (int v = 0; v < 3; ++v) {
+                const int i = s.surface_triangles[3 * t + v];
+                if (i < 0 || i >= s.num_surface_points) fail(k, "triangles refer to a point out of range");
+                for (int a = 0; a < 3; ++a) {
+                    const double x = s.surface_points[3 * static_cast<std::size_t>(i) + a];
+                    if (!std::isfinite(x)) fail(k, "surface points must be finite");
+                    g->coords[9 * t + 3 * v + a] = x;
+                    lo[a] = std::min(lo[a], x);
+                    hi[a] = std::max(hi[a], x);
+                }
+            }
+
+        // Cells of width reach, doubled until there are at most ~8 per triangle
+        const double max_cells = std::max(1024.0, 8.0 * static_cast<double>(S));
+        g->cell = reach;
+        for (;;) {
+            double cells = 1.0;
+            for (int a = 0; a < 3; ++a) cells *= std::max(1.0, std::ceil((hi[a] - lo[a] + 2.0 * reach) / g->cell));
+            if (cells <= max_cells) break;
+            g->cell *= 2.0;
+        }
+        for (int a = 0; a < 3; ++a) {
+            g->origin[a] = lo[a] - reach;
+            g->n[a] = static_cast<std::int64_t>(std::max(1.0, std::ceil((hi[a] - lo[a] + 2.0 * reach) / g->cell)));
+        }
+
+        // Counting sort of the triangles into the cells their boxes meet
+        auto cell_range = [&](std::size_t t, std::int64_t* clo, std::int64_t* chi) {
+            for (int a = 0; a < 3; ++a) {
+                const double* c = &g->coords[9 * t + a];
+                clo[a] = g->cell_of(std::min({c[0], c[3], c[6]}), a);
+                chi[a] = g->cell_of(std::max({c[0], c[3], c[6]}), a);
+            }
+        };
+        auto for_cells = [&](std::size_t t, auto&& fn) {
+            std::int64_t clo[3], chi[3];
+            cell_range(t, clo, chi);
+            for (std::int64_t z = clo[2]; z <= chi[2]; ++z)
+                for (std::int64_t y = clo[1]; y <= chi[1]; ++y)
+                    for (std::int64_t x = clo[0]; x <= chi[0]; ++x) fn((z * g->n[1] + y) * g->n[0] + x);
+        };
+        g->start.assign(static_cast<std::size_t>(g->n[0] * g->n[1] * g->n[2]) + 1, 0);
+        for (std::size_t t = 0; t < S; ++t) for_cells(t, [&](std::int64_t c) { ++g->start[c + 1]; });
+        for (std::size_t c = 1; c < g->start.size(); ++c) g->start[c] += g->start[c - 1];
+        g->items.resize(static_cast<std::size_t>(g->start.back()));
+        std::vector<std::int64_t> fill(g->start.begin(), g->start.end() - 1);
+        for (std::size_t t = 0; t < S; ++t)
+            for_cells(t, [&](std::int64_t c) { g->items[fill[c]++] = static_cast<int>(t); });
+        grids_[k] = std::move(g);
+    }
+}
+
+SizingField::~SizingField() = default;
+
+double SizingField::size_at(const double* p) const
+{
+    double h = kInf;
+    for (std::size_t k = 0; k < kernels_.size(); ++k) {
+        const SizingKernel& s = kernels_[k];
+        switch (s.kind) {
+        case SizingKernel::kHeight:
+            h = std::min(h, std::min(s.max_size, s.size + s.growth * std::max(0.0, p[2] - s.ground_z)));
+            break;
+        case SizingKernel::kDistance: {
+            // Without a grid the size is the same everywhere
+            if (s.num_surface_triangles == 0) h = std::min(h, s.max_size);
+            else if (!grids_[k]) h = std::min(h, s.size);
+            else h = std::min(h, std::min(s.max_size, s.size + s.growth * grids_[k]->distance(p)));
+            break;
+        }
+        case SizingKernel::kBox:
+            if (p[0] >= s.lo[0] && p[0] <= s.hi[0] && p[1] >= s.lo[1] && p[1] <= s.hi[1] && p[2] >= s.lo[2] &&
+                p[2] <= s.hi[2])
+                h = std::min(h, s.size);
+            break;
+        case SizingKernel::kSphere: {
+            const double d[3] = {p[0] - s.center[0], p[1] - s.center[1], p[2] - s.center[2]};
+            if (dot(d, d) <= s.radius * s.radius) h = std::min(h, s.size);
+            break;
+        }
+        case SizingKernel::kGrid:
+            h = std::min(h, s.grid_values ? trilinear(s, s.grid_values, p) : trilinear(s, s.grid_values_f32, p));
+            break;
+        }
+    }
+    return h;
+}
+
+bool SizingField::tet_too_large(const double* a, const double* b, const double* c, const double* d) const
+{
+    const double* v[4] = {a, b, c, d};
+    double centroid[3];
+    for (int k = 0; k < 3; ++k) centroid[k] = 0.25 * (a[k] + b[k] + c[k] + d[k]);
+    const double h = size_at(centroid);
+    if (!(h < kInf)) return false;
+
+    double longest = 0.0;
+    for (int i = 0; i < 4; ++i)
+        for (int j = i + 1; j < 4; ++j) {
+            const double e[3] = {v[i][0] - v[j][0], v[i][1] - v[j][1], v[i][2] - v[j][2]};
+            longest = std::max(longest, dot(e, e));
+        }
+    return longest > h * h;
+}
+
+SizingHook::SizingHook(tetgenio& in, const SizingField* field) : previous_(active_field)
+{
+    if (!field) return;
+    active_field = field;
+    in.tetunsuitable = &tet_unsuitable;
+}
+
+SizingHook::~SizingHook() { active_field = previous_; }
+
+} // namespace tetwrap
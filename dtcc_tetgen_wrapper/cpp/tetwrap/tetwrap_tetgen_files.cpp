@@ -0,0 +1,659 @@
+// Readers and writers for TetGen's own file formats (see TetgenNodes).
+//
+// Files are mapped and their record bodies split at line boundaries; a
+// counting pass gives every chunk its first record, then chunks are parsed
+// in parallel straight into the output arrays. Numbers go through
+// std::from_chars / std::to_chars where the standard library has the
+// floating-point overloads.
+#include "tetwrap_core.h"
+#include "tetwrap_detail.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <limits>
+
+namespace tetwrap {
+
+namespace {
+
+constexpr std::size_t kMinChunkBytes = std::size_t(1) << 20;
+constexpr std::size_t kMinChunkRows = 16384;
+constexpr std::size_t kRowsPerBatch = std::size_t(1) << 20;
+
+using detail::parallel_chunks;
+
+bool is_separator(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == ',';
+}
+
+// Next data line at or after p, skipping blank lines and # comments.
+// Returns false at the end of the buffer.
+bool next_record(const char*& p, const char* end, const char*& line, const char*& line_end)
+{
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        const char* e = nl ? nl : end;
+        const char* q = p;
+        p = nl ? nl + 1 : end;
+        while (q < e && is_separator(*q)) ++q;
+        if (q < e && *q != '#') {
+            line = q;
+            line_end = e;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::from_chars_result parse_value(const char* p, const char* end, int& value)
+{
+    return std::from_chars(p, end, value);
+}
+
+std::from_chars_result parse_value(const char* p, const char* end, std::int64_t& value)
+{
+    return std::from_chars(p, end, value);
+}
+
+std::from_chars_result parse_value(const char* p, const char* end, double& value)
+{
+#if defined(__cpp_lib_to_chars)
+    return std::from_chars(p, end, value);
+#else
+    // strtod needs a terminated string; numbers are short
+    char token[64];
+    const std::size_t n = std::min<std::size_t>(static_cast<std::size_t>(end - p), sizeof(token) - 1);
+    std::memcpy(token, p, n);
+    token[n] = '\0';
+    char* stop = nullptr;
+    value = std::strtod(token, &stop);
+    std::from_chars_result r;
+    r.ptr = p + (stop - token);
+    r.ec = stop == token ? std::errc::invalid_argument : std::errc();
+    return r;
+#endif
+}
+
+// Parses the numbers of one record and reports errors against it
+class RecordParser {
+public:
+    RecordParser(const std::string& path, std::int64_t record, const char* line, const char* end)
+        : path_(&path), record_(record), p_(line), end_(end)
+    {
+    }
+
+    // Next number, or false when the record has none left
+    template <typename T>
+    bool next(T& value)
+    {
+        while (p_ < end_ && is_separator(*p_)) ++p_;
+        if (p_ == end_ || *p_ == '#') return false;
+        if (*p_ == '+') ++p_;
+        const std::from_chars_result r = parse_value(p_, end_, value);
+        if (r.ec != std::errc() || (r.ptr < end_ && !is_separator(*r.ptr) && *r.ptr != '#'))
+            fail("malformed number '" + token() + "'");
+        p_ = r.ptr;
+        return true;
+    }
+
+    template <typename T>
+    T get(const char* what)
+    {
+        T value{};
+        if (!next(value)) fail(std::string("missing ") + what);
+        return value;
+    }
+
+    // Node index rebased to 0
+    int node(int first_index, std::int64_t num_nodes = -1)
+    {
+        const int v = get<int>("node index") - first_index;
+        if (v < 0 || (num_nodes >= 0 && v >= num_nodes)) fail("node index out of range");
+        return v;
+    }
+
+    [[noreturn]] void fail(const std::string& what) const
+    {
+        throw std::runtime_error(*path_ + ": record " + std::to_string(record_) + ": " + what);
+    }
+
+private:
+    std::string token() const
+    {
+        const char* e = p_;
+        while (e < end_ && !is_separator(*e)) ++e;
+        return std::string(p_, e);
+    }
+
+    const std::string* path_;
+    std::int64_t record_;
+    const char* p_;
+    const char* end_;
+};
+
+// Sequential view of a mapped file's records
+class RecordCursor {
+public:
+    RecordCursor(const std::string& path, const detail::MappedFile& file) : path_(path), p_(file.begin()), end_(file.end()) {}
+
+    // Next record; throws with `what` at the end of the file
+    RecordParser next(const char* what)
+    {
+        RecordParser parser(path_, record_, nullptr, nullptr);
+        if (!try_next(parser)) throw std::runtime_error(path_ + ": unexpected end of file, expected " + what);
+        return parser;
+    }
+
+    bool try_next(RecordParser& parser)
+    {
+        const char *line, *line_end;
+        if (!next_record(p_, end_, line, line_end)) return false;
+        parser = RecordParser(path_, record_++, line, line_end);
+        return true;
+    }
+
+    const char* position() const { return p_; }
+    const char* end() const { return end_; }
+    std::int64_t record() const { return record_; }
+
+private:
+    const std::string& path_;
+    const char* p_;
+    const char* end_;
+    std::int64_t record_ = 0;
+};
+
+int resolve_threads(int num_threads)
+{
+    return num_threads > 0 ? num_threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Parse `rows` records of [body, end) with row(r, parser), in parallel. The
+// byte range is split into chunks that start on line boundaries; a counting
+// pass turns per-chunk record counts into each chunk's first row.
+template <typename RowFn>
+void parse_records(const std::string& path, const char* body, const char* end, std::int64_t rows,
+                   std::int64_t first_record, int num_threads, RowFn&& row)
+{
+    if (rows <= 0) return;
+    const std::size_t bytes = static_cast<std::size_t>(end - body);
+    auto align = [&](std::size_t at) -> const char* {
+        if (at == 0 || at >= bytes) return body + std::min(at, bytes);
+        const void* nl = std::memchr(body + at - 1, '\n', bytes - at + 1);
+        return nl ? static_cast<const char*>(nl) + 1 : end;
+    };
+
+    num_threads = resolve_threads(num_threads);
+    std::vector<std::int64_t> start(static_cast<std::size_t>(num_threads) + 1, 0);
+    const std::size_t chunks = parallel_chunks(bytes, kMinChunkBytes, num_threads,
+        [&](std::size_t c, std::size_t begin, std::size_t stop) {
+            const char* p = align(begin);
+            const char* e = align(stop);
+            const char *line, *line_end;
+            std::int64_t count = 0;
+            while (next_record(p, e, line, line_end)) ++count;
+            start[c + 1] = count;
+        });
+    for (std::size_t c = 0; c < chunks; ++c) start[c + 1] += start[c];
+    if (start[chunks] < rows)
+        throw std::runtime_error(path + ": header announces " + std::to_string(rows) + " records, found " +
+                                 std::to_string(start[chunks]));
+
+    parallel_chunks(bytes, kMinChunkBytes, num_threads, [&](std::size_t c, std::size_t begin, std::size_t stop) {
+        const char* p = align(begin);
+        const char* e = align(stop);
+        const char *line, *line_end;
+        for (std::int64_t r = start[c]; r < rows && next_record(p, e, line, line_end); ++r) {
+            RecordParser parser(path, first_record + r, line, line_end);
+            row(r, parser);
+        }
+    });
+}
+
+std::int64_t header_count(RecordParser& header, const char* what)
+{
+    const std::int64_t n = header.get<std::int64_t>(what);
+    if (n < 0 || n > std::numeric_limits<int>::max()) header.fail(std::string("invalid ") + what);
+    return n;
+}
+
+// ---------- formatting ----------
+
+void put(std::string& out, std::int64_t value)
+{
+    char buf[24];
+    const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, r.ptr);
+}
+
+void put(std::string& out, int value)
+{
+    put(out, static_cast<std::int64_t>(value));
+}
+
+void put(std::string& out, double value)
+{
+    char buf[32];
+#if defined(__cpp_lib_to_chars)
+    const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, r.ptr);
+#else
+    const int n = std::snprintf(buf, sizeof(buf), "%.17g", value);
+    out.append(buf, static_cast<std::size_t>(n));
+#endif
+}
+
+// Write `rows` records, formatted in parallel batches by row(r, out)
+template <typename RowFn>
+void write_records(detail::OutFile& f, std::int64_t rows, int num_threads, RowFn&& row)
+{
+    std::vector<std::string> chunks(static_cast<std::size_t>(resolve_threads(num_threads)));
+    for (std::int64_t first = 0; first < rows; first += static_cast<std::int64_t>(kRowsPerBatch)) {
+        const std::size_t n = static_cast<std::size_t>(std::min<std::int64_t>(kRowsPerBatch, rows - first));
+        const std::size_t used = parallel_chunks(n, kMinChunkRows, static_cast<int>(chunks.size()),
+            [&](std::size_t c, std::size_t begin, std::size_t stop) {
+                std::string& out = chunks[c];
+                out.clear();
+                for (std::size_t i = begin; i < stop; ++i) row(first + static_cast<std::int64_t>(i), out);
+            });
+        for (std::size_t c = 0; c < used; ++c) f.write(chunks[c]);
+    }
+}
+
+const char kSignature[] = "# Generated by dtcc-tetgen-wrapper\n";
+
+// Like TetGen, tell a .poly file from a .smesh file by its extension
+bool is_poly(const std::string& path)
+{
+    return path.size() >= 5 && path.compare(path.size() - 5, 5, ".poly") == 0;
+}
+
+}  // namespace
+
+// ===================== Readers =====================
+
+TetgenNodes read_tetgen_node(const std::string& path, int num_threads)
+{
+    detail::MappedFile file(path);
+    RecordCursor cursor(path, file);
+    RecordParser header = cursor.next("the .node header");
+
+    TetgenNodes nodes;
+    nodes.count = header_count(header, "number of points");
+    int dim = 3, flag = 0;
+    header.next(dim);
+    header.next(nodes.num_attributes);
+    header.next(flag);
+    if (dim != 3) header.fail("only 3D .node files are supported");
+    if (nodes.num_attributes < 0) header.fail("invalid number of attributes");
+
+    const std::size_t N = static_cast<std::size_t>(nodes.count);
+    const std::size_t A = static_cast<std::size_t>(nodes.num_attributes);
+    nodes.points.resize(3 * N);
+    nodes.attributes.resize(A * N);
+    if (flag) nodes.markers.resize(N);
+
+    // The first record's number is TetGen's firstnumber
+    if (N > 0) {
+        const char* p = cursor.position();
+        const char *line, *line_end;
+        if (next_record(p, cursor.end(), line, line_end))
+            nodes.first_index = RecordParser(path, 1, line, line_end).get<int>("point index");
+    }
+
+    parse_records(path, cursor.position(), cursor.end(), nodes.count, cursor.record(), num_threads,
+        [&](std::int64_t r, RecordParser& rec) {
+            const std::size_t i = static_cast<std::size_t>(r);
+            rec.get<std::int64_t>("point index");
+            for (int k = 0; k < 3; ++k) nodes.points[3 * i + k] = rec.get<double>("coordinate");
+            for (std::size_t k = 0; k < A; ++k) nodes.attributes[A * i + k] = rec.get<double>("attribute");
+            if (flag) nodes.markers[i] = rec.get<int>("boundary marker");
+        });
+    return nodes;
+}
+
+TetgenElements read_tetgen_ele(const std::string& path, int first_index, int num_threads)
+{
+    detail::MappedFile file(path);
+    RecordCursor cursor(path, file);
+    RecordParser header = cursor.next("the .ele header");
+
+    TetgenElements ele;
+    ele.count = header_count(header, "number of tetrahedra");
+    header.next(ele.corners);
+    header.next(ele.num_attributes);
+    if (ele.corners != 4 && ele.corners != 10) header.fail("nodes per tetrahedron must be 4 or 10");
+    if (ele.num_attributes < 0) header.fail("invalid number of attributes");
+
+    const std::size_t K = static_cast<std::size_t>(ele.count);
+    const std::size_t C = static_cast<std::size_t>(ele.corners);
+    const std::size_t A = static_cast<std::size_t>(ele.num_attributes);
+    ele.tets.resize(C * K);
+    ele.attributes.resize(A * K);
+
+    if (first_index < 0 && K > 0) {
+        const char* p = cursor.position();
+        const char *line, *line_end;
+        if (next_record(p, cursor.end(), line, line_end))
+            first_index = RecordParser(path, 1, line, line_end).get<int>("tetrahedron index");
+    }
+
+    parse_records(path, cursor.position(), cursor.end(), ele.count, cursor.record(), num_threads,
+        [&](std::int64_t r, RecordParser& rec) {
+            const std::size_t i = static_cast<std::size_t>(r);
+            rec.get<std::int64_t>("tetrahedron index");
+            for (std::size_t k = 0; k < C; ++k) ele.tets[C * i + k] = rec.node(first_index);
+            for (std::size_t k = 0; k < A; ++k) ele.attributes[A * i + k] = rec.get<double>("attribute");
+        });
+    return ele;
+}
+
+TetgenFaces read_tetgen_face(const std::string& path, int first_index, int num_threads)
+{
+    detail::MappedFile file(path);
+    RecordCursor cursor(path, file);
+    RecordParser header = cursor.next("the .face header");
+
+    TetgenFaces faces;
+    faces.count = header_count(header, "number of faces");
+    int flag = 0;
+    header.next(flag);
+
+    const std::size_t F = static_cast<std::size_t>(faces.count);
+    faces.faces.resize(3 * F);
+    if (flag) faces.markers.resize(F);
+
+    if (first_index < 0 && F > 0) {
+        const char* p = cursor.position();
+        const char *line, *line_end;
+        if (next_record(p, cursor.end(), line, line_end))
+            first_index = RecordParser(path, 1, line, line_end).get<int>("face index");
+    }
+
+    // Extra columns (adjacent tets with -nn) are ignored
+    parse_records(path, cursor.position(), cursor.end(), faces.count, cursor.record(), num_threads,
+        [&](std::int64_t r, RecordParser& rec) {
+            const std::size_t i = static_cast<std::size_t>(r);
+            rec.get<std::int64_t>("face index");
+            for (int k = 0; k < 3; ++k) faces.faces[3 * i + k] = rec.node(first_index);
+            if (flag) faces.markers[i] = rec.get<int>("boundary marker");
+        });
+    return faces;
+}
+
+std::vector<int> read_tetgen_neigh(const std::string& path, int first_index, int num_threads)
+{
+    detail::MappedFile file(path);
+    RecordCursor cursor(path, file);
+    RecordParser header = cursor.next("the .neigh header");
+
+    const std::int64_t count = header_count(header, "number of tetrahedra");
+    int per_tet = 4;
+    header.next(per_tet);
+    if (per_tet != 4) header.fail("expected 4 neighbors per tetrahedron");
+
+    std::vector<int> neighbors(4 * static_cast<std::size_t>(count));
+    if (first_index < 0 && count > 0) {
+        const char* p = cursor.position();
+        const char *line, *line_end;
+        if (next_record(p, cursor.end(), line, line_end))
+            first_index = RecordParser(path, 1, line, line_end).get<int>("tetrahedron index");
+    }
+
+    parse_records(path, cursor.position(), cursor.end(), count, cursor.record(), num_threads,
+        [&](std::int64_t r, RecordParser& rec) {
+            const std::size_t i = static_cast<std::size_t>(r);
+            rec.get<std::int64_t>("tetrahedron index");
+            for (int k = 0; k < 4; ++k) {
+                const int v = rec.get<int>("neighbor");
+                neighbors[4 * i + k] = v == -1 ? -1 : v - first_index;
+                if (v != -1 && (v < first_index || v - first_index >= count)) rec.fail("neighbor index out of range");
+            }
+        });
+    return neighbors;
+}
+
+TetgenSmesh read_tetgen_smesh(const std::string& path, int first_index)
+{
+    detail::MappedFile file(path);
+    RecordCursor cursor(path, file);
+    TetgenSmesh smesh;
+
+    // Part 1: nodes, inline or (count 0) in a separate .node file
+    RecordParser header = cursor.next("the node list header");
+    TetgenNodes& nodes = smesh.nodes;
+    nodes.count = header_count(header, "number of points");
+    int dim = 3, flag = 0;
+    header.next(dim);
+    header.next(nodes.num_attributes);
+    header.next(flag);
+    if (dim != 3) header.fail("only 3D .smesh files are supported");
+    const std::size_t A = static_cast<std::size_t>(std::max(0, nodes.num_attributes));
+    for (std::int64_t i = 0; i < nodes.count; ++i) {
+        RecordParser rec = cursor.next("a point");
+        const int index = rec.get<int>("point index");
+        if (i == 0) nodes.first_index = index;
+        for (int k = 0; k < 3; ++k) nodes.points.push_back(rec.get<double>("coordinate"));
+        for (std::size_t k = 0; k < A; ++k) nodes.attributes.push_back(rec.get<double>("attribute"));
+        if (flag) nodes.markers.push_back(rec.get<int>("boundary marker"));
+    }
+    if (first_index < 0) {
+        if (nodes.count == 0)
+            throw std::runtime_error(path + ": nodes are in a separate .node file; pass its first index");
+        first_index = nodes.first_index;
+    }
+    const std::int64_t num_nodes = nodes.count > 0 ? nodes.count : -1;
+
+    // Part 2: facets, one polygon per record in a .smesh file; in a .poly
+    // file a record with the polygon and hole counts precedes the polygons
+    const bool poly = is_poly(path);
+    header = cursor.next("the facet list header");
+    const std::int64_t facets = header_count(header, "number of facets");
+    flag = 0;
+    header.next(flag);
+    smesh.facet_offsets.reserve(static_cast<std::size_t>(facets) + 1);
+    for (std::int64_t i = 0; i < facets; ++i) {
+        int marker = 0;
+        if (poly) {
+            RecordParser facet = cursor.next("a facet");
+            const int polygons = facet.get<int>("number of polygons");
+            int facet_holes = 0;
+            facet.next(facet_holes);
+            if (flag) facet.next(marker);
+            if (polygons != 1 || facet_holes != 0)
+                facet.fail("only facets of one polygon without holes are supported");
+        }
+        RecordParser rec = cursor.next(poly ? "a polygon" : "a facet");
+        const int corners = rec.get<int>("number of corners");
+        if (corners < 1) rec.fail("facet without corners");
+        for (int k = 0; k < corners; ++k) smesh.facet_indices.push_back(rec.node(first_index, num_nodes));
+        smesh.facet_offsets.push_back(static_cast<std::int64_t>(smesh.facet_indices.size()));
+        if (flag) smesh.facet_markers.push_back(poly ? marker : rec.get<int>("boundary marker"));
+    }
+
+    // Parts 3 and 4 (holes, regions) are optional at the end of the file
+    RecordParser rec(path, 0, nullptr, nullptr);
+    if (cursor.try_next(rec)) {
+        const std::int64_t holes = header_count(rec, "number of holes");
+        for (std::int64_t i = 0; i < holes; ++i) {
+            RecordParser hole = cursor.next("a hole");
+            hole.get<int>("hole index");
+            for (int k = 0; k < 3; ++k) smesh.holes.push_back(hole.get<double>("coordinate"));
+        }
+    }
+    if (cursor.try_next(rec)) {
+        const std::int64_t regions = header_count(rec, "number of regions");
+        for (std::int64_t i = 0; i < regions; ++i) {
+            RecordParser region = cursor.next("a region");
+            region.get<int>("region index");
+            for (int k = 0; k < 4; ++k) smesh.regions.push_back(region.get<double>("region value"));
+            double volume = -1.0;
+            region.next(volume);
+            smesh.regions.push_back(volume);
+        }
+    }
+    return smesh;
+}
+
+// ===================== Writers =====================
+
+void write_tetgen_node(const std::string& path, const double* points, std::int64_t count,
+                       const double* attributes, int num_attributes, const int* markers,
+                       int first_index, int num_threads)
+{
+    const int A = attributes ? num_attributes : 0;
+    detail::OutFile f(path);
+    std::string header;
+    put(header, count);
+    header += "  3  ";
+    put(header, A);
+    header += markers ? "  1\n" : "  0\n";
+    f.write(header);
+    write_records(f, count, num_threads, [&](std::int64_t i, std::string& out) {
+        put(out, i + first_index);
+        for (int k = 0; k < 3; ++k) {
+            out += "  ";
+            put(out, points[3 * i + k]);
+        }
+        for (int k = 0; k < A; ++k) {
+            out += "  ";
+            put(out, attributes[A * i + k]);
+        }
+        if (markers) {
+            out += "  ";
+            put(out, markers[i]);
+        }
+        out += '\n';
+    });
+    f.write(kSignature);
+    f.close();
+}
+
+void write_tetgen_ele(const std::string& path, const int* tets, std::int64_t count, int corners,
+                      const double* attributes, int num_attributes, int first_index, int num_threads)
+{
+    if (corners != 4 && corners != 10) throw std::runtime_error("write_tetgen_ele: corners must be 4 or 10");
+    const int A = attributes ? num_attributes : 0;
+    detail::OutFile f(path);
+    std::string header;
+    put(header, count);
+    header += "  ";
+    put(header, corners);
+    header += "  ";
+    put(header, A);
+    header += '\n';
+    f.write(header);
+    write_records(f, count, num_threads, [&](std::int64_t i, std::string& out) {
+        put(out, i + first_index);
+        for (int k = 0; k < corners; ++k) {
+            out += "  ";
+            put(out, tets[corners * i + k] + first_index);
+        }
+        for (int k = 0; k < A; ++k) {
+            out += "  ";
+            put(out, attributes[A * i + k]);
+        }
+        out += '\n';
+    });
+    f.write(kSignature);
+    f.close();
+}
+
+void write_tetgen_face(const std::string& path, const int* faces, std::int64_t count, const int* markers,
+                       int first_index, int num_threads)
+{
+    detail::OutFile f(path);
+    std::string header;
+    put(header, count);
+    header += markers ? "  1\n" : "  0\n";
+    f.write(header);
+    write_records(f, count, num_threads, [&](std::int64_t i, std::string& out) {
+        put(out, i + first_index);
+        for (int k = 0; k < 3; ++k) {
+            out += "  ";
+            put(out, faces[3 * i + k] + first_index);
+        }
+        if (markers) {
+            out += "  ";
+            put(out, markers[i]);
+        }
+        out += '\n';
+    });
+    f.write(kSignature);
+    f.close();
+}
+
+void write_tetgen_neigh(const std::string& path, const int* neighbors, std::int64_t count, int first_index,
+                        int num_threads)
+{
+    detail::OutFile f(path);
+    std::string header;
+    put(header, count);
+    header += "  4\n";
+    f.write(header);
+    write_records(f, count, num_threads, [&](std::int64_t i, std::string& out) {
+        put(out, i + first_index);
+        for (int k = 0; k < 4; ++k) {
+            const int v = neighbors[4 * i + k];
+            out += "  ";
+            put(out, v < 0 ? -1 : v + first_index);
+        }
+        out += '\n';
+    });
+    f.write(kSignature);
+    f.close();
+}
+
+void write_tetgen_smesh(const std::string& path, const std::int64_t* facet_offsets, const int* facet_indices,
+                        std::int64_t num_facets, const int* facet_markers, const double* holes,
+                        std::int64_t num_holes, int first_index)
+{
+    const bool poly = is_poly(path);
+    detail::OutFile f(path);
+    std::string out = "# Part 1 - node list (in the .node file)\n0  3  0  0\n# Part 2 - facet list\n";
+    put(out, num_facets);
+    out += facet_markers ? "  1\n" : "  0\n";
+    for (std::int64_t i = 0; i < num_facets; ++i) {
+        if (poly) {
+            // One polygon, no holes, the marker on the facet record
+            out += "1  0";
+            if (facet_markers) {
+                out += "  ";
+                put(out, facet_markers[i]);
+            }
+            out += '\n';
+        }
+        put(out, facet_offsets[i + 1] - facet_offsets[i]);
+        for (std::int64_t j = facet_offsets[i]; j < facet_offsets[i + 1]; ++j) {
+            out += "  ";
+            put(out, facet_indices[j] + first_index);
+        }
+        if (facet_markers && !poly) {
+            out += "  ";
+            put(out, facet_markers[i]);
+        }
+        out += '\n';
+        if (out.size() > kMinChunkBytes) {
+            f.write(out);
+            out.clear();
+        }
+    }
+    out += "# Part 3 - hole list\n";
+    put(out, num_holes);
+    out += '\n';
+    for (std::int64_t i = 0; i < num_holes; ++i) {
+        put(out, i + first_index);
+        for (int k = 0; k < 3; ++k) {
+            out += "  ";
+            put(out, holes[3 * i + k]);
+        }
+        out += '\n';
+    }
+    out += "# Part 4 - region list\n0\n";
+    out += kSignature;
+    f.write(out);
+    f.close();
+}
+
+}  // namespace tetwrap
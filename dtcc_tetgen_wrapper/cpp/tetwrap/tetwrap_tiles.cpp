@@ -0,0 +1,1080 @@
+// Tiled meshing (run_tetgen_tiled): split a box-shaped PLC into XY tiles,
+// mesh them concurrently and stitch the tile meshes into one.
+//
+// Surface facets are clipped at the tile cuts. Every tile is then closed
+// with generated walls and a top, triangulated at the requested spacing;
+// a wall between two tiles is created once and used by both. TetGen runs
+// with -Y, so it keeps those triangles as they are, the tile meshes meet
+// face to face and the merge only has to renumber the shared points.
+#include "tetwrap_core.h"
+#include "tetwrap_detail.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tetwrap {
+
+namespace {
+
+using detail::FaceTable;
+using detail::parallel_chunks;
+using detail::sorted_face;
+
+enum Side { kWest, kEast, kSouth, kNorth, kTop, kSurface };
+
+[[noreturn]] void fail(const std::string& what)
+{
+    throw std::runtime_error("tiled meshing: " + what);
+}
+
+std::string fmt(double v)
+{
+    std::ostringstream os;
+    os << v;
+    return os.str();
+}
+
+// Number of steps of at most `spacing` over `length`
+int steps(double length, double spacing)
+{
+    return std::max(1, static_cast<int>(std::ceil(length / spacing - 1e-9)));
+}
+
+// Point k of m equal steps from a to b, exact at both ends so that walls
+// and tops sharing a line compute identical coordinates
+double step_coord(double a, double b, int k, int m)
+{
+    if (k == 0) return a;
+    if (k == m) return b;
+    return a + (b - a) * k / m;
+}
+
+// Vertical wall on the line x[axis] == c between s0 and s1, where s is the
+// other horizontal coordinate: a tile side on the domain boundary or the
+// interface between two tiles.
+struct Wall {
+    int axis = 0;
+    double c = 0.0, s0 = 0.0, s1 = 0.0;
+    int corner0 = 0, corner1 = 0;               // corners at s0 and s1
+    int marker = 0;
+    bool interface = false;
+    std::vector<std::pair<int, int>> edges;     // surface edges on the wall
+    std::vector<int> profile;                   // the same, chained from s0 to s1
+    int columns = 1;
+    std::vector<double> base;                   // (columns+1,) height the first layer builds on
+    std::vector<int> ids;                       // (columns-1, layers) inner column vertices
+    std::vector<int> triangles;                 // (T,3)
+};
+
+// Tile corner; its column is shared by every wall that ends there
+struct Corner {
+    double x = 0.0, y = 0.0;
+    int ground = -1;                            // surface vertex at the corner
+    double base = -std::numeric_limits<double>::infinity();
+    std::vector<int> ids;                       // (layers,) vertices above the ground
+};
+
+// Decomposition of a PLC into tile PLCs
+class Tiler {
+public:
+    Tiler(const PlcInput& plc, const TileOptions& options);
+
+    int tiles_x = 1, tiles_y = 1;
+    std::vector<double> V;                      // (G,3) input vertices, then generated ones
+    int num_input = 0;
+    std::vector<PlcBundle> tiles;
+    std::vector<std::vector<int>> tile_ids;     // tile vertex -> global vertex
+    std::vector<int> interface_triangles;       // (I,3) global ids
+
+private:
+    void classify_boundary();
+    std::vector<double> choose_cuts(int axis, double lo, double hi, int count) const;
+    void polygon(int source, std::vector<int>& ids) const;
+    int side_of(int v, int axis, double c);
+    int cut_point(int a, int b, int axis, double c, int plane);
+    void split(const std::vector<int>& poly, int axis, double c, int plane,
+               std::vector<int>& below, std::vector<int>& above);
+    void clip(int source, const std::vector<int>& ids);
+    void add_piece(int tile, int source, const std::vector<int>& ids);
+    void build_walls();
+    void collect_edges();
+    void chain_profile(Wall& w);
+    double profile_max(const Wall& w, double lo, double hi) const;
+    double median_edge() const;
+    int add_vertex(double x, double y, double z);
+    int column(const Wall& w, int c, int k) const;
+    void zip(Wall& w, const std::vector<int>& upper);
+    void build_geometry(double spacing);
+    void assemble();
+
+    int tile(int ix, int iy) const { return iy * tiles_x + ix; }
+    int x_wall(int ix, int iy) const { return ix * tiles_y + iy; }
+    int y_wall(int iy, int ix) const { return (tiles_x + 1) * tiles_y + iy * tiles_x + ix; }
+    int corner(int ix, int iy) const { return iy * (tiles_x + 1) + ix; }
+    double s_of(const Wall& w, int v) const { return V[3 * static_cast<std::size_t>(v) + 1 - w.axis]; }
+    double z_of(int v) const { return V[3 * static_cast<std::size_t>(v) + 2]; }
+    bool on_wall(const Wall& w, int v) const
+    {
+        return std::abs(V[3 * static_cast<std::size_t>(v) + w.axis] - w.c) <= tol_;
+    }
+    int source_marker(int source) const;
+
+    const PlcInput& plc_;
+    int M_ = 0, B_ = 0;
+    double lo_[3] = {0, 0, 0}, hi_[3] = {0, 0, 0};
+    double tol_ = 0.0;
+    std::vector<Side> role_;                    // per boundary polygon
+    int side_marker_[5] = {-1, -1, -1, -1, -1};
+    int interface_marker_ = 0;
+    std::vector<int> top_vertices_;             // vertices of the top polygons
+    std::vector<double> X_, Y_;                 // tile lines, domain sides included
+    int layers_ = 1;
+
+    std::vector<std::vector<int>> whole_;       // per tile: uncut sources
+    std::vector<std::vector<int>> pieces_of_;   // per tile: clipped pieces
+    std::vector<std::int64_t> piece_offsets_{0};
+    std::vector<int> piece_ids_;
+    std::vector<int> piece_source_;
+    std::vector<std::unordered_map<std::uint64_t, int>> cut_cache_;
+    std::vector<int> sides_;                    // scratch for split()
+
+    std::vector<Wall> walls_;
+    std::vector<Corner> corners_;
+    std::vector<std::vector<int>> tops_;        // per tile: top triangles (T,3)
+};
+
+Tiler::Tiler(const PlcInput& plc, const TileOptions& options)
+    : tiles_x(options.tiles_x), tiles_y(options.tiles_y), plc_(plc)
+{
+    if (tiles_x < 1 || tiles_y < 1) fail("tiles_x and tiles_y must be at least 1");
+    M_ = plc.mesh_facets.count;
+    B_ = plc.boundary_facets.count;
+    num_input = plc.num_vertices;
+    const std::size_t N = static_cast<std::size_t>(num_input);
+    V.resize(3 * N);
+    if (plc.vertices) std::copy(plc.vertices, plc.vertices + 3 * N, V.begin());
+    else std::copy(plc.vertices_f32, plc.vertices_f32 + 3 * N, V.begin());
+
+    for (int a = 0; a < 3; ++a) {
+        lo_[a] = std::numeric_limits<double>::infinity();
+        hi_[a] = -lo_[a];
+    }
+    for (std::size_t i = 0; i < N; ++i)
+        for (int a = 0; a < 3; ++a) {
+            lo_[a] = std::min(lo_[a], V[3 * i + a]);
+            hi_[a] = std::max(hi_[a], V[3 * i + a]);
+        }
+    const double extent = std::max({hi_[0] - lo_[0], hi_[1] - lo_[1], hi_[2] - lo_[2]});
+    if (!(extent > 0.0)) fail("the PLC has no extent");
+    tol_ = 1e-7 * extent;
+
+    classify_boundary();
+    const std::vector<double> cx = choose_cuts(0, lo_[0], hi_[0], tiles_x);
+    const std::vector<double> cy = choose_cuts(1, lo_[1], hi_[1], tiles_y);
+    X_.push_back(lo_[0]);
+    X_.insert(X_.end(), cx.begin(), cx.end());
+    X_.push_back(hi_[0]);
+    Y_.push_back(lo_[1]);
+    Y_.insert(Y_.end(), cy.begin(), cy.end());
+    Y_.push_back(hi_[1]);
+
+    // Surface facets (mesh facets and the boundary polygons that are not
+    // domain sides) go to their tile whole, or clipped at the cuts
+    const int num_tiles = tiles_x * tiles_y;
+    whole_.resize(num_tiles);
+    pieces_of_.resize(num_tiles);
+    cut_cache_.resize(cx.size() + cy.size());
+    std::vector<int> ids;
+    for (int source = 0; source < M_ + B_; ++source) {
+        if (source >= M_ && role_[source - M_] != kSurface) continue;
+        polygon(source, ids);
+        double bmin[2] = {V[3 * static_cast<std::size_t>(ids[0])], V[3 * static_cast<std::size_t>(ids[0]) + 1]};
+        double bmax[2] = {bmin[0], bmin[1]};
+        for (int v : ids)
+            for (int a = 0; a < 2; ++a) {
+                bmin[a] = std::min(bmin[a], V[3 * static_cast<std::size_t>(v) + a]);
+                bmax[a] = std::max(bmax[a], V[3 * static_cast<std::size_t>(v) + a]);
+            }
+        // Number of cuts below a coordinate = tile column / row
+        auto slab = [](const std::vector<double>& cuts, double v) {
+            return static_cast<int>(std::lower_bound(cuts.begin(), cuts.end(), v) - cuts.begin());
+        };
+        const int ix = slab(cx, bmin[0]), iy = slab(cy, bmin[1]);
+        if (ix == slab(cx, bmax[0]) && iy == slab(cy, bmax[1])) whole_[tile(ix, iy)].push_back(source);
+        else clip(source, ids);
+    }
+
+    build_walls();
+    collect_edges();
+    for (Wall& w : walls_) chain_profile(w);
+    build_geometry(options.spacing > 0.0 ? options.spacing : median_edge());
+    assemble();
+}
+
+int Tiler::source_marker(int source) const
+{
+    if (source < M_) return plc_.mesh_facet_markers ? plc_.mesh_facet_markers[source] : -1;
+    const int b = source - M_;
+    return plc_.boundary_facet_markers ? plc_.boundary_facet_markers[b] : b;
+}
+
+// Top polygons lie in the highest z plane, side polygons in one of the
+// vertical bounding box planes; everything else is surface
+void Tiler::classify_boundary()
+{
+    role_.assign(static_cast<std::size_t>(B_), kSurface);
+    std::vector<int> ids;
+    int max_marker = -1;
+    for (int b = 0; b < B_; ++b) {
+        polygon(M_ + b, ids);
+        auto all_at = [&](int axis, double c) {
+            for (int v : ids)
+                if (std::abs(V[3 * static_cast<std::size_t>(v) + axis] - c) > tol_) return false;
+            return true;
+        };
+        Side role = kSurface;
+        if (all_at(2, hi_[2])) role = kTop;
+        else if (all_at(0, lo_[0])) role = kWest;
+        else if (all_at(0, hi_[0])) role = kEast;
+        else if (all_at(1, lo_[1])) role = kSouth;
+        else if (all_at(1, hi_[1])) role = kNorth;
+        role_[static_cast<std::size_t>(b)] = role;
+
+        const int m = source_marker(M_ + b);
+        max_marker = std::max(max_marker, m);
+        if (role == kSurface) continue;
+        if (role == kTop) top_vertices_.insert(top_vertices_.end(), ids.begin(), ids.end());
+        if (side_marker_[role] >= 0 && side_marker_[role] != m)
+            fail("the polygons of one domain side must share a boundary marker");
+        side_marker_[role] = m;
+    }
+    static const char* names[] = {"x-min side", "x-max side", "y-min side", "y-max side", "top"};
+    for (int s = kWest; s <= kTop; ++s)
+        if (side_marker_[s] < 0)
+            fail(std::string("no boundary polygon found on the ") + names[s] +
+                 " of the bounding box; the PLC must describe a box-shaped domain");
+    interface_marker_ = max_marker + 1;
+}
+
+// Cut positions along one axis: the even split points, each moved into a
+// wide gap between vertex coordinates within a quarter tile, so that
+// clipping never passes through (or next to) an input vertex
+std::vector<double> Tiler::choose_cuts(int axis, double lo, double hi, int count) const
+{
+    std::vector<double> coords(static_cast<std::size_t>(num_input));
+    for (std::size_t i = 0; i < coords.size(); ++i) coords[i] = V[3 * i + axis];
+    std::sort(coords.begin(), coords.end());
+    coords.erase(std::unique(coords.begin(), coords.end()), coords.end());
+
+    std::vector<double> cuts;
+    const double width = (hi - lo) / count;
+    for (int k = 1; k < count; ++k) {
+        const double nominal = lo + width * k;
+        const double wlo = nominal - 0.25 * width, whi = nominal + 0.25 * width;
+        std::vector<std::pair<double, double>> candidates;  // (position, clearance)
+        double best = 0.0;
+        std::size_t i = std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::lower_bound(coords.begin(), coords.end(), wlo) - coords.begin()));
+        for (; i < coords.size() && coords[i - 1] <= whi; ++i) {
+            const double a = coords[i - 1], b = coords[i];
+            const double p = std::min(std::max(0.5 * (a + b), wlo), whi);
+            const double clearance = std::min(p - a, b - p);
+            candidates.emplace_back(p, clearance);
+            best = std::max(best, clearance);
+        }
+        if (best < 100.0 * tol_)
+            fail(std::string("no gap between vertex coordinates near ") + (axis ? "y" : "x") + " = " +
+                 fmt(nominal) + " to cut the domain");
+        double cut = nominal, distance = std::numeric_limits<double>::infinity();
+        for (const auto& c : candidates)
+            if (c.second >= 0.5 * best && std::abs(c.first - nominal) < distance) {
+                cut = c.first;
+                distance = std::abs(c.first - nominal);
+            }
+        cuts.push_back(cut);
+    }
+    return cuts;
+}
+
+// Vertex ids of a source polygon: mesh facet `source`, or boundary polygon
+// `source - M`
+void Tiler::polygon(int source, std::vector<int>& ids) const
+{
+    const FacetList& fl = source < M_ ? plc_.mesh_facets : plc_.boundary_facets;
+    const int i = source < M_ ? source : source - M_;
+    const std::int64_t begin = fl.begin(i), end = fl.end(i);
+    ids.clear();
+    if (fl.indices_i64) {
+        for (std::int64_t k = begin; k < end; ++k) ids.push_back(static_cast<int>(fl.indices_i64[k]));
+    } else {
+        ids.assign(fl.indices + begin, fl.indices + end);
+    }
+}
+
+// -1 below, 0 on, +1 above the plane x[axis] == c. Generated points within
+// the tolerance are snapped onto the plane.
+int Tiler::side_of(int v, int axis, double c)
+{
+    double& x = V[3 * static_cast<std::size_t>(v) + axis];
+    if (std::abs(x - c) <= tol_) {
+        if (v >= num_input) x = c;
+        return 0;
+    }
+    return x < c ? -1 : 1;
+}
+
+// Intersection of edge (a, b) with a cut plane, created once per edge so the
+// pieces on both sides (and the neighbouring facet) share it
+int Tiler::cut_point(int a, int b, int axis, double c, int plane)
+{
+    const std::uint64_t key = (static_cast<std::uint64_t>(std::min(a, b)) << 32) |
+                              static_cast<std::uint32_t>(std::max(a, b));
+    auto it = cut_cache_[static_cast<std::size_t>(plane)].find(key);
+    if (it != cut_cache_[static_cast<std::size_t>(plane)].end()) return it->second;
+
+    // Interpolate from the lower id so both orders give the same point
+    if (a > b) std::swap(a, b);
+    const double* pa = &V[3 * static_cast<std::size_t>(a)];
+    const double* pb = &V[3 * static_cast<std::size_t>(b)];
+    const double t = (c - pa[axis]) / (pb[axis] - pa[axis]);
+    double p[3];
+    for (int k = 0; k < 3; ++k) p[k] = pa[k] == pb[k] ? pa[k] : pa[k] + t * (pb[k] - pa[k]);
+    p[axis] = c;
+    const int v = add_vertex(p[0], p[1], p[2]);
+    cut_cache_[static_cast<std::size_t>(plane)].emplace(key, v);
+    return v;
+}
+
+int Tiler::add_vertex(double x, double y, double z)
+{
+    V.push_back(x);
+    V.push_back(y);
+    V.push_back(z);
+    return static_cast<int>(V.size() / 3 - 1);
+}
+
+// Split a convex polygon at the plane x[axis] == c
+void Tiler::split(const std::vector<int>& poly, int axis, double c, int plane,
+                  std::vector<int>& below, std::vector<int>& above)
+{
+    below.clear();
+    above.clear();
+    const std::size_t n = poly.size();
+    sides_.resize(n);
+    int on = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sides_[i] = side_of(poly[i], axis, c);
+        if (sides_[i] == 0) ++on;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j = (i + 1) % n;
+        if (sides_[i] <= 0) below.push_back(poly[i]);
+        if (sides_[i] >= 0) above.push_back(poly[i]);
+        if (sides_[i] * sides_[j] < 0) {
+            const int p = cut_point(poly[i], poly[j], axis, c, plane);
+            below.push_back(p);
+            above.push_back(p);
+            ++on;
+        }
+    }
+    if (on > 2)
+        fail(std::string("a non-convex surface facet crosses the cut at ") + (axis ? "y" : "x") + " = " + fmt(c));
+}
+
+// Cut a facet at every x cut, then every y cut it spans
+void Tiler::clip(int source, const std::vector<int>& ids)
+{
+    const int nx = static_cast<int>(X_.size()) - 2;
+    std::vector<std::vector<int>> strips;
+    std::vector<int> rest, below, above;
+    for (int axis = 0; axis < 2; ++axis) {
+        const std::vector<double>& lines = axis ? Y_ : X_;
+        std::vector<std::vector<int>> input;
+        if (axis == 0) input.push_back(ids);
+        else input.swap(strips);
+        for (std::vector<int>& poly : input) {
+            double lo = std::numeric_limits<double>::infinity(), hi = -lo;
+            for (int v : poly) {
+                lo = std::min(lo, V[3 * static_cast<std::size_t>(v) + axis]);
+                hi = std::max(hi, V[3 * static_cast<std::size_t>(v) + axis]);
+            }
+            rest.swap(poly);
+            for (std::size_t k = 1; k + 1 < lines.size(); ++k) {
+                const double c = lines[k];
+                if (c <= lo + tol_ || c >= hi - tol_) continue;
+                const int plane = axis ? nx + static_cast<int>(k) - 1 : static_cast<int>(k) - 1;
+                split(rest, axis, c, plane, below, above);
+                if (below.size() >= 3) strips.push_back(below);
+                rest.swap(above);
+            }
+            if (rest.size() >= 3) strips.push_back(rest);
+        }
+    }
+
+    // Tile of each piece from its centroid
+    for (const std::vector<int>& piece : strips) {
+        double cxy[2] = {0.0, 0.0};
+        for (int v : piece)
+            for (int a = 0; a < 2; ++a) cxy[a] += V[3 * static_cast<std::size_t>(v) + a];
+        const double n = static_cast<double>(piece.size());
+        const int ix = static_cast<int>(std::upper_bound(X_.begin() + 1, X_.end() - 1, cxy[0] / n) - X_.begin()) - 1;
+        const int iy = static_cast<int>(std::upper_bound(Y_.begin() + 1, Y_.end() - 1, cxy[1] / n) - Y_.begin()) - 1;
+        add_piece(tile(ix, iy), source, piece);
+    }
+}
+
+void Tiler::add_piece(int t, int source, const std::vector<int>& ids)
+{
+    pieces_of_[static_cast<std::size_t>(t)].push_back(static_cast<int>(piece_source_.size()));
+    piece_source_.push_back(source);
+    piece_ids_.insert(piece_ids_.end(), ids.begin(), ids.end());
+    piece_offsets_.push_back(static_cast<std::int64_t>(piece_ids_.size()));
+}
+
+void Tiler::build_walls()
+{
+    corners_.resize(static_cast<std::size_t>((tiles_x + 1) * (tiles_y + 1)));
+    for (int iy = 0; iy <= tiles_y; ++iy)
+        for (int ix = 0; ix <= tiles_x; ++ix) {
+            corners_[static_cast<std::size_t>(corner(ix, iy))].x = X_[static_cast<std::size_t>(ix)];
+            corners_[static_cast<std::size_t>(corner(ix, iy))].y = Y_[static_cast<std::size_t>(iy)];
+        }
+
+    walls_.resize(static_cast<std::size_t>((tiles_x + 1) * tiles_y + (tiles_y + 1) * tiles_x));
+    for (int ix = 0; ix <= tiles_x; ++ix)
+        for (int iy = 0; iy < tiles_y; ++iy) {
+            Wall& w = walls_[static_cast<std::size_t>(x_wall(ix, iy))];
+            w.axis = 0;
+            w.c = X_[static_cast<std::size_t>(ix)];
+            w.s0 = Y_[static_cast<std::size_t>(iy)];
+            w.s1 = Y_[static_cast<std::size_t>(iy) + 1];
+            w.corner0 = corner(ix, iy);
+            w.corner1 = corner(ix, iy + 1);
+            w.interface = ix > 0 && ix < tiles_x;
+            w.marker = w.interface ? interface_marker_ : side_marker_[ix == 0 ? kWest : kEast];
+        }
+    for (int iy = 0; iy <= tiles_y; ++iy)
+        for (int ix = 0; ix < tiles_x; ++ix) {
+            Wall& w = walls_[static_cast<std::size_t>(y_wall(iy, ix))];
+            w.axis = 1;
+            w.c = Y_[static_cast<std::size_t>(iy)];
+            w.s0 = X_[static_cast<std::size_t>(ix)];
+            w.s1 = X_[static_cast<std::size_t>(ix) + 1];
+            w.corner0 = corner(ix, iy);
+            w.corner1 = corner(ix + 1, iy);
+            w.interface = iy > 0 && iy < tiles_y;
+            w.marker = w.interface ? interface_marker_ : side_marker_[iy == 0 ? kSouth : kNorth];
+        }
+}
+
+// Surface edges lying on each tile side
+void Tiler::collect_edges()
+{
+    std::vector<int> ids;
+    for (int iy = 0; iy < tiles_y; ++iy)
+        for (int ix = 0; ix < tiles_x; ++ix) {
+            const int t = tile(ix, iy);
+            Wall* sides[4] = {&walls_[static_cast<std::size_t>(x_wall(ix, iy))],
+                              &walls_[static_cast<std::size_t>(x_wall(ix + 1, iy))],
+                              &walls_[static_cast<std::size_t>(y_wall(iy, ix))],
+                              &walls_[static_cast<std::size_t>(y_wall(iy + 1, ix))]};
+            auto scan = [&](const int* poly, std::size_t n, bool clipped) {
+                for (Wall* w : sides) {
+                    // Uncut facets cannot touch a cut
+                    if (w->interface && !clipped) continue;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        const int a = poly[i], b = poly[(i + 1) % n];
+                        if (on_wall(*w, a) && on_wall(*w, b)) w->edges.emplace_back(std::min(a, b), std::max(a, b));
+                    }
+                }
+            };
+            for (int source : whole_[static_cast<std::size_t>(t)]) {
+                polygon(source, ids);
+                scan(ids.data(), ids.size(), false);
+            }
+            for (int p : pieces_of_[static_cast<std::size_t>(t)]) {
+                const std::int64_t b = piece_offsets_[static_cast<std::size_t>(p)];
+                scan(&piece_ids_[static_cast<std::size_t>(b)],
+                     static_cast<std::size_t>(piece_offsets_[static_cast<std::size_t>(p) + 1] - b), true);
+            }
+        }
+}
+
+// Chain the wall's surface edges into one path from s0 to s1 along which s
+// never decreases (vertical runs such as building walls are fine)
+void Tiler::chain_profile(Wall& w)
+{
+    const std::string where = std::string(w.axis ? "y" : "x") + " = " + fmt(w.c) + " (" + (w.axis ? "x" : "y") +
+                              " " + fmt(w.s0) + " .. " + fmt(w.s1) + ")";
+    std::sort(w.edges.begin(), w.edges.end());
+    w.edges.erase(std::unique(w.edges.begin(), w.edges.end()), w.edges.end());
+    if (w.edges.empty()) fail("no surface edges along " + where);
+
+    std::vector<std::pair<int, int>> adj;
+    adj.reserve(2 * w.edges.size());
+    for (const auto& e : w.edges) {
+        adj.emplace_back(e.first, e.second);
+        adj.emplace_back(e.second, e.first);
+    }
+    std::sort(adj.begin(), adj.end());
+    auto neighbors = [&](int v) {
+        const auto first = std::lower_bound(adj.begin(), adj.end(), std::make_pair(v, std::numeric_limits<int>::min()));
+        auto last = first;
+        while (last != adj.end() && last->first == v) ++last;
+        return std::make_pair(first, last);
+    };
+
+    const std::string not_profile = "the surface along " + where + " is not a single 2.5D profile";
+    int start = -1;
+    for (std::size_t i = 0; i < adj.size();) {
+        const auto range = neighbors(adj[i].first);
+        const std::ptrdiff_t degree = range.second - range.first;
+        if (degree > 2) fail(not_profile);
+        if (degree == 1 && (start < 0 || s_of(w, adj[i].first) < s_of(w, start))) start = adj[i].first;
+        i += static_cast<std::size_t>(degree);
+    }
+    if (start < 0 || std::abs(s_of(w, start) - w.s0) > tol_) fail(not_profile);
+
+    w.profile.assign(1, start);
+    for (int prev = -1, cur = start;;) {
+        int next = -1;
+        const auto range = neighbors(cur);
+        for (auto it = range.first; it != range.second; ++it)
+            if (it->second != prev) next = it->second;
+        if (next < 0) break;
+        if (s_of(w, next) < s_of(w, cur) - tol_) fail(not_profile);
+        w.profile.push_back(next);
+        prev = cur;
+        cur = next;
+    }
+    if (w.profile.size() != w.edges.size() + 1 || std::abs(s_of(w, w.profile.back()) - w.s1) > tol_)
+        fail(not_profile);
+
+    for (int end = 0; end < 2; ++end) {
+        Corner& c = corners_[static_cast<std::size_t>(end ? w.corner1 : w.corner0)];
+        const int v = end ? w.profile.back() : w.profile.front();
+        if (c.ground >= 0 && c.ground != v)
+            fail("the surface is not closed at (" + fmt(c.x) + ", " + fmt(c.y) + ")");
+        c.ground = v;
+    }
+}
+
+// Highest profile point over [lo, hi]
+double Tiler::profile_max(const Wall& w, double lo, double hi) const
+{
+    double m = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i + 1 < w.profile.size(); ++i) {
+        const double sa = s_of(w, w.profile[i]), sb = s_of(w, w.profile[i + 1]);
+        const double za = z_of(w.profile[i]), zb = z_of(w.profile[i + 1]);
+        if (sb < lo || sa > hi) continue;
+        if (sb - sa <= 0.0) {
+            m = std::max({m, za, zb});
+            continue;
+        }
+        const double ta = std::max(lo, sa), tb = std::min(hi, sb);
+        m = std::max({m, za + (zb - za) * (ta - sa) / (sb - sa), za + (zb - za) * (tb - sa) / (sb - sa)});
+    }
+    return m;
+}
+
+// Median edge length of the surface facets
+double Tiler::median_edge() const
+{
+    std::vector<double> lengths;
+    std::vector<int> ids;
+    for (int source = 0; source < M_ + B_; ++source) {
+        if (source >= M_ && role_[static_cast<std::size_t>(source - M_)] != kSurface) continue;
+        polygon(source, ids);
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            const double* a = &V[3 * static_cast<std::size_t>(ids[i])];
+            const double* b = &V[3 * static_cast<std::size_t>(ids[(i + 1) % ids.size()])];
+            lengths.push_back(std::sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) +
+                                        (a[2] - b[2]) * (a[2] - b[2])));
+        }
+    }
+    if (lengths.empty()) fail("no surface facets");
+    std::nth_element(lengths.begin(), lengths.begin() + static_cast<std::ptrdiff_t>(lengths.size() / 2), lengths.end());
+    return lengths[lengths.size() / 2];
+}
+
+// Vertex of column c (0..columns) at layer k (1..layers)
+int Tiler::column(const Wall& w, int c, int k) const
+{
+    if (c == 0) return corners_[static_cast<std::size_t>(w.corner0)].ids[static_cast<std::size_t>(k - 1)];
+    if (c == w.columns) return corners_[static_cast<std::size_t>(w.corner1)].ids[static_cast<std::size_t>(k - 1)];
+    return w.ids[static_cast<std::size_t>((c - 1) * layers_ + k - 1)];
+}
+
+// Triangulate the strip between the profile and the first layer: advance
+// along whichever chain comes next in s, unless its triangle would be
+// inverted in the (s, z) plane (at vertical profile runs)
+void Tiler::zip(Wall& w, const std::vector<int>& upper)
+{
+    auto orient = [&](int a, int b, int c) {
+        return (s_of(w, b) - s_of(w, a)) * (z_of(c) - z_of(a)) - (z_of(b) - z_of(a)) * (s_of(w, c) - s_of(w, a));
+    };
+    const std::vector<int>& lower = w.profile;
+    std::size_t i = 0, j = 0;
+    while (i + 1 < lower.size() || j + 1 < upper.size()) {
+        const bool can_lower = i + 1 < lower.size() && orient(lower[i], lower[i + 1], upper[j]) > 0.0;
+        const bool can_upper = j + 1 < upper.size() && orient(lower[i], upper[j + 1], upper[j]) > 0.0;
+        if (!can_lower && !can_upper)
+            fail("cannot close the wall at " + std::string(w.axis ? "y" : "x") + " = " + fmt(w.c) +
+                 " above the surface; try a smaller spacing");
+        const bool take_lower = can_lower && (!can_upper || s_of(w, lower[i + 1]) <= s_of(w, upper[j + 1]));
+        if (take_lower) {
+            w.triangles.insert(w.triangles.end(), {lower[i], lower[i + 1], upper[j]});
+            ++i;
+        } else {
+            w.triangles.insert(w.triangles.end(), {lower[i], upper[j + 1], upper[j]});
+            ++j;
+        }
+    }
+}
+
+// Wall columns, layers and tops. The first layer of every column sits just
+// above the highest surface point next to it; all columns share the layer
+// count so that walls meeting at a corner agree.
+void Tiler::build_geometry(double spacing)
+{
+    if (!(spacing > 0.0)) fail("spacing must be positive");
+    const double top = hi_[2];
+    double ground = std::numeric_limits<double>::infinity();
+    for (const Wall& w : walls_)
+        for (int v : w.profile) ground = std::min(ground, z_of(v));
+    layers_ = steps(top - ground, spacing);
+
+    for (Wall& w : walls_) {
+        w.columns = steps(w.s1 - w.s0, spacing);
+        const int m = w.columns;
+        w.base.resize(static_cast<std::size_t>(m) + 1);
+        for (int c = 0; c <= m; ++c)
+            w.base[static_cast<std::size_t>(c)] = profile_max(w, step_coord(w.s0, w.s1, std::max(c - 1, 0), m),
+                                                              step_coord(w.s0, w.s1, std::min(c + 1, m), m));
+        for (int end = 0; end < 2; ++end) {
+            Corner& c = corners_[static_cast<std::size_t>(end ? w.corner1 : w.corner0)];
+            c.base = std::max(c.base, w.base[end ? static_cast<std::size_t>(m) : 0]);
+        }
+    }
+
+    // Column vertices: corners first (the domain corners reuse the top
+    // polygons' corner vertices), then the inner columns of every wall
+    auto check_base = [&](double base, double x, double y) {
+        if (base >= top - tol_)
+            fail("the surface reaches the top of the domain at (" + fmt(x) + ", " + fmt(y) + ")");
+    };
+    for (int iy = 0; iy <= tiles_y; ++iy)
+        for (int ix = 0; ix <= tiles_x; ++ix) {
+            Corner& c = corners_[static_cast<std::size_t>(corner(ix, iy))];
+            check_base(c.base, c.x, c.y);
+            c.ids.resize(static_cast<std::size_t>(layers_));
+            for (int k = 1; k <= layers_; ++k)
+                c.ids[static_cast<std::size_t>(k - 1)] = -1;
+            if ((ix == 0 || ix == tiles_x) && (iy == 0 || iy == tiles_y)) {
+                for (int v : top_vertices_)
+                    if (std::abs(V[3 * static_cast<std::size_t>(v)] - c.x) <= tol_ &&
+                        std::abs(V[3 * static_cast<std::size_t>(v) + 1] - c.y) <= tol_)
+                        c.ids.back() = v;
+            }
+            for (int k = 1; k <= layers_; ++k) {
+                int& id = c.ids[static_cast<std::size_t>(k - 1)];
+                if (id < 0) id = add_vertex(c.x, c.y, step_coord(c.base, top, k, layers_));
+            }
+        }
+    for (Wall& w : walls_) {
+        w.base.front() = corners_[static_cast<std::size_t>(w.corner0)].base;
+        w.base.back() = corners_[static_cast<std::size_t>(w.corner1)].base;
+        w.ids.reserve(static_cast<std::size_t>((w.columns - 1) * layers_));
+        for (int c = 1; c < w.columns; ++c) {
+            const double s = step_coord(w.s0, w.s1, c, w.columns);
+            const double base = w.base[static_cast<std::size_t>(c)];
+            const double x = w.axis ? s : w.c, y = w.axis ? w.c : s;
+            check_base(base, x, y);
+            for (int k = 1; k <= layers_; ++k) w.ids.push_back(add_vertex(x, y, step_coord(base, top, k, layers_)));
+        }
+
+        std::vector<int> first(static_cast<std::size_t>(w.columns) + 1);
+        for (int c = 0; c <= w.columns; ++c) first[static_cast<std::size_t>(c)] = column(w, c, 1);
+        zip(w, first);
+        for (int k = 1; k < layers_; ++k)
+            for (int c = 0; c < w.columns; ++c) {
+                const int a = column(w, c, k), b = column(w, c + 1, k);
+                const int d = column(w, c + 1, k + 1), e = column(w, c, k + 1);
+                w.triangles.insert(w.triangles.end(), {a, b, d, a, d, e});
+            }
+        if (w.interface) interface_triangles.insert(interface_triangles.end(), w.triangles.begin(), w.triangles.end());
+    }
+
+    // Tops: a grid whose rim is the top layer of the tile's walls
+    tops_.resize(static_cast<std::size_t>(tiles_x * tiles_y));
+    for (int iy = 0; iy < tiles_y; ++iy)
+        for (int ix = 0; ix < tiles_x; ++ix) {
+            const Wall& west = walls_[static_cast<std::size_t>(x_wall(ix, iy))];
+            const Wall& east = walls_[static_cast<std::size_t>(x_wall(ix + 1, iy))];
+            const Wall& south = walls_[static_cast<std::size_t>(y_wall(iy, ix))];
+            const Wall& north = walls_[static_cast<std::size_t>(y_wall(iy + 1, ix))];
+            const int mx = south.columns, my = west.columns;
+            std::vector<int> inner;
+            inner.reserve(static_cast<std::size_t>((mx - 1) * (my - 1)));
+            for (int j = 1; j < my; ++j)
+                for (int i = 1; i < mx; ++i)
+                    inner.push_back(add_vertex(step_coord(south.s0, south.s1, i, mx),
+                                               step_coord(west.s0, west.s1, j, my), top));
+            auto at = [&](int i, int j) {
+                if (j == 0) return column(south, i, layers_);
+                if (j == my) return column(north, i, layers_);
+                if (i == 0) return column(west, j, layers_);
+                if (i == mx) return column(east, j, layers_);
+                return inner[static_cast<std::size_t>((j - 1) * (mx - 1) + i - 1)];
+            };
+            std::vector<int>& tris = tops_[static_cast<std::size_t>(tile(ix, iy))];
+            for (int j = 0; j < my; ++j)
+                for (int i = 0; i < mx; ++i)
+                    tris.insert(tris.end(), {at(i, j), at(i + 1, j), at(i + 1, j + 1),
+                                             at(i, j), at(i + 1, j + 1), at(i, j + 1)});
+        }
+}
+
+// One PlcBundle per tile over compact local vertex ids: the tile's surface
+// facets (mesh facets keep their markers, boundary polygons theirs), then
+// its walls and top as boundary triangles
+void Tiler::assemble()
+{
+    const std::size_t G = V.size() / 3;
+    std::vector<int> stamp(G, -1), local(G, 0);
+    tiles.resize(static_cast<std::size_t>(tiles_x * tiles_y));
+    tile_ids.resize(tiles.size());
+    std::vector<int> ids;
+    for (int iy = 0; iy < tiles_y; ++iy)
+        for (int ix = 0; ix < tiles_x; ++ix) {
+            const int t = tile(ix, iy);
+            PlcBundle& b = tiles[static_cast<std::size_t>(t)];
+            std::vector<int>& map = tile_ids[static_cast<std::size_t>(t)];
+            auto to_local = [&](int g) {
+                if (stamp[static_cast<std::size_t>(g)] != t) {
+                    stamp[static_cast<std::size_t>(g)] = t;
+                    local[static_cast<std::size_t>(g)] = static_cast<int>(map.size());
+                    map.push_back(g);
+                }
+                return local[static_cast<std::size_t>(g)];
+            };
+            auto add = [&](bool mesh, const int* poly, std::size_t n, int marker) {
+                std::vector<int>& indices = mesh ? b.mesh_indices : b.boundary_indices;
+                for (std::size_t i = 0; i < n; ++i) indices.push_back(to_local(poly[i]));
+                (mesh ? b.mesh_offsets : b.boundary_offsets).push_back(static_cast<std::int64_t>(indices.size()));
+                if (!mesh) b.boundary_markers.push_back(marker);
+                else if (plc_.mesh_facet_markers) b.mesh_markers.push_back(marker);
+            };
+
+            b.mesh_offsets.assign(1, 0);
+            b.boundary_offsets.assign(1, 0);
+            for (int pass = 0; pass < 2; ++pass) {
+                const bool mesh = pass == 0;
+                for (int source : whole_[static_cast<std::size_t>(t)]) {
+                    if ((source < M_) != mesh) continue;
+                    polygon(source, ids);
+                    add(mesh, ids.data(), ids.size(), source_marker(source));
+                }
+                for (int p : pieces_of_[static_cast<std::size_t>(t)]) {
+                    const int source = piece_source_[static_cast<std::size_t>(p)];
+                    if ((source < M_) != mesh) continue;
+                    const std::int64_t begin = piece_offsets_[static_cast<std::size_t>(p)];
+                    add(mesh, &piece_ids_[static_cast<std::size_t>(begin)],
+                        static_cast<std::size_t>(piece_offsets_[static_cast<std::size_t>(p) + 1] - begin),
+                        source_marker(source));
+                }
+            }
+            for (int w : {x_wall(ix, iy), x_wall(ix + 1, iy), y_wall(iy, ix), y_wall(iy + 1, ix)}) {
+                const Wall& wall = walls_[static_cast<std::size_t>(w)];
+                for (std::size_t i = 0; i < wall.triangles.size(); i += 3) add(false, &wall.triangles[i], 3, wall.marker);
+            }
+            const std::vector<int>& top = tops_[static_cast<std::size_t>(t)];
+            for (std::size_t i = 0; i < top.size(); i += 3) add(false, &top[i], 3, side_marker_[kTop]);
+
+            b.vertices.reserve(3 * map.size());
+            for (int g : map)
+                b.vertices.insert(b.vertices.end(), V.begin() + 3 * static_cast<std::ptrdiff_t>(g),
+                                  V.begin() + 3 * static_cast<std::ptrdiff_t>(g) + 3);
+        }
+}
+
+// Sum the tiles' counters by name
+void add_counters(RunStats& stats, const RunStats& tile)
+{
+    for (const auto& c : tile.counters) {
+        auto it = std::find_if(stats.counters.begin(), stats.counters.end(),
+                               [&](const std::pair<const char*, long long>& s) { return !std::strcmp(s.first, c.first); });
+        if (it == stats.counters.end()) stats.counters.push_back(c);
+        else it->second += c.second;
+    }
+}
+
+// Stitch the tile meshes: global points are the tiler's table, compacted to
+// the points some tile uses, followed by every tile's Steiner points;
+// interface faces are matched through the shared wall triangles
+void merge_tiles(const Tiler& tiler, std::vector<BatchItem>& items, bool compute_boundary_faces, bool faces_out,
+                 int num_threads, MeshResult& result)
+{
+    const std::size_t num_tiles = items.size();
+
+    // Input vertices only used by the discarded side and top polygons (the
+    // tiles rebuild those from the walls and tops) are left out, keeping
+    // the order of the rest
+    std::vector<int> remap(tiler.V.size() / 3, -1);
+    for (const std::vector<int>& ids : tiler.tile_ids)
+        for (int g : ids) remap[static_cast<std::size_t>(g)] = 0;
+    std::size_t G = 0;
+    for (int& r : remap)
+        if (r >= 0) r = static_cast<int>(G++);
+    std::vector<std::vector<int>> tile_ids(num_tiles);
+    for (std::size_t t = 0; t < num_tiles; ++t)
+        for (int g : tiler.tile_ids[t]) tile_ids[t].push_back(remap[static_cast<std::size_t>(g)]);
+
+    std::vector<std::size_t> point_base(num_tiles + 1, G), tet_base(num_tiles + 1, 0);
+    bool attributes = true, neighbors = true, point_markers = true, markers = true;
+    int num_attributes = -1;
+    for (std::size_t t = 0; t < num_tiles; ++t) {
+        const tetgenio& out = *items[t].mesh.out;
+        const std::size_t n_in = tile_ids[t].size();
+        if (out.numberofcorners != 4) fail("tiles must produce linear tets");
+        if (static_cast<std::size_t>(out.numberofpoints) < n_in) fail("TetGen dropped input points of a tile");
+        const double* in = tiler.tiles[t].vertices.data();
+        if (!std::equal(in, in + 3 * n_in, out.pointlist))
+            fail("TetGen renumbered the input points of tile " + std::to_string(t));
+        point_base[t + 1] = point_base[t] + static_cast<std::size_t>(out.numberofpoints) - n_in;
+        tet_base[t + 1] = tet_base[t] + static_cast<std::size_t>(out.numberoftetrahedra);
+        if (num_attributes < 0) num_attributes = out.numberoftetrahedronattributes;
+        attributes = attributes && out.numberoftetrahedronattributes == num_attributes && num_attributes > 0 &&
+                     out.tetrahedronattributelist;
+        neighbors = neighbors && out.neighborlist;
+        point_markers = point_markers && out.pointmarkerlist;
+        markers = markers && items[t].mesh.has_boundary_markers;
+    }
+    const std::size_t P = point_base[num_tiles], T = tet_base[num_tiles];
+    if (P > static_cast<std::size_t>(std::numeric_limits<int>::max()) ||
+        T > static_cast<std::size_t>(std::numeric_limits<int>::max()) / 4)
+        fail("the merged mesh is too large for 32-bit indices");
+
+    tetgenio& out = *result.out;
+    out.firstnumber = 0;
+    out.mesh_dim = 3;
+    out.numberofpoints = static_cast<int>(P);
+    out.pointlist = new REAL[3 * P];
+    for (std::size_t g = 0; g < remap.size(); ++g)
+        if (remap[g] >= 0)
+            std::copy(tiler.V.begin() + 3 * static_cast<std::ptrdiff_t>(g),
+                      tiler.V.begin() + 3 * static_cast<std::ptrdiff_t>(g) + 3,
+                      out.pointlist + 3 * static_cast<std::size_t>(remap[g]));
+    if (point_markers) out.pointmarkerlist = new int[P]();
+    out.numberofcorners = 4;
+    out.numberoftetrahedra = static_cast<int>(T);
+    out.tetrahedronlist = new int[4 * T];
+    if (attributes) {
+        out.numberoftetrahedronattributes = num_attributes;
+        out.tetrahedronattributelist = new REAL[static_cast<std::size_t>(num_attributes) * T];
+    }
+    if (neighbors) out.neighborlist = new int[4 * T];
+
+    // Per tile: Steiner points, tets, attributes and neighbors (disjoint
+    // ranges, so tiles run in parallel)
+    parallel_chunks(num_tiles, 1, num_threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; ++t) {
+            const tetgenio& o = *items[t].mesh.out;
+            const std::vector<int>& ids = tile_ids[t];
+            const int n_in = static_cast<int>(ids.size());
+            const int shift = static_cast<int>(point_base[t]) - n_in;
+            const std::size_t steiner = static_cast<std::size_t>(o.numberofpoints) - ids.size();
+            std::copy(o.pointlist + 3 * ids.size(), o.pointlist + 3 * ids.size() + 3 * steiner,
+                      out.pointlist + 3 * point_base[t]);
+            const std::size_t K = static_cast<std::size_t>(o.numberoftetrahedra);
+            int* tets = out.tetrahedronlist + 4 * tet_base[t];
+            for (std::size_t i = 0; i < 4 * K; ++i) {
+                const int p = o.tetrahedronlist[i];
+                tets[i] = p < n_in ? ids[static_cast<std::size_t>(p)] : p + shift;
+            }
+            if (attributes)
+                std::copy(o.tetrahedronattributelist, o.tetrahedronattributelist + static_cast<std::size_t>(num_attributes) * K,
+                          out.tetrahedronattributelist + static_cast<std::size_t>(num_attributes) * tet_base[t]);
+            if (neighbors) {
+                const int tshift = static_cast<int>(tet_base[t]);
+                int* nb = out.neighborlist + 4 * tet_base[t];
+                for (std::size_t i = 0; i < 4 * K; ++i) nb[i] = o.neighborlist[i] < 0 ? -1 : o.neighborlist[i] + tshift;
+            }
+            if (point_markers)
+                for (std::size_t p = ids.size(); p < static_cast<std::size_t>(o.numberofpoints); ++p)
+                    out.pointmarkerlist[point_base[t] + p - ids.size()] = o.pointmarkerlist[p];
+        }
+    });
+
+    // Point markers of shared points: first tile wins
+    if (point_markers) {
+        std::vector<char> seen(G, 0);
+        for (std::size_t t = 0; t < num_tiles; ++t) {
+            const std::vector<int>& ids = tile_ids[t];
+            for (std::size_t p = 0; p < ids.size(); ++p)
+                if (!seen[static_cast<std::size_t>(ids[p])]) {
+                    seen[static_cast<std::size_t>(ids[p])] = 1;
+                    out.pointmarkerlist[ids[p]] = items[t].mesh.out->pointmarkerlist[p];
+                }
+        }
+    }
+
+    // Interface faces: every wall triangle between two tiles must be a hull
+    // face of both; they become interior faces of the merged mesh
+    const std::size_t I = tiler.interface_triangles.size() / 3;
+    FaceTable interface(I);
+    for (std::size_t i = 0; i < I; ++i) {
+        int f[3];
+        for (int k = 0; k < 3; ++k) f[k] = remap[static_cast<std::size_t>(tiler.interface_triangles[3 * i + k])];
+        interface.insert(sorted_face(f), static_cast<int>(i));
+    }
+    std::vector<int> owner(2 * I, -1);          // (I,2) global tet * 4 + local face
+    auto global_face = [&](std::size_t t, const int* f, int* g) {
+        const std::vector<int>& ids = tile_ids[t];
+        const int n_in = static_cast<int>(ids.size());
+        for (int k = 0; k < 3; ++k)
+            g[k] = f[k] < n_in ? ids[static_cast<std::size_t>(f[k])] : f[k] + static_cast<int>(point_base[t]) - n_in;
+    };
+    for (std::size_t t = 0; t < num_tiles; ++t) {
+        MeshResult& mesh = items[t].mesh;
+        const std::size_t BF = mesh.boundary_tets.size();
+        for (std::size_t b = 0; b < BF; ++b) {
+            int g[3];
+            global_face(t, &mesh.boundary_faces[3 * b], g);
+            const int tet = mesh.boundary_tets[b] + static_cast<int>(tet_base[t]);
+            const int i = interface.find(sorted_face(g));
+            if (i >= 0) {
+                int* slot = &owner[2 * static_cast<std::size_t>(i)];
+                if (slot[1] >= 0) fail("an interface face is shared by more than two tiles");
+                slot[slot[0] >= 0 ? 1 : 0] = 4 * tet + mesh.boundary_local_faces[b];
+            } else if (compute_boundary_faces) {
+                result.boundary_faces.insert(result.boundary_faces.end(), g, g + 3);
+                result.boundary_tets.push_back(tet);
+                result.boundary_local_faces.push_back(mesh.boundary_local_faces[b]);
+                if (markers) result.boundary_markers.push_back(mesh.boundary_markers[b]);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < I; ++i)
+        if (owner[2 * i + 1] < 0)
+            fail("the tile meshes do not conform at an interface (was a Steiner point inserted on it?)");
+    if (neighbors)
+        for (std::size_t i = 0; i < I; ++i) {
+            const int a = owner[2 * i], b = owner[2 * i + 1];
+            out.neighborlist[a] = b / 4;
+            out.neighborlist[b] = a / 4;
+        }
+    result.has_boundary_faces = compute_boundary_faces;
+    result.has_boundary_markers = compute_boundary_faces && markers;
+
+    // Tri faces: interface triangles once with marker 0 when all faces are
+    // written (-f), otherwise not at all (they are no longer subfaces)
+    std::size_t F = 0;
+    bool trifaces = true;
+    for (const BatchItem& item : items) {
+        trifaces = trifaces && item.mesh.out->trifacelist && item.mesh.out->trifacemarkerlist;
+        F += static_cast<std::size_t>(item.mesh.out->numberoftrifaces);
+    }
+    if (trifaces && F > 0) {
+        std::vector<int> faces, face_markers;
+        faces.reserve(3 * F);
+        face_markers.reserve(F);
+        std::vector<char> kept(I, 0);
+        for (std::size_t t = 0; t < num_tiles; ++t) {
+            const tetgenio& o = *items[t].mesh.out;
+            for (int f = 0; f < o.numberoftrifaces; ++f) {
+                int g[3];
+                global_face(t, o.trifacelist + 3 * static_cast<std::size_t>(f), g);
+                int marker = o.trifacemarkerlist[f];
+                const int i = interface.find(sorted_face(g));
+                if (i >= 0) {
+                    if (!faces_out || kept[static_cast<std::size_t>(i)]) continue;
+                    kept[static_cast<std::size_t>(i)] = 1;
+                    marker = 0;
+                }
+                faces.insert(faces.end(), g, g + 3);
+                face_markers.push_back(marker);
+            }
+        }
+        out.numberoftrifaces = static_cast<int>(face_markers.size());
+        out.trifacelist = new int[faces.size()];
+        std::copy(faces.begin(), faces.end(), out.trifacelist);
+        out.trifacemarkerlist = new int[face_markers.size()];
+        std::copy(face_markers.begin(), face_markers.end(), out.trifacemarkerlist);
+    }
+
+    for (BatchItem& item : items) add_counters(result.stats, item.mesh.stats);
+    result.stats.counters.emplace_back("tiles", static_cast<long long>(num_tiles));
+    result.stats.counters.emplace_back("interface_faces", static_cast<long long>(I));
+}
+
+}  // namespace
+
+MeshResult run_tetgen_tiled(const PlcInput& plc, const TileOptions& tiles, const RunOptions& options)
+{
+    MeshResult result;
+    PhaseClock clock(result.stats);
+    validate_plc(plc);
+    if (!options.output_dir.empty()) fail("output_dir is not supported");
+
+    // Tiles keep their input points in order (-J) and their walls as given
+    // (-Y); refinement, edges and second-order tets are not stitched
+    std::vector<char> sw = plc.switches;
+    if (sw.empty() || sw.back() != '\0') sw.push_back('\0');
+    add_switch(sw, 'p');
+    add_switch(sw, 'Y');
+    add_switch(sw, 'J');
+    bool faces_out = false;
+    {
+        tetgenbehavior behavior;
+        std::vector<char> parsed = sw;
+        if (!behavior.parse_commandline(parsed.data())) fail("invalid switches");
+        if (behavior.refine) fail("-r is not supported");
+        if (behavior.edgesout) fail("-e is not supported");
+        if (behavior.order == 2) fail("-o2 is not supported");
+        faces_out = behavior.facesout != 0;
+    }
+
+    Tiler tiler(plc, tiles);
+    std::vector<const PlcInput*> inputs;
+    std::vector<PlcInput> views;
+    views.reserve(tiler.tiles.size());
+    for (PlcBundle& b : tiler.tiles) {
+        b.switches.assign(sw.begin(), sw.end() - 1);
+        b.compute_boundary_faces = true;   // hull faces locate the interfaces
+        views.push_back(b.view());
+        views.back().sizing = plc.sizing;
+        inputs.push_back(&views.back());
+    }
+    clock.lap("decompose");
+
+    std::vector<BatchItem> items = run_tetgen_batch(inputs, tiles.num_threads, options);
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        if (!items[i].error) continue;
+        try {
+            std::rethrow_exception(items[i].error);
+        } catch (const RunAborted& e) {
+            throw RunAborted(e.code, "tile " + std::to_string(i) + ": " + e.what());
+        } catch (const std::exception& e) {
+            throw std::runtime_error("tile " + std::to_string(i) + ": " + e.what());
+        }
+    }
+    clock.lap("tiles");
+
+    result.out.reset(new tetgenio());
+    merge_tiles(tiler, items, plc.compute_boundary_faces, faces_out, options.kernel_threads, result);
+    clock.lap("merge");
+    return result;
+}
+
+}  // namespace tetwrap
@@ -0,0 +1,340 @@
+// VTU and XDMF writers for finished meshes (see MeshView).
+//
+// Both write the caller's arrays straight from their buffers through large
+// stdio buffers; the cell offsets / types / markers that VTU needs on top
+// are generated block by block instead of being materialized. With zlib,
+// VTU blocks are compressed on a thread pool.
+#include "tetwrap_core.h"
+#include "tetwrap_detail.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#if TETWRAP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace tetwrap {
+
+namespace {
+
+constexpr std::size_t kBlockBytes = std::size_t(1) << 20;   // generated / compressed block
+
+bool little_endian()
+{
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+using detail::OutFile;
+
+// A logical array of `elem`-byte scalars, concatenated from borrowed
+// buffers and generated ranges.
+struct Segment {
+    const void* data = nullptr;                                       // borrowed, or
+    std::function<void(std::size_t first, std::size_t count, void* dst)> fill;  // generated
+    std::size_t count = 0;
+};
+
+struct DataArray {
+    std::string attributes;                     // type, Name, NumberOfComponents
+    std::size_t elem = 0;
+    std::vector<Segment> segments;
+    std::int64_t offset_field = 0;              // file position of the offset placeholder
+
+    std::size_t bytes() const
+    {
+        std::size_t n = 0;
+        for (const Segment& s : segments) n += s.count * elem;
+        return n;
+    }
+
+    // Copy bytes [first, first + bytes) into dst; both are multiples of elem
+    void copy(std::size_t first, std::size_t bytes, char* dst) const
+    {
+        std::size_t seg_first = 0;
+        for (const Segment& s : segments) {
+            const std::size_t seg_bytes = s.count * elem;
+            if (bytes == 0) break;
+            if (first < seg_first + seg_bytes) {
+                const std::size_t local = first - seg_first;
+                const std::size_t take = std::min(bytes, seg_bytes - local);
+                if (s.data) std::memcpy(dst, static_cast<const char*>(s.data) + local, take);
+                else s.fill(local / elem, take / elem, dst);
+                dst += take;
+                first += take;
+                bytes -= take;
+            }
+            seg_first += seg_bytes;
+        }
+    }
+};
+
+Segment borrowed(const void* data, std::size_t count)
+{
+    Segment s;
+    s.data = data;
+    s.count = count;
+    return s;
+}
+
+template <typename T, typename Fn>
+Segment generated(std::size_t count, Fn value)
+{
+    Segment s;
+    s.count = count;
+    s.fill = [value](std::size_t first, std::size_t n, void* dst) {
+        T* out = static_cast<T*>(dst);
+        for (std::size_t i = 0; i < n; ++i) out[i] = value(first + i);
+    };
+    return s;
+}
+
+// Uncompressed: UInt64 byte count, then the bytes
+void write_raw(OutFile& f, const DataArray& a)
+{
+    const std::uint64_t bytes = a.bytes();
+    f.write(&bytes, sizeof(bytes));
+    std::vector<char> scratch;
+    for (const Segment& s : a.segments) {
+        if (s.data) {
+            f.write(s.data, s.count * a.elem);
+            continue;
+        }
+        const std::size_t per_block = kBlockBytes / a.elem;
+        scratch.resize(per_block * a.elem);
+        for (std::size_t first = 0; first < s.count; first += per_block) {
+            const std::size_t n = std::min(per_block, s.count - first);
+            s.fill(first, n, scratch.data());
+            f.write(scratch.data(), n * a.elem);
+        }
+    }
+}
+
+#if TETWRAP_HAVE_ZLIB
+// vtkZLibDataCompressor layout: UInt64 [blocks, block size, last block
+// size, compressed size of every block], then the compressed blocks. The
+// header is written as a placeholder and patched once the sizes are known,
+// so only one batch of compressed blocks is held in memory at a time.
+void write_zlib(OutFile& f, const DataArray& a, int num_threads)
+{
+    const std::size_t bytes = a.bytes();
+    const std::size_t blocks = (bytes + kBlockBytes - 1) / kBlockBytes;
+    std::vector<std::uint64_t> header(3 + blocks, 0);
+    header[0] = blocks;
+    header[1] = kBlockBytes;
+    header[2] = blocks > 0 ? bytes - (blocks - 1) * kBlockBytes : 0;
+    const std::int64_t header_pos = f.tell();
+    f.write(header.data(), header.size() * sizeof(std::uint64_t));
+
+    const std::size_t workers = static_cast<std::size_t>(
+        num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency()));
+    const std::size_t batch = 4 * workers;
+    std::vector<std::vector<unsigned char>> packed(batch);
+    for (std::size_t first = 0; first < blocks; first += batch) {
+        const std::size_t n = std::min(batch, blocks - first);
+        detail::parallel_chunks(n, 1, static_cast<int>(workers), [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::vector<char> raw(kBlockBytes);
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::size_t at = (first + i) * kBlockBytes;
+                const std::size_t len = std::min(kBlockBytes, bytes - at);
+                a.copy(at, len, raw.data());
+                uLongf out_len = compressBound(static_cast<uLong>(len));
+                packed[i].resize(out_len);
+                if (compress2(packed[i].data(), &out_len, reinterpret_cast<const Bytef*>(raw.data()),
+                              static_cast<uLong>(len), Z_DEFAULT_COMPRESSION) != Z_OK)
+                    throw std::runtime_error("zlib compression failed");
+                packed[i].resize(out_len);
+            }
+        });
+
+        for (std::size_t i = 0; i < n; ++i) {
+            header[3 + first + i] = packed[i].size();
+            f.write(packed[i].data(), packed[i].size());
+        }
+    }
+
+    const std::int64_t end = f.tell();
+    f.seek(header_pos);
+    f.write(header.data(), header.size() * sizeof(std::uint64_t));
+    f.seek(end);
+}
+#endif
+
+// Fixed-width slot for an appended offset, patched after the data is written
+const char kOffsetSlot[] = "                    ";  // 20 characters, fits any uint64
+
+void check_view(const MeshView& mesh)
+{
+    if (mesh.num_points < 0 || mesh.num_tets < 0 || mesh.num_faces < 0)
+        throw std::runtime_error("mesh writer: negative array size");
+    if ((mesh.num_points > 0 && !mesh.points) || (mesh.num_tets > 0 && !mesh.tets) ||
+        (mesh.num_faces > 0 && !mesh.faces))
+        throw std::runtime_error("mesh writer: array buffer is missing");
+}
+
+std::string base_name(const std::string& path)
+{
+    const std::size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+}  // namespace
+
+void write_vtu(const std::string& path, const MeshView& mesh, const WriteOptions& options)
+{
+    check_view(mesh);
+#if !TETWRAP_HAVE_ZLIB
+    if (options.compress) throw std::runtime_error("write_vtu: built without zlib, compression is unavailable");
+#endif
+
+    const std::size_t K = static_cast<std::size_t>(mesh.num_tets);
+    const std::size_t F = static_cast<std::size_t>(mesh.num_faces);
+    const std::size_t cells = K + F;
+    const bool markers = F > 0 && mesh.face_markers;
+
+    std::vector<DataArray> arrays;
+    auto add = [&](std::string attributes, std::size_t elem) -> DataArray& {
+        arrays.emplace_back();
+        arrays.back().attributes = std::move(attributes);
+        arrays.back().elem = elem;
+        return arrays.back();
+    };
+
+    // Points, then cells: connectivity is the tets followed by the faces
+    add("type=\"Float64\" NumberOfComponents=\"3\"", 8).segments = {borrowed(mesh.points, 3 * mesh.num_points)};
+    DataArray& conn = add("type=\"Int32\" Name=\"connectivity\"", 4);
+    conn.segments.push_back(borrowed(mesh.tets, 4 * K));
+    if (F > 0) conn.segments.push_back(borrowed(mesh.faces, 3 * F));
+    add("type=\"Int64\" Name=\"offsets\"", 8).segments = {
+        generated<std::int64_t>(K, [](std::size_t i) { return static_cast<std::int64_t>(4 * (i + 1)); }),
+        generated<std::int64_t>(F, [K](std::size_t j) { return static_cast<std::int64_t>(4 * K + 3 * (j + 1)); })};
+    add("type=\"UInt8\" Name=\"types\"", 1).segments = {
+        generated<std::uint8_t>(K, [](std::size_t) { return std::uint8_t(10); }),   // VTK_TETRA
+        generated<std::uint8_t>(F, [](std::size_t) { return std::uint8_t(5); })};   // VTK_TRIANGLE
+    if (markers) {
+        const int fill = options.marker_fill;
+        add("type=\"Int32\" Name=\"marker\"", 4).segments = {
+            generated<std::int32_t>(K, [fill](std::size_t) { return fill; }), borrowed(mesh.face_markers, F)};
+    }
+
+    OutFile f(path);
+    std::ostringstream xml;
+    xml << "<?xml version=\"1.0\"?>\n"
+        << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+        << (little_endian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\""
+        << (options.compress ? " compressor=\"vtkZLibDataCompressor\"" : "") << ">\n"
+        << "  <UnstructuredGrid>\n"
+        << "    <Piece NumberOfPoints=\"" << mesh.num_points << "\" NumberOfCells=\"" << cells << "\">\n";
+    f.write(xml.str());
+
+    // Array tags with offset slots; section tags between them
+    auto tag = [&](DataArray& a, const char* indent) {
+        f.write(std::string(indent) + "<DataArray " + a.attributes + " format=\"appended\" offset=\"");
+        a.offset_field = f.tell();
+        f.write(kOffsetSlot, sizeof(kOffsetSlot) - 1);
+        f.write("\"/>\n");
+    };
+    f.write("      <Points>\n");
+    tag(arrays[0], "        ");
+    f.write("      </Points>\n      <Cells>\n");
+    for (std::size_t i = 1; i <= 3; ++i) tag(arrays[i], "        ");
+    f.write("      </Cells>\n");
+    if (markers) {
+        f.write("      <CellData Scalars=\"marker\">\n");
+        tag(arrays[4], "        ");
+        f.write("      </CellData>\n");
+    }
+    f.write("    </Piece>\n  </UnstructuredGrid>\n  <AppendedData encoding=\"raw\">\n   _");
+
+    const std::int64_t data_start = f.tell();
+    std::vector<std::int64_t> offsets;
+    for (const DataArray& a : arrays) {
+        offsets.push_back(f.tell() - data_start);
+#if TETWRAP_HAVE_ZLIB
+        if (options.compress) {
+            write_zlib(f, a, options.num_threads);
+            continue;
+        }
+#endif
+        write_raw(f, a);
+    }
+    f.write("\n  </AppendedData>\n</VTKFile>\n");
+
+    for (std::size_t i = 0; i < arrays.size(); ++i) {
+        const std::string value = std::to_string(offsets[i]);
+        f.seek(arrays[i].offset_field);
+        f.write(value);
+    }
+    f.close();
+}
+
+void write_xdmf(const std::string& path, const MeshView& mesh, const WriteOptions& options)
+{
+    check_view(mesh);
+    (void)options;
+
+    std::string bin_path = path;
+    const std::size_t dot = bin_path.find_last_of('.');
+    const std::size_t slash = bin_path.find_last_of("/\\");
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) bin_path.resize(dot);
+    bin_path += ".bin";
+    const std::string bin_name = base_name(bin_path);
+    const char* endian = little_endian() ? "Little" : "Big";
+
+    const std::int64_t N = mesh.num_points, K = mesh.num_tets, F = mesh.num_faces;
+    const std::int64_t points_at = 0;
+    const std::int64_t tets_at = points_at + 3 * N * 8;
+    const std::int64_t faces_at = tets_at + 4 * K * 4;
+    const std::int64_t markers_at = faces_at + 3 * F * 4;
+    const bool markers = F > 0 && mesh.face_markers;
+
+    {
+        OutFile bin(bin_path);
+        bin.write(mesh.points, static_cast<std::size_t>(3 * N) * sizeof(double));
+        bin.write(mesh.tets, static_cast<std::size_t>(4 * K) * sizeof(int));
+        bin.write(mesh.faces, static_cast<std::size_t>(3 * F) * sizeof(int));
+        if (markers) bin.write(mesh.face_markers, static_cast<std::size_t>(F) * sizeof(int));
+        bin.close();
+    }
+
+    auto item = [&](const std::string& dims, const char* type, int precision, std::int64_t seek) {
+        std::ostringstream os;
+        os << "<DataItem Dimensions=\"" << dims << "\" NumberType=\"" << type << "\" Precision=\"" << precision
+           << "\" Format=\"Binary\" Endian=\"" << endian << "\" Seek=\"" << seek << "\">" << bin_name
+           << "</DataItem>";
+        return os.str();
+    };
+    const std::string geometry = "      <Geometry GeometryType=\"XYZ\">\n        " +
+                                 item(std::to_string(N) + " 3", "Float", 8, points_at) + "\n      </Geometry>\n";
+
+    std::ostringstream xml;
+    xml << "<?xml version=\"1.0\" ?>\n"
+        << "<Xdmf Version=\"3.0\">\n  <Domain>\n"
+        << "    <Grid Name=\"tets\" GridType=\"Uniform\">\n"
+        << "      <Topology TopologyType=\"Tetrahedron\" NumberOfElements=\"" << K << "\">\n        "
+        << item(std::to_string(K) + " 4", "Int", 4, tets_at) << "\n      </Topology>\n"
+        << geometry << "    </Grid>\n";
+    if (F > 0) {
+        xml << "    <Grid Name=\"boundary\" GridType=\"Uniform\">\n"
+            << "      <Topology TopologyType=\"Triangle\" NumberOfElements=\"" << F << "\">\n        "
+            << item(std::to_string(F) + " 3", "Int", 4, faces_at) << "\n      </Topology>\n"
+            << geometry;
+        if (markers)
+            xml << "      <Attribute Name=\"marker\" AttributeType=\"Scalar\" Center=\"Cell\">\n        "
+                << item(std::to_string(F), "Int", 4, markers_at) << "\n      </Attribute>\n";
+        xml << "    </Grid>\n";
+    }
+    xml << "  </Domain>\n</Xdmf>\n";
+
+    OutFile f(path);
+    f.write(xml.str());
+    f.close();
+}
+
+}  // namespace tetwrap
@@ -0,0 +1,228 @@
+// Standalone replay / benchmark driver: loads a PLC from a failure repro
+// bundle (.tetplc) or a TetGen .smesh (+ .node) file and meshes it N times
+// through tetwrap::run_tetgen(), the same path as the Python module, then
+// prints per-phase wall times, TetGen's counters and the peak RSS. Meant for
+// perf / valgrind / heaptrack runs without a Python interpreter.
+//
+//   cmake -S . -B build -DTETWRAP_BUILD_TOOLS=ON
+//   cmake --build build --target tetwrap_replay
+//   build/tetwrap_replay /tmp/tetwrap-fail-....tetplc -n 5
+//   build/tetwrap_replay city.smesh -s pq1.2a10zQ -n 3
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "tetwrap_core.h"
+
+namespace {
+
+const char kUsage[] =
+    "usage: tetwrap_replay <plc.tetplc | plc.smesh> [options]\n"
+    "  -s, --switches STR   TetGen switches (default: the bundle's, or pzQ for .smesh)\n"
+    "  -n, --runs N         number of runs (default 1)\n"
+    "  -t, --threads N      wrapper post-processing threads (default 0 = all)\n"
+    "      --no-boundary    skip boundary face extraction\n"
+    "      --time-budget S  abort a run after S seconds\n"
+    "  -q, --quiet          only print the summary\n";
+
+struct Args {
+    std::string path;
+    std::string switches;
+    bool switches_set = false;
+    int runs = 1;
+    int threads = 0;
+    bool boundary = true;
+    double time_budget_s = 0.0;
+    bool quiet = false;
+};
+
+[[noreturn]] void usage_error(const std::string& what)
+{
+    std::fprintf(stderr, "tetwrap_replay: %s\n%s", what.c_str(), kUsage);
+    std::exit(2);
+}
+
+Args parse_args(int argc, char** argv)
+{
+    Args a;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) usage_error(arg + " needs a value");
+            return argv[++i];
+        };
+        if (arg == "-h" || arg == "--help") {
+            std::fputs(kUsage, stdout);
+            std::exit(0);
+        } else if (arg == "-s" || arg == "--switches") {
+            a.switches = value();
+            a.switches_set = true;
+        } else if (arg == "-n" || arg == "--runs") {
+            a.runs = std::atoi(value());
+        } else if (arg == "-t" || arg == "--threads") {
+            a.threads = std::atoi(value());
+        } else if (arg == "--no-boundary") {
+            a.boundary = false;
+        } else if (arg == "--time-budget") {
+            a.time_budget_s = std::atof(value());
+        } else if (arg == "-q" || arg == "--quiet") {
+            a.quiet = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage_error("unknown option " + arg);
+        } else if (a.path.empty()) {
+            a.path = arg;
+        } else {
+            usage_error("more than one input file");
+        }
+    }
+    if (a.path.empty()) usage_error("no input file");
+    if (a.runs < 1) usage_error("--runs must be at least 1");
+    return a;
+}
+
+bool ends_with(const std::string& s, const char* suffix)
+{
+    const std::size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+// A .smesh PLC as a bundle: its facets become the boundary polygons
+tetwrap::PlcBundle load_smesh(const std::string& path)
+{
+    const std::string node_path = path.substr(0, path.size() - std::strlen(".smesh")) + ".node";
+    tetwrap::TetgenSmesh smesh;
+    if (std::FILE* f = std::fopen(node_path.c_str(), "rb")) {
+        std::fclose(f);
+        tetwrap::TetgenNodes nodes = tetwrap::read_tetgen_node(node_path);
+        smesh = tetwrap::read_tetgen_smesh(path, nodes.first_index);
+        if (smesh.nodes.count == 0) smesh.nodes = std::move(nodes);
+    } else {
+        smesh = tetwrap::read_tetgen_smesh(path);
+    }
+    if (smesh.nodes.count == 0)
+        throw std::runtime_error(path + " has no inline nodes and " + node_path + " does not exist");
+    if (!smesh.holes.empty() || !smesh.regions.empty())
+        std::fprintf(stderr, "tetwrap_replay: ignoring the holes and regions of %s\n", path.c_str());
+
+    tetwrap::PlcBundle b;
+    b.vertices = std::move(smesh.nodes.points);
+    b.boundary_offsets = smesh.facet_offsets;
+    b.boundary_indices = smesh.facet_indices;
+    // Boundary markers must be >= 0; otherwise fall back to polygon indices
+    if (std::all_of(smesh.facet_markers.begin(), smesh.facet_markers.end(), [](int m) { return m >= 0; }))
+        b.boundary_markers = smesh.facet_markers;
+    b.switches = "pzQ";
+    return b;
+}
+
+double peak_rss_mb()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0.0;
+    return static_cast<double>(pmc.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);  // bytes
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;             // KiB
+#endif
+#endif
+}
+
+double median(std::vector<double> v)
+{
+    std::sort(v.begin(), v.end());
+    const std::size_t n = v.size();
+    return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const Args args = parse_args(argc, argv);
+
+    tetwrap::PlcBundle bundle;
+    try {
+        bundle = ends_with(args.path, ".smesh") ? load_smesh(args.path) : tetwrap::read_plc_bundle(args.path);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "tetwrap_replay: %s\n", e.what());
+        return 1;
+    }
+    if (args.switches_set) bundle.switches = args.switches;
+    if (!args.boundary) bundle.compute_boundary_faces = false;
+    const tetwrap::PlcInput plc = bundle.view();
+
+    std::printf("input      %s\n", args.path.c_str());
+    std::printf("plc        %d points, %d mesh facets, %d boundary polygons\n", plc.num_vertices,
+                plc.mesh_facets.count, plc.boundary_facets.count);
+    std::printf("switches   %s\n", bundle.switches.c_str());
+    if (bundle.error_code)
+        std::printf("recorded   TetGen code %d (TetGen %s)\n", bundle.error_code, bundle.tetgen_version.c_str());
+
+    tetwrap::RunControl control;
+    control.time_budget_s = args.time_budget_s;
+    tetwrap::RunOptions options;
+    options.kernel_threads = args.threads;
+    options.dump_on_failure = false;
+    if (args.time_budget_s > 0) options.control = &control;
+
+    // Phase names in first-seen order, with the seconds of every run
+    std::vector<std::string> order;
+    std::map<std::string, std::vector<double>> seconds;
+    std::vector<double> totals;
+    int failures = 0;
+    for (int run = 0; run < args.runs; ++run) {
+        try {
+            const tetwrap::MeshResult mesh = tetwrap::run_tetgen(plc, options);
+            double total = 0.0;
+            for (const auto& s : mesh.stats.seconds) {
+                if (!seconds.count(s.first)) order.push_back(s.first);
+                seconds[s.first].push_back(s.second);
+                total += s.second;
+            }
+            totals.push_back(total);
+            if (!args.quiet) {
+                std::printf("\nrun %d: %d tets, %d points, %.3f s\n", run + 1, mesh.out->numberoftetrahedra,
+                            mesh.out->numberofpoints, total);
+                for (const auto& s : mesh.stats.seconds) std::printf("  %-22s %10.4f s\n", s.first, s.second);
+                for (const auto& c : mesh.stats.counters) std::printf("  %-22s %10lld\n", c.first, c.second);
+            }
+        } catch (const std::exception& e) {
+            ++failures;
+            std::printf("\nrun %d failed: %s\n", run + 1, e.what());
+        }
+    }
+
+    if (!totals.empty()) {
+        const std::string title = "summary, " + std::to_string(totals.size()) + " run(s)";
+        std::printf("\n  %-22s %10s %10s %10s\n", title.c_str(), "min", "median", "mean");
+        auto row = [](const char* name, const std::vector<double>& v) {
+            double sum = 0.0;
+            for (double x : v) sum += x;
+            std::printf("  %-22s %10.4f %10.4f %10.4f\n", name, *std::min_element(v.begin(), v.end()), median(v),
+                        sum / static_cast<double>(v.size()));
+        };
+        for (const std::string& name : order) row(name.c_str(), seconds[name]);
+        row("total", totals);
+    }
+    std::printf("peak RSS   %.1f MiB\n", peak_rss_mb());
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+"""
+Replay failure repro bundles.
+
+When TetGen fails, the native module writes the PLC exactly as it was passed
+to TetGen (coordinates, facets, markers, boundary polygons and switches) to a
+``.tetplc`` file and names it in the error message:
+
+    RuntimeError: TetGen failed (code 3): ... | repro=/tmp/tetwrap-fail-...tetplc
+
+    from dtcc_tetgen_wrapper import repro
+    repro.replay("/tmp/tetwrap-fail-...tetplc")                 # same switches
+    repro.replay("/tmp/tetwrap-fail-...tetplc", switches="pq1.2YQ")
+"""
+from __future__ import annotations
+
+import os
+from typing import Any, Dict, Optional, Union
+
+from . import _tetwrap
+from .tetwrapio import TetwrapIO
+
+PathLike = Union[str, "os.PathLike[str]"]
+
+# Bundle fields that are not arguments of _tetrahedralize
+_META = ("error_code", "tetgen_version")
+
+
+def load_bundle(path: PathLike) -> Dict[str, Any]:
+    """
+    Read a repro bundle.
+
+    Returns the keyword arguments of the native ``_tetrahedralize`` call
+    (``vertices``, ``mesh_facets``, ``boundary_facets``, ``tetgen_switches``,
+    ...) plus ``error_code`` and ``tetgen_version`` of the failed run.
+    """
+    return dict(_tetwrap._load_plc_bundle(os.fspath(path)))
+
+
+def replay(
+    path: PathLike,
+    *,
+    switches: Optional[str] = None,
+    interior_default: Optional[int] = -10,
+    dump_dir: Union[PathLike, bool] = False,
+    **kwargs: Any,
+) -> TetwrapIO:
+    """
+    Run a bundled PLC through TetGen again, optionally with other `switches`.
+
+    Extra keyword arguments (``progress``, ``time_budget_s``, ...) are passed
+    to the native call. A failing replay raises like the original run; it
+    does not write another bundle unless `dump_dir` is given.
+    """
+    args = load_bundle(path)
+    for name in _META:
+        args.pop(name)
+    if switches is not None:
+        args["tetgen_switches"] = switches
+    args["dump_dir"] = dump_dir if isinstance(dump_dir, bool) else os.fspath(dump_dir)
+    args.update(kwargs)
+    return TetwrapIO(_tetwrap._tetrahedralize(**args), interior_default=interior_default)
+
+
+__all__ = ["load_bundle", "replay"]
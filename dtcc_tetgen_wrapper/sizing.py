@@ -0,0 +1,129 @@
+"""
+Native sizing kernels for TetGen's quality refinement.
+
+Each kernel gives a target edge length at a point; the field is the minimum
+over all kernels, and a tet is split while its longest edge exceeds the field
+at its centroid. The kernels are evaluated in C++ from TetGen's refinement
+loop, so no Python code runs per tet. Refinement is TetGen's ``-q`` stage,
+which is switched on when a field is given.
+
+    sizing = [
+        HeightSizing(size=2.0, growth=0.3, max_size=40.0),
+        SurfaceDistanceSizing(wall_points, wall_triangles, size=1.0, growth=0.5, max_size=20.0),
+        BoxZone((0, 0, 0), (100, 50, 10), size=0.5),
+    ]
+    io = tetrahedralize(vertices, faces, boundary_facets, sizing=sizing)
+"""
+from __future__ import annotations
+
+import math
+from typing import Any, Dict, List, NamedTuple, Optional, Sequence, Union
+
+import numpy as np
+
+
+class HeightSizing(NamedTuple):
+    """
+    ``min(max_size, size + growth * max(0, z - ground_z))``: fine at street
+    level, coarse aloft. `ground_z` defaults to the lowest input point.
+    """
+
+    size: float
+    growth: float
+    max_size: float = math.inf
+    ground_z: Optional[float] = None
+
+
+class SurfaceDistanceSizing(NamedTuple):
+    """
+    ``min(max_size, size + growth * d)`` with `d` the distance to a triangle
+    surface (e.g. building walls and roofs) given by `points` (P,3) and
+    `triangles` (S,3). `max_size` must be finite; it bounds the search.
+    """
+
+    points: np.ndarray
+    triangles: np.ndarray
+    size: float
+    growth: float
+    max_size: float
+
+
+class BoxZone(NamedTuple):
+    """`size` inside the axis-aligned box [lo, hi], no constraint outside."""
+
+    lo: Sequence[float]
+    hi: Sequence[float]
+    size: float
+
+
+class SphereZone(NamedTuple):
+    """`size` within `radius` of `center`, no constraint outside."""
+
+    center: Sequence[float]
+    radius: float
+    size: float
+
+
+class GridSizing(NamedTuple):
+    """
+    A background field of target edge lengths on a regular grid:
+    ``values[i, j, k]`` (all > 0) is the size at ``origin + (i, j, k) * spacing``,
+    so axis 0 runs along x. The field is interpolated trilinearly between the
+    nodes and clamped to the grid outside it. `spacing` is one value or one
+    per axis. float32 and float64 values are read in place, without a copy.
+    """
+
+    origin: Sequence[float]
+    spacing: Union[float, Sequence[float]]
+    values: np.ndarray
+
+
+SizingKernel = Union[HeightSizing, SurfaceDistanceSizing, BoxZone, SphereZone, GridSizing]
+
+
+def _point(p: Sequence[float]) -> List[float]:
+    return [float(x) for x in p]
+
+
+def native_sizing(kernels: Sequence[SizingKernel], points: np.ndarray) -> List[Dict[str, Any]]:
+    """The kernel dicts the native module expects; `points` supplies the default ground."""
+    out: List[Dict[str, Any]] = []
+    for k in kernels:
+        if isinstance(k, HeightSizing):
+            ground = k.ground_z
+            if ground is None:
+                ground = float(np.min(np.asarray(points)[:, 2])) if len(points) else 0.0
+            out.append(
+                {"kind": "height", "size": float(k.size), "growth": float(k.growth),
+                 "max_size": float(k.max_size), "ground_z": float(ground)}
+            )
+        elif isinstance(k, SurfaceDistanceSizing):
+            out.append(
+                {"kind": "distance", "size": float(k.size), "growth": float(k.growth),
+                 "max_size": float(k.max_size),
+                 "points": np.ascontiguousarray(k.points, dtype=np.float64),
+                 "triangles": np.ascontiguousarray(k.triangles, dtype=np.int32)}
+            )
+        elif isinstance(k, BoxZone):
+            out.append({"kind": "box", "lo": _point(k.lo), "hi": _point(k.hi), "size": float(k.size)})
+        elif isinstance(k, SphereZone):
+            out.append(
+                {"kind": "sphere", "center": _point(k.center), "radius": float(k.radius), "size": float(k.size)}
+            )
+        elif isinstance(k, GridSizing):
+            spacing = [float(k.spacing)] * 3 if np.isscalar(k.spacing) else _point(k.spacing)
+            out.append({"kind": "grid", "origin": _point(k.origin), "spacing": spacing, "values": np.asarray(k.values)})
+        else:
+            raise TypeError(f"unsupported sizing kernel: {type(k).__name__}")
+    return out
+
+
+__all__ = [
+    "HeightSizing",
+    "SurfaceDistanceSizing",
+    "BoxZone",
+    "SphereZone",
+    "GridSizing",
+    "SizingKernel",
+    "native_sizing",
+]
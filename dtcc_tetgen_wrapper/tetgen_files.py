@@ -0,0 +1,155 @@
+"""
+Read and write TetGen's own file formats (.node/.ele/.face/.neigh/.smesh/.poly).
+
+Parsing and formatting run natively on all cores; arrays come back 0-based
+and in the same layout as `TetwrapIO`, so a mesh read from disk can be used
+(or exported with `write_vtu`) like a fresh result.
+
+    io = read_tetgen("city")             # city.node, city.ele, [city.face, city.neigh]
+    write_tetgen("city_copy", io, first_index=1)
+"""
+from __future__ import annotations
+
+import os
+from pathlib import Path
+from typing import Any, Optional, Tuple, Union
+
+import numpy as np
+
+from . import _tetwrap
+from .adapter import FacetCSR
+from .tetwrapio import TetwrapIO
+
+PathLike = Union[str, "os.PathLike[str]"]
+
+
+class TetgenFilesIO:
+    """Raw result read from TetGen files; mirrors the pybind11 TetwrapIO."""
+
+    def __init__(self, **fields: Any) -> None:
+        self.points: Optional[np.ndarray] = None
+        self.tets: Optional[np.ndarray] = None
+        self.tri_faces: Optional[np.ndarray] = None
+        self.tri_markers: Optional[np.ndarray] = None
+        self.boundary_tri_faces: Optional[np.ndarray] = None
+        self.boundary_tri_markers: Optional[np.ndarray] = None
+        self.edges: Optional[np.ndarray] = None
+        self.edge_markers: Optional[np.ndarray] = None
+        self.neighbors: Optional[np.ndarray] = None
+        self.point_markers: Optional[np.ndarray] = None
+        self.tet_attr: Optional[np.ndarray] = None
+        self.tet_vol: Optional[np.ndarray] = None
+        self.corners = 4
+        self.switches = ""
+        self.stats: dict = {}
+        for name, value in fields.items():
+            setattr(self, name, value)
+
+
+def _stem(path: PathLike) -> str:
+    """Basename without a TetGen extension, so "mesh" and "mesh.node" both work."""
+    p = os.fspath(path)
+    root, ext = os.path.splitext(p)
+    return root if ext in (".node", ".ele", ".face", ".neigh", ".smesh") else p
+
+
+def read_tetgen(path: PathLike, *, num_threads: int = 0) -> TetwrapIO:
+    """
+    Read ``<stem>.node`` and, when present, ``.ele``, ``.face`` and ``.neigh``.
+
+    Indices are rebased by the first point number of the .node file. Markers
+    are returned as stored in the files (no normalization).
+    """
+    stem = _stem(path)
+    node = _tetwrap._read_tetgen_node(stem + ".node", num_threads=num_threads)
+    first = int(node["first_index"])
+    fields: dict = {"points": node["points"], "point_markers": node["markers"]}
+    if os.path.exists(stem + ".ele"):
+        ele = _tetwrap._read_tetgen_ele(stem + ".ele", first_index=first, num_threads=num_threads)
+        fields.update(tets=ele["tets"], tet_attr=ele["attributes"], corners=int(ele["tets"].shape[1]))
+    else:
+        fields["tets"] = np.empty((0, 4), dtype=np.int32)
+    if os.path.exists(stem + ".face"):
+        face = _tetwrap._read_tetgen_face(stem + ".face", first_index=first, num_threads=num_threads)
+        fields.update(tri_faces=face["faces"], tri_markers=face["markers"])
+    if os.path.exists(stem + ".neigh"):
+        fields["neighbors"] = _tetwrap._read_tetgen_neigh(stem + ".neigh", first_index=first, num_threads=num_threads)
+    return TetwrapIO(TetgenFilesIO(**fields), normalize_on_init=False)
+
+
+def write_tetgen(path: PathLike, io: Any, *, first_index: int = 0, num_threads: int = 0) -> None:
+    """
+    Write ``<stem>.node`` and ``.ele``, plus ``.face`` and ``.neigh`` when `io` has them.
+
+    `io` is a `TetwrapIO` or anything with the same fields. Faces are the
+    boundary faces when available, else ``tri_faces``; markers are written as
+    held by `io`.
+    """
+    stem = _stem(path)
+    _tetwrap._write_tetgen_node(
+        stem + ".node", io.points, markers=getattr(io, "point_markers", None),
+        first_index=first_index, num_threads=num_threads,
+    )
+    _tetwrap._write_tetgen_ele(
+        stem + ".ele", io.tets, attributes=getattr(io, "tet_attr", None),
+        first_index=first_index, num_threads=num_threads,
+    )
+    faces = getattr(io, "boundary_tri_faces", None)
+    markers = getattr(io, "boundary_tri_markers", None)
+    if faces is None:
+        faces, markers = getattr(io, "tri_faces", None), getattr(io, "tri_markers", None)
+    if faces is not None:
+        _tetwrap._write_tetgen_face(stem + ".face", faces, markers=markers, first_index=first_index, num_threads=num_threads)
+    neighbors = getattr(io, "neighbors", None)
+    if neighbors is not None and len(neighbors) > 0:
+        _tetwrap._write_tetgen_neigh(stem + ".neigh", neighbors, first_index=first_index, num_threads=num_threads)
+
+
+def read_smesh(path: PathLike, *, num_threads: int = 0) -> Tuple[np.ndarray, FacetCSR, np.ndarray]:
+    """
+    Read a PLC from a .smesh or .poly file (and its .node file when the nodes
+    are not inline). .poly facets must be one polygon without holes.
+
+    Returns ``(vertices, facets, holes)`` with the facets as a `FacetCSR`,
+    ready to pass to `tetrahedralize`.
+    """
+    p = Path(path)
+    node_path = p.with_suffix(".node")
+    first = -1
+    vertices = None
+    if node_path.exists():
+        node = _tetwrap._read_tetgen_node(os.fspath(node_path), num_threads=num_threads)
+        vertices, first = node["points"], int(node["first_index"])
+    smesh = _tetwrap._read_tetgen_smesh(os.fspath(p), first_index=first)
+    if smesh["points"] is not None:
+        vertices = smesh["points"]
+    if vertices is None:
+        raise FileNotFoundError(f"{p} has no inline nodes and {node_path} does not exist")
+    facets = FacetCSR(smesh["facet_offsets"], smesh["facet_indices"], smesh["facet_markers"])
+    return vertices, facets, smesh["holes"]
+
+
+def write_smesh(
+    path: PathLike,
+    vertices: np.ndarray,
+    facets: FacetCSR,
+    holes: Optional[np.ndarray] = None,
+    *,
+    first_index: int = 0,
+) -> None:
+    """Write a PLC as ``<stem>.smesh`` (or a ``.poly`` path) with its vertices in ``<stem>.node``."""
+    p = Path(path)
+    if p.suffix != ".poly":
+        p = p.with_suffix(".smesh")
+    _tetwrap._write_tetgen_node(os.fspath(p.with_suffix(".node")), vertices, first_index=first_index)
+    _tetwrap._write_tetgen_smesh(
+        os.fspath(p),
+        np.asarray(facets.offsets, dtype=np.int64),
+        np.asarray(facets.indices, dtype=np.int32),
+        facet_markers=facets.markers,
+        holes=holes,
+        first_index=first_index,
+    )
+
+
+__all__ = ["read_tetgen", "write_tetgen", "read_smesh", "write_smesh", "TetgenFilesIO"]
@@ -1,8 +1,9 @@
 """Wrapper around the pybind11 TetwrapIO with marker normalization helpers."""
 from __future__ import annotations
 
+import os
 from dataclasses import dataclass, field
-from typing import Any, Optional
+from typing import Any, Optional, Union
 
 import numpy as np
 
@@ -17,6 +18,9 @@ class TetwrapIO:
     interior_default: Optional[int] = -10
     normalize_on_init: bool = True
     _normalized: bool = field(default=False, init=False, repr=False)
+    # TetGen's markers before normalization, which is not invertible (e.g. a
+    # raw -10 and a raw 0 both become -10); kept for feeding a mesh back in
+    _raw: dict = field(default_factory=dict, init=False, repr=False)
 
     def __post_init__(self) -> None:
         if self.normalize_on_init:
@@ -26,10 +30,22 @@ class TetwrapIO:
         """Normalize face markers in place, undoing offsets and remapping 0 to the default."""
         if self._normalized and not force:
             return
-        self._normalize_marker_array(self._io.boundary_tri_markers)
-        self._normalize_marker_array(self._io.tri_markers)
+        for name in ("boundary_tri_markers", "tri_markers"):
+            markers = getattr(self._io, name)
+            if markers is not None and name not in self._raw:
+                self._raw[name] = np.array(markers, copy=True)
+            self._normalize_marker_array(markers)
         object.__setattr__(self, "_normalized", True)
 
+    def raw_markers(self, name: str = "boundary_tri_markers") -> Optional[np.ndarray]:
+        """`boundary_tri_markers` or `tri_markers` exactly as TetGen returned them."""
+        if name not in ("boundary_tri_markers", "tri_markers"):
+            raise ValueError(f"no marker array named {name!r}")
+        markers = getattr(self._io, name)
+        if markers is None or not self._normalized:
+            return markers
+        return self._raw.get(name, markers)
+
     def _normalize_marker_array(self, markers: Any) -> None:
         """Normalize TetGen marker array from 1-based to 0-based indexing.
 
@@ -50,6 +66,33 @@ class TetwrapIO:
             arr[arr == 0] = self.interior_default
         np.subtract(arr, 1, out=arr, where=arr > 0)
 
+    def _mesh_arrays(self, boundary_faces: bool) -> tuple:
+        faces = self._io.boundary_tri_faces if boundary_faces else None
+        markers = self._io.boundary_tri_markers if faces is not None else None
+        return self._io.points, self._io.tets, faces, markers
+
+    def write_vtu(
+        self,
+        path: Union[str, "os.PathLike[str]"],
+        *,
+        boundary_faces: bool = True,
+        compress: bool = False,
+        num_threads: int = 0,
+    ) -> None:
+        """Write tets (and boundary faces with their markers) to a binary VTU file.
+
+        Written natively from the output buffers; ``compress`` needs a build with zlib.
+        """
+        points, tets, faces, markers = self._mesh_arrays(boundary_faces)
+        _tetwrap._write_vtu(
+            os.fspath(path), points, tets, faces, markers, compress=compress, num_threads=num_threads
+        )
+
+    def write_xdmf(self, path: Union[str, "os.PathLike[str]"], *, boundary_faces: bool = True) -> None:
+        """Write an XDMF file plus its raw ``.bin`` data file (same name, .bin extension)."""
+        points, tets, faces, markers = self._mesh_arrays(boundary_faces)
+        _tetwrap._write_xdmf(os.fspath(path), points, tets, faces, markers)
+
     def raw(self) -> _tetwrap.TetwrapIO:
         """Return the underlying pybind11 object."""
         return self._io
@@ -2,6 +2,8 @@
 
 from __future__ import annotations
 
+import os
+
 import numpy as np
 import pytest
 
@@ -141,3 +143,506 @@ def test_requesting_outputs_sets_switches(monkeypatch: pytest.MonkeyPatch) -> No
     assert isinstance(boundary_markers, np.ndarray)
     # Markers are normalized: 0 -> default (-10), positives are shifted down.
     assert set(boundary_markers.tolist()) == {-10, 1}
+
+
+def test_batch_normalizes_each_plc(monkeypatch: pytest.MonkeyPatch) -> None:
+    """tetrahedralize_batch packs every PLC and wraps each result."""
+    captured = {}
+
+    def _fake_batch(plcs, ret_boundary, num_threads):
+        captured["plcs"] = plcs
+        captured["return_boundary_faces"] = ret_boundary
+        captured["num_threads"] = num_threads
+        return [_DummyTetwrapResult() for _ in plcs]
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize_batch", _fake_batch, raising=False)
+
+    ios = adapter.tetrahedralize_batch(
+        [
+            {"vertices": _vertices(), "faces": _faces(), "boundary_facets": _boundary()},
+            {
+                "vertices": _vertices(),
+                "faces": _faces(),
+                "boundary_facets": {"top": [0, 1, 2]},
+                "face_markers": [1, 2, 3],
+                "switches_params": {"quality": 2},
+            },
+        ],
+        num_threads=4,
+    )
+
+    assert len(ios) == 2
+    assert all(isinstance(io, TetwrapIO) for io in ios)
+    assert captured["num_threads"] == 4
+    assert captured["return_boundary_faces"] is False
+
+    first, second = captured["plcs"]
+    assert first[2] is None
+    assert first[3] == [[0, 1, 2]]
+    assert "q2" not in first[4]
+    assert second[2].dtype == np.int32
+    assert "q2" in second[4]
+
+
+def test_batch_reports_bad_plc_index() -> None:
+    """Validation errors name the offending PLC."""
+    with pytest.raises(ValueError, match="PLC 1"):
+        adapter.tetrahedralize_batch(
+            [
+                {"vertices": _vertices(), "faces": _faces(), "boundary_facets": _boundary()},
+                {"vertices": _vertices(), "faces": _faces()},
+            ]
+        )
+
+
+def test_native_dtypes_pass_through_untouched(monkeypatch: pytest.MonkeyPatch) -> None:
+    """float32/int32 inputs reach the native module without a conversion copy."""
+    captured = {}
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary):
+        captured["vertices"] = V
+        captured["faces"] = F
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    V = _vertices().astype(np.float32)
+    F = _faces().astype(np.int32)
+    adapter.tetrahedralize(V, F, _boundary())
+
+    assert captured["vertices"] is V
+    assert captured["faces"] is F
+
+
+def test_other_dtypes_are_converted_once(monkeypatch: pytest.MonkeyPatch) -> None:
+    """Unsupported dtypes are widened to float64/int64 in the adapter."""
+    captured = {}
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary):
+        captured["vertices"] = V
+        captured["faces"] = F
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    adapter.tetrahedralize(_vertices().astype(np.float16), _faces().astype(np.uint16), _boundary())
+
+    assert captured["vertices"].dtype == np.float64
+    assert captured["faces"].dtype == np.int64
+
+
+def test_csr_facets_are_passed_as_offsets(monkeypatch: pytest.MonkeyPatch) -> None:
+    """FacetCSR inputs reach the native module as flat indices plus offsets."""
+    captured = {}
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        captured.update(faces=F, face_markers=F_markers, boundary=B, kwargs=kwargs)
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    faces = adapter.FacetCSR(
+        offsets=np.array([0, 3, 7]),
+        indices=np.array([0, 1, 2, 0, 1, 3, 2], dtype=np.int32),
+        markers=[4, 5],
+    )
+    boundary = adapter.FacetCSR(offsets=[0, 3], indices=[0, 2, 3], markers=[7])
+    adapter.tetrahedralize(_vertices(), faces, boundary)
+
+    assert captured["faces"] is faces.indices
+    assert captured["face_markers"].tolist() == [4, 5]
+    assert captured["boundary"].tolist() == [0, 2, 3]
+    assert captured["kwargs"]["mesh_facet_offsets"].dtype == np.int64
+    assert captured["kwargs"]["boundary_facet_offsets"].tolist() == [0, 3]
+    assert captured["kwargs"]["boundary_facet_markers"].tolist() == [7]
+
+
+def test_csr_rejects_short_polygons() -> None:
+    """Every CSR polygon needs at least three vertices."""
+    faces = adapter.FacetCSR(offsets=[0, 2], indices=[0, 1])
+    with pytest.raises(ValueError, match="at least 3 vertices"):
+        adapter.tetrahedralize(_vertices(), faces, _boundary())
+
+
+def test_boundary_faces_do_not_force_face_or_neighbor_output(monkeypatch: pytest.MonkeyPatch) -> None:
+    """Boundary faces are recovered natively without requesting -f/-n."""
+    called = {}
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary):
+        called["switch_str"] = switch_str
+        called["return_boundary_faces"] = ret_boundary
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    adapter.tetrahedralize(_vertices(), _faces(), _boundary(), return_boundary_faces=True)
+
+    assert called["return_boundary_faces"] is True
+    assert "f" not in called["switch_str"]
+    assert "n" not in called["switch_str"]
+
+
+def test_progress_and_cancel_are_forwarded(monkeypatch: pytest.MonkeyPatch) -> None:
+    """Progress/cancel reach the native call only when given."""
+    calls = []
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        calls.append(kwargs)
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    adapter.tetrahedralize(_vertices(), _faces(), _boundary())
+    token = object()
+    adapter.tetrahedralize(_vertices(), _faces(), _boundary(), progress=print, cancel=token, progress_interval=2)
+
+    assert calls[0] == {}
+    assert calls[1] == {"progress": print, "cancel": token, "progress_interval": 2.0}
+
+
+def test_budgets_are_forwarded_and_validated(monkeypatch: pytest.MonkeyPatch) -> None:
+    """Time/memory budgets are passed through; non-positive budgets are rejected."""
+    called = {}
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        called.update(kwargs)
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    adapter.tetrahedralize(_vertices(), _faces(), _boundary(), time_budget_s=30, memory_budget_bytes=2**30)
+    assert called == {"time_budget_s": 30.0, "memory_budget_bytes": 2**30}
+
+    with pytest.raises(ValueError, match="memory_budget_bytes"):
+        adapter.tetrahedralize(_vertices(), _faces(), _boundary(), memory_budget_bytes=0)
+
+
+def test_output_dir_is_forwarded(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    """output_dir reaches the native call as a plain string."""
+    called = {}
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        called.update(kwargs)
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    adapter.tetrahedralize(_vertices(), _faces(), _boundary(), output_dir=tmp_path / "mesh")
+
+    assert called == {"output_dir": str(tmp_path / "mesh")}
+
+
+def test_dump_dir_is_forwarded(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    """dump_dir is omitted by default, a string for paths and kept as False."""
+    calls = []
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        calls.append(kwargs)
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    adapter.tetrahedralize(_vertices(), _faces(), _boundary())
+    adapter.tetrahedralize(_vertices(), _faces(), _boundary(), dump_dir=tmp_path / "dumps")
+    adapter.tetrahedralize(_vertices(), _faces(), _boundary(), dump_dir=False)
+
+    assert calls == [{}, {"dump_dir": str(tmp_path / "dumps")}, {"dump_dir": False}]
+
+
+def test_tiled_forwards_tiles_and_spacing(monkeypatch: pytest.MonkeyPatch) -> None:
+    """tetrahedralize_tiled passes the tile grid and derives spacing from max_volume."""
+    calls = []
+
+    def _fake_tiled(V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        calls.append((switch_str, kwargs))
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize_tiled", _fake_tiled, raising=False)
+
+    io = adapter.tetrahedralize_tiled(_vertices(), _faces(), _boundary(), tiles=(3, 2), num_threads=4)
+    adapter.tetrahedralize_tiled(
+        _vertices(), _faces(), _boundary(), switches_params={"max_volume": 2.0}, return_neighbors=True
+    )
+    adapter.tetrahedralize_tiled(_vertices(), _faces(), _boundary(), spacing=0.25)
+
+    assert isinstance(io, TetwrapIO)
+    assert calls[0][1] == {"tiles_x": 3, "tiles_y": 2, "spacing": 0.0, "num_threads": 4}
+    assert calls[1][1]["spacing"] == pytest.approx((12.0 * np.sqrt(2.0)) ** (1.0 / 3.0))
+    assert "n" in calls[1][0]
+    assert calls[2][1]["spacing"] == 0.25
+
+    with pytest.raises(ValueError, match="tiles"):
+        adapter.tetrahedralize_tiled(_vertices(), _faces(), _boundary(), tiles=(0, 2))
+
+
+def test_remesh_region_passes_raw_markers_and_patch(monkeypatch: pytest.MonkeyPatch) -> None:
+    """remesh_region hands TetGen's raw boundary markers and the patch PLC to the native call."""
+    calls = []
+
+    def _fake_remesh(points, tets, neighbors, bfaces, btets, blocal, bmarkers, box_min, box_max,
+                     V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        calls.append((neighbors, bmarkers.copy(), box_min, box_max, V.shape, F.shape, F_markers, B, switch_str))
+        return _DummyTetwrapResult(), np.arange(4, dtype=np.int32), np.zeros(1, dtype=np.int32)
+
+    monkeypatch.setattr(adapter._tetwrap, "_remesh_region", _fake_remesh, raising=False)
+
+    raw = _DummyTetwrapResult()
+    raw.corners = 4
+    raw.boundary_tri_faces = np.array([[1, 2, 3], [0, 3, 2], [0, 1, 3], [0, 2, 1]], dtype=np.int32)
+    raw.boundary_tri_markers = np.array([0, 1, -10, -2], dtype=np.int32)
+    raw.boundary_tri_tets = np.zeros(4, dtype=np.int32)
+    raw.boundary_tri_local_faces = np.arange(4, dtype=np.int32)
+    io = TetwrapIO(raw)
+
+    result = adapter.remesh_region(io, (0, 0, 0), (0.5, 0.5, 0.5))
+    adapter.remesh_region(
+        io, [0, 0, 0], [1, 1, 1], _vertices(), _faces(), face_markers=[4, 5, 6], switches_params={"max_volume": 0.1}
+    )
+
+    assert isinstance(result, adapter.RemeshResult)
+    assert isinstance(result.io, TetwrapIO)
+    assert result.point_map.tolist() == [0, 1, 2, 3]
+    neighbors, markers, box_min, box_max, V_shape, F_shape, F_markers, B, switch_str = calls[0]
+    assert neighbors is raw.neighbors
+    # polygon 8's raw -10 must not come back as 0, though both normalize to -10
+    assert io.boundary_tri_markers.tolist() == [-10, 0, -10, -2]
+    assert markers.tolist() == [0, 1, -10, -2]
+    assert box_min == (0.0, 0.0, 0.0) and box_max == (0.5, 0.5, 0.5)
+    assert V_shape == (0, 3) and F_shape == (0, 3) and F_markers is None and B == []
+    assert "n" in switch_str
+    assert calls[1][4] == (4, 3) and calls[1][6].tolist() == [4, 5, 6]
+    assert "a0.1" in calls[1][8]
+
+    raw.boundary_tri_tets = None
+    with pytest.raises(ValueError, match="boundary faces"):
+        adapter.remesh_region(TetwrapIO(raw), (0, 0, 0), (1, 1, 1))
+
+
+def test_refine_passes_mesh_volumes_and_raw_markers(monkeypatch: pytest.MonkeyPatch) -> None:
+    """refine hands the previous mesh, per-tet volumes and raw face markers to the native call."""
+    calls = []
+
+    def _fake_refine(points, tets, faces, face_markers, tet_volumes, tet_attr, switch_str, ret_boundary, **kwargs):
+        calls.append((tets, faces, face_markers.copy(), tet_volumes, tet_attr, switch_str, ret_boundary))
+        return _DummyTetwrapResult()
+
+    monkeypatch.setattr(adapter._tetwrap, "_refine", _fake_refine, raising=False)
+
+    raw = _DummyTetwrapResult()
+    raw.tets = np.array([[0, 1, 2, 3]], dtype=np.int32)
+    raw.boundary_tri_faces = np.array([[1, 2, 3], [0, 3, 2], [0, 1, 3], [0, 2, 1]], dtype=np.int32)
+    raw.boundary_tri_markers = np.array([0, 1, -10, -2], dtype=np.int32)
+    raw.tri_faces = raw.tri_markers = raw.tet_attr = None
+    io = TetwrapIO(raw)
+
+    result = adapter.refine(io, [0.01], switches_params={"quality": True})
+    adapter.refine(io)
+
+    assert isinstance(result, TetwrapIO)
+    tets, faces, markers, tet_volumes, tet_attr, switch_str, ret_boundary = calls[0]
+    assert tets is raw.tets and faces is raw.boundary_tri_faces
+    # -10 (polygon 8) survives; only raw 0 marks an interior face to drop
+    assert markers.tolist() == [0, 1, -10, -2]
+    assert tet_volumes.dtype == np.float64 and tet_volumes.tolist() == [0.01]
+    assert tet_attr is raw.tet_attr and ret_boundary is True
+    assert "r" in switch_str and "p" not in switch_str and "q" in switch_str
+    assert calls[1][3] is None
+
+    with pytest.raises(ValueError, match="one value per tet"):
+        adapter.refine(io, [0.01, 0.02])
+
+
+# Native meshing checks (real TetGen runs)
+
+# Faces of a tet, face k opposite corner k like TetGen's neighbor order
+_TET_FACES = np.array([[1, 2, 3], [0, 2, 3], [0, 1, 3], [0, 1, 2]])
+
+# A 2 x 1 x 1 box: bottom, top, y-min, y-max, x-min, x-max
+_BOX_VERTICES = np.array(
+    [[0, 0, 0], [2, 0, 0], [2, 1, 0], [0, 1, 0], [0, 0, 1], [2, 0, 1], [2, 1, 1], [0, 1, 1]], dtype=float
+)
+_BOX_FACETS = [[0, 3, 2, 1], [4, 5, 6, 7], [0, 1, 5, 4], [2, 3, 7, 6], [0, 4, 7, 3], [1, 2, 6, 5]]
+
+
+def _volume(io: TetwrapIO) -> float:
+    c = np.asarray(io.points)[np.asarray(io.tets)]
+    det = np.einsum("ij,ij->i", np.cross(c[:, 1] - c[:, 0], c[:, 2] - c[:, 0]), c[:, 3] - c[:, 0])
+    return float(np.abs(det).sum() / 6)
+
+
+def _area(io: TetwrapIO) -> float:
+    c = np.asarray(io.points)[np.asarray(io.boundary_tri_faces)]
+    return float(np.linalg.norm(np.cross(c[:, 1] - c[:, 0], c[:, 2] - c[:, 0]), axis=1).sum() / 2)
+
+
+def _check_neighbors(io: TetwrapIO) -> None:
+    """Neighbors are mutual and share the face across; hull faces are the boundary faces."""
+    tets, nb = np.asarray(io.tets), np.asarray(io.neighbors)
+    faces = np.sort(tets[:, _TET_FACES], axis=2)
+    t, k = np.nonzero(nb >= 0)
+    n = nb[t, k]
+    back = nb[n] == t[:, None]
+    assert back.any(axis=1).all()
+    np.testing.assert_array_equal(faces[t, k], faces[n, back.argmax(axis=1)])
+    assert (nb == -1).sum() == len(io.boundary_tri_faces)
+
+
+def _closed(faces: np.ndarray) -> bool:
+    """Every edge of the triangle set is shared by exactly two triangles."""
+    edges = np.sort(faces[:, [[0, 1], [1, 2], [2, 0]]].reshape(-1, 2), axis=1)
+    _, counts = np.unique(edges, axis=0, return_counts=True)
+    return bool((counts == 2).all())
+
+
+def test_native_tiled_matches_untiled() -> None:
+    """Two tiles stitch into one conforming mesh of the same domain as an untiled run."""
+    kwargs = dict(switches_params={"max_volume": 0.02}, return_boundary_faces=True, return_neighbors=True)
+    empty = np.empty((0, 3), dtype=np.int32)
+    whole = adapter.tetrahedralize(_BOX_VERTICES, empty, _BOX_FACETS, **kwargs)
+    tiled = adapter.tetrahedralize_tiled(_BOX_VERTICES, empty, _BOX_FACETS, tiles=(2, 1), **kwargs)
+
+    assert _volume(whole) == pytest.approx(2.0)
+    assert _volume(tiled) == pytest.approx(_volume(whole))
+    _check_neighbors(tiled)
+
+    # Every boundary face lies on a side of the box: none on the cut near x = 1
+    c = np.asarray(tiled.points)[np.asarray(tiled.boundary_tri_faces)]
+    on_side = [np.isclose(c[:, :, a], v).all(axis=1) for a in range(3) for v in (0.0, _BOX_VERTICES[:, a].max())]
+    assert np.logical_or.reduce(on_side).all()
+    assert _area(tiled) == pytest.approx(_area(whole))
+    assert _closed(np.asarray(tiled.boundary_tri_faces))
+    assert set(tiled.boundary_tri_markers.tolist()) == set(whole.boundary_tri_markers.tolist())
+
+
+def test_native_tiled_drops_unused_top_vertices() -> None:
+    """Vertices only on the rebuilt top / side polygons leave no orphan points."""
+    # The 2 x 1 x 1 box with extra vertices on the top edges at x = 0.5 and 1.5
+    extra = np.array([[0.5, 0, 1], [1.5, 0, 1], [1.5, 1, 1], [0.5, 1, 1]], dtype=float)
+    vertices = np.vstack([_BOX_VERTICES, extra])
+    facets = [[0, 3, 2, 1], [4, 8, 9, 5, 6, 10, 11, 7], [0, 1, 5, 9, 8, 4], [2, 3, 7, 11, 10, 6]] + _BOX_FACETS[4:]
+    kwargs = dict(switches_params={"max_volume": 0.02}, return_boundary_faces=True, return_neighbors=True)
+    tiled = adapter.tetrahedralize_tiled(vertices, np.empty((0, 3), dtype=np.int32), facets, tiles=(2, 1), **kwargs)
+
+    points, tets = np.asarray(tiled.points), np.asarray(tiled.tets)
+    np.testing.assert_array_equal(np.unique(tets), np.arange(len(points)))
+    # The box corners stay up front in order (the top ones as wall columns' tops)
+    np.testing.assert_array_equal(points[:8], _BOX_VERTICES)
+    assert _volume(tiled) == pytest.approx(2.0)
+    assert _area(tiled) == pytest.approx(10.0)
+    _check_neighbors(tiled)
+
+
+def test_native_remesh_region_splices_conforming_mesh(unit_cube_vertices, unit_cube_faces) -> None:
+    """Kept points, tets and boundary markers map through point_map / tet_map unchanged."""
+    io = adapter.tetrahedralize(
+        unit_cube_vertices,
+        np.empty((0, 3), dtype=np.int32),
+        unit_cube_faces.tolist(),
+        switches_params={"max_volume": 0.01},
+        return_boundary_faces=True,
+        return_neighbors=True,
+    )
+    box_min, box_max = np.array([0.0, 0.0, 0.0]), np.array([0.4, 0.4, 0.3])
+    new, point_map, tet_map = adapter.remesh_region(io, box_min, box_max, switches_params={"max_volume": 0.001})
+
+    points, tets = np.asarray(io.points), np.asarray(io.tets)
+    corners = points[tets]
+    meets = ((corners.min(axis=1) <= box_max) & (corners.max(axis=1) >= box_min)).all(axis=1)
+    kept_tets, kept_points = tet_map >= 0, point_map >= 0
+    np.testing.assert_array_equal(kept_tets, ~meets)
+    assert len(new.tets) > kept_tets.sum()
+
+    # Kept entities come first, in their old order, with the same geometry
+    np.testing.assert_array_equal(tet_map[kept_tets], np.arange(kept_tets.sum()))
+    np.testing.assert_array_equal(point_map[kept_points], np.arange(kept_points.sum()))
+    np.testing.assert_array_equal(np.asarray(new.points)[point_map[kept_points]], points[kept_points])
+    np.testing.assert_array_equal(np.asarray(new.tets)[tet_map[kept_tets]], point_map[tets[kept_tets]])
+
+    assert _volume(new) == pytest.approx(1.0)
+    assert _area(new) == pytest.approx(6.0)
+    assert _closed(np.asarray(new.boundary_tri_faces))
+    _check_neighbors(new)
+
+    # Boundary faces of kept tets keep their markers
+    new_markers = {
+        tuple(f): m for f, m in zip(np.sort(new.boundary_tri_faces, axis=1).tolist(), new.boundary_tri_markers.tolist())
+    }
+    kept_faces = kept_tets[np.asarray(io.boundary_tri_tets)]
+    assert kept_faces.any() and not kept_faces.all()
+    old_faces = np.sort(point_map[np.asarray(io.boundary_tri_faces)[kept_faces]], axis=1)
+    for face, marker in zip(old_faces.tolist(), np.asarray(io.boundary_tri_markers)[kept_faces].tolist()):
+        assert new_markers[tuple(face)] == marker
+    assert set(new_markers.values()) == set(io.boundary_tri_markers.tolist())
+
+
+@pytest.mark.parametrize("params", [{}, {"output_medit_mesh": True}])
+def test_native_cancel_from_progress(params, unit_cube_vertices, unit_cube_faces, tmp_path, monkeypatch) -> None:
+    """Cancelling from the progress callback stops the run, also under TetGen's own driver (-g)."""
+    monkeypatch.chdir(tmp_path)  # -g writes its .mesh file to the working directory
+    token = adapter.CancelToken()
+    phases = []
+
+    def progress(info):
+        phases.append(info["phase"])
+        token.cancel()
+
+    with pytest.raises(adapter.MeshingAborted) as err:
+        adapter.tetrahedralize(
+            unit_cube_vertices,
+            np.empty((0, 3), dtype=np.int32),
+            unit_cube_faces.tolist(),
+            switches_params={"max_volume": 1e-4, **params},
+            progress=progress,
+            cancel=token,
+        )
+    assert err.value.code == 101
+    assert len(phases) == 1
+
+
+@pytest.mark.parametrize("budget, code", [({"time_budget_s": 1e-9}, 102), ({"memory_budget_bytes": 1}, 103)])
+def test_native_budget_aborts_without_repro(budget, code, unit_cube_vertices, unit_cube_faces, tmp_path) -> None:
+    """An exceeded budget raises MeshingAborted with its code and writes no repro bundle."""
+    with pytest.raises(adapter.MeshingAborted) as err:
+        adapter.tetrahedralize(
+            unit_cube_vertices,
+            np.empty((0, 3), dtype=np.int32),
+            unit_cube_faces.tolist(),
+            switches_params={"max_volume": 1e-4},
+            dump_dir=tmp_path,
+            **budget,
+        )
+    assert err.value.code == code
+    assert list(tmp_path.iterdir()) == []
+
+
+@pytest.mark.skipif(not os.environ.get("TETWRAP_REQUIRE_THREADSAFE"), reason="set in CI, where TetGen must be patched")
+def test_native_tetgen_is_threadsafe() -> None:
+    """The build isolated concurrent TetGen runs instead of silently serializing them."""
+    assert adapter._tetwrap.tetgen_threadsafe
+
+
+def test_native_batch_matches_serial_runs(unit_cube_vertices, unit_cube_faces) -> None:
+    """Concurrent runs on different PLCs give exactly the meshes of one-at-a-time runs."""
+    empty = np.empty((0, 3), dtype=np.int32)
+    # Different sizes give each run its own bounding-box dependent predicate filters
+    plcs = [
+        {
+            "vertices": unit_cube_vertices * scale,
+            "faces": empty,
+            "boundary_facets": unit_cube_faces.tolist(),
+            "switches_params": {"max_volume": 0.002 * scale**3},
+        }
+        for scale in (1.0, 3.0, 10.0)
+    ]
+    box = {"vertices": _BOX_VERTICES, "faces": empty, "boundary_facets": _BOX_FACETS}
+    plcs.append({**box, "switches_params": {"max_volume": 0.003}})
+    kwargs = dict(return_boundary_faces=True, return_neighbors=True)
+    batch = adapter.tetrahedralize_batch(plcs * 2, num_threads=4, **kwargs)
+
+    assert len(batch) == 2 * len(plcs)
+    for plc, io in zip(plcs * 2, batch):
+        serial = adapter.tetrahedralize(
+            plc["vertices"], plc["faces"], plc["boundary_facets"], switches_params=plc["switches_params"], **kwargs
+        )
+        for name in ("points", "tets", "neighbors", "boundary_tri_faces", "boundary_tri_markers"):
+            np.testing.assert_array_equal(getattr(io, name), getattr(serial, name), err_msg=name)
@@ -0,0 +1,122 @@
+"""Tests for the on-disk result cache."""
+
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+from dtcc_tetgen_wrapper import adapter
+from dtcc_tetgen_wrapper.cache import MeshCache, mesh_key
+
+
+class _RawIO:
+    """Raw native result with the fields the cache stores."""
+
+    def __init__(self) -> None:
+        self.points = np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0]])
+        self.tets = np.array([[0, 1, 2, 3]], dtype=np.int32)
+        self.tri_faces = np.array([[0, 1, 2], [0, 2, 3]], dtype=np.int32)
+        self.tri_markers = np.array([1, 0], dtype=np.int32)
+        self.boundary_tri_faces = None
+        self.boundary_tri_markers = None
+        self.neighbors = np.empty((0, 4), dtype=np.int32)
+        self.corners = 4
+        self.switches = "pzQ"
+        self.stats = {"time": {"delaunay": 0.5, "total": 0.5}, "tetrahedra": 1}
+
+
+def _plc():
+    vertices = np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0]])
+    faces = np.array([[0, 1, 2], [0, 1, 3], [0, 2, 3]], dtype=np.int32)
+    return vertices, faces, [[1, 2, 3]]
+
+
+def test_key_depends_on_inputs_and_switches() -> None:
+    V, F, B = _plc()
+    key = mesh_key(V, F, None, B, "pzQ", True)
+
+    assert key == mesh_key(V.copy(), F.copy(), None, [list(p) for p in B], "pzQ", True)
+    assert key != mesh_key(V, F, None, B, "pzQq", True)
+    assert key != mesh_key(V, F, None, B, "pzQ", False)
+    assert key != mesh_key(V, F, np.array([0, 1, 2], dtype=np.int32), B, "pzQ", True)
+    assert key != mesh_key(V, F, None, [[1, 2], [3]], "pzQ", True)
+    moved = V.copy()
+    moved[3, 2] = 2.0
+    assert key != mesh_key(moved, F, None, B, "pzQ", True)
+
+
+def test_key_depends_on_versions(monkeypatch: pytest.MonkeyPatch) -> None:
+    """Upgrading the wrapper or TetGen invalidates existing entries."""
+    V, F, B = _plc()
+    key = mesh_key(V, F, None, B, "pzQ", True)
+
+    monkeypatch.setattr("dtcc_tetgen_wrapper.cache._VERSIONS", "0.0.0;tetgen-0.0")
+    assert key != mesh_key(V, F, None, B, "pzQ", True)
+
+
+def test_round_trip_is_memory_mapped(tmp_path) -> None:
+    cache = MeshCache(tmp_path)
+    raw = _RawIO()
+    assert cache.get("b2-00") is None
+
+    cache.put("b2-00", raw)
+    hit = cache.get("b2-00")
+
+    assert hit is not None
+    assert isinstance(hit.points, np.memmap)
+    np.testing.assert_array_equal(hit.tets, raw.tets)
+    np.testing.assert_array_equal(hit.tri_markers, raw.tri_markers)
+    assert hit.neighbors.shape == (0, 4)
+    assert hit.boundary_tri_faces is None
+    assert hit.switches == "pzQ"
+    assert hit.stats["tetrahedra"] == 1
+    assert hit.stats["cache_hit"] == 1
+
+    # Copy-on-write: normalizing a hit never touches the stored entry
+    hit.tri_markers[:] = 7
+    np.testing.assert_array_equal(cache.get("b2-00").tri_markers, raw.tri_markers)
+
+
+def test_adapter_hit_skips_tetgen(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    calls = []
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        calls.append(switch_str)
+        return _RawIO()
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    V, F, B = _plc()
+    first = adapter.tetrahedralize(V, F, B, cache=tmp_path)
+    second = adapter.tetrahedralize(V, F, B, cache=tmp_path)
+    adapter.tetrahedralize(V, F, B, cache=tmp_path, switches_overrides={"quality": 2.0})
+
+    assert len(calls) == 2
+    # Markers are normalized the same way for fresh and cached results
+    np.testing.assert_array_equal(np.asarray(first.tri_markers), np.asarray(second.tri_markers))
+    assert second.stats["cache_hit"] == 1
+
+
+def test_batch_meshes_only_misses(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    batches = []
+
+    def _fake_batch(plcs, ret_boundary, num_threads, **kwargs):
+        batches.append(len(plcs))
+        return [_RawIO() for _ in plcs]
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize_batch", _fake_batch, raising=False)
+
+    V, F, B = _plc()
+    moved = V.copy()
+    moved[3, 2] = 2.0
+    adapter.tetrahedralize_batch([{"vertices": V, "faces": F, "boundary_facets": B}], cache=tmp_path)
+    ios = adapter.tetrahedralize_batch(
+        [
+            {"vertices": V, "faces": F, "boundary_facets": B},
+            {"vertices": moved, "faces": F, "boundary_facets": B},
+        ],
+        cache=tmp_path,
+    )
+
+    assert batches == [1, 1]
+    assert len(ios) == 2
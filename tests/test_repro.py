@@ -0,0 +1,53 @@
+"""Tests for replaying failure repro bundles."""
+
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+from dtcc_tetgen_wrapper import repro
+
+
+def _bundle():
+    return {
+        "vertices": np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0]]),
+        "mesh_facets": np.array([[0, 1, 2]], dtype=np.int32),
+        "mesh_facet_offsets": None,
+        "mesh_facet_markers": None,
+        "boundary_facets": np.array([0, 1, 3, 0, 2, 3, 1, 2, 3], dtype=np.int32),
+        "boundary_facet_offsets": np.array([0, 3, 6, 9], dtype=np.int64),
+        "boundary_facet_markers": None,
+        "tetgen_switches": "pq1.2zQ",
+        "compute_boundary_faces": True,
+        "error_code": 3,
+        "tetgen_version": "1.6.0",
+    }
+
+
+class _RawIO:
+    def __init__(self) -> None:
+        self.boundary_tri_markers = None
+        self.tri_markers = np.array([1, 0], dtype=np.int32)
+
+
+def test_replay_passes_bundle_to_native(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    calls = []
+    monkeypatch.setattr(repro._tetwrap, "_load_plc_bundle", lambda path: _bundle(), raising=False)
+    monkeypatch.setattr(repro._tetwrap, "_tetrahedralize", lambda **kw: calls.append(kw) or _RawIO())
+
+    repro.replay(tmp_path / "a.tetplc")
+    repro.replay(tmp_path / "a.tetplc", switches="pzQ", time_budget_s=5.0)
+
+    first, second = calls
+    assert first["tetgen_switches"] == "pq1.2zQ"
+    assert first["dump_dir"] is False
+    assert "error_code" not in first and "tetgen_version" not in first
+    assert first["boundary_facet_offsets"].tolist() == [0, 3, 6, 9]
+    assert second["tetgen_switches"] == "pzQ" and second["time_budget_s"] == 5.0
+
+
+def test_load_bundle_keeps_metadata(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    monkeypatch.setattr(repro._tetwrap, "_load_plc_bundle", lambda path: _bundle(), raising=False)
+    bundle = repro.load_bundle(tmp_path / "a.tetplc")
+    assert bundle["error_code"] == 3
+    assert bundle["tetgen_version"] == "1.6.0"
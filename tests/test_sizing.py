@@ -0,0 +1,114 @@
+"""Tests for the native sizing kernel descriptions."""
+
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+from dtcc_tetgen_wrapper import adapter
+from dtcc_tetgen_wrapper.cache import mesh_key
+from dtcc_tetgen_wrapper.sizing import (
+    BoxZone,
+    GridSizing,
+    HeightSizing,
+    SphereZone,
+    SurfaceDistanceSizing,
+    native_sizing,
+)
+
+
+def _points() -> np.ndarray:
+    return np.array([[0.0, 0.0, 2.0], [1.0, 0.0, 3.0], [0.0, 1.0, 5.0]])
+
+
+def test_kernels_become_native_dicts() -> None:
+    """Every kernel maps to one dict with float parameters and contiguous arrays."""
+    wall = SurfaceDistanceSizing(_points().astype(np.float32), [[0, 1, 2]], size=1, growth=0.5, max_size=8)
+    kernels = native_sizing(
+        [HeightSizing(1.0, 0.2), wall, BoxZone((0, 0, 0), (1, 2, 3), 0.5), SphereZone([1, 1, 1], 2, 0.25)],
+        _points(),
+    )
+
+    assert [k["kind"] for k in kernels] == ["height", "distance", "box", "sphere"]
+    assert kernels[0]["ground_z"] == 2.0 and kernels[0]["max_size"] == float("inf")
+    assert kernels[1]["points"].dtype == np.float64 and kernels[1]["triangles"].dtype == np.int32
+    assert kernels[2]["hi"] == [1.0, 2.0, 3.0] and kernels[3]["radius"] == 2.0
+    assert native_sizing([HeightSizing(1.0, 0.2, ground_z=-4)], _points())[0]["ground_z"] == -4.0
+    with pytest.raises(TypeError, match="unsupported sizing kernel"):
+        native_sizing([{"kind": "box"}], _points())
+
+
+def test_grid_values_are_passed_in_place() -> None:
+    """Grid values keep their array and dtype; a scalar spacing applies to every axis."""
+    values = np.full((4, 3, 2), 2.5, dtype=np.float32)
+    grid = native_sizing([GridSizing((0, 0, -1), 0.5, values), GridSizing([1, 2, 3], (1, 2, 4), values)], _points())
+
+    assert grid[0]["kind"] == "grid" and grid[0]["values"] is values
+    assert grid[0]["origin"] == [0.0, 0.0, -1.0] and grid[0]["spacing"] == [0.5, 0.5, 0.5]
+    assert grid[1]["spacing"] == [1.0, 2.0, 4.0]
+
+
+def test_sizing_is_forwarded_and_keyed(monkeypatch: pytest.MonkeyPatch) -> None:
+    """sizing reaches the native call only when given and changes the cache key."""
+    calls = []
+
+    def _fake_tetrahedralize(V, F, F_markers, B, switch_str, ret_boundary, **kwargs):
+        calls.append(kwargs)
+        raise RuntimeError("stop")
+
+    monkeypatch.setattr(adapter._tetwrap, "_tetrahedralize", _fake_tetrahedralize)
+
+    vertices = np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0]])
+    faces = np.array([[0, 1, 2], [0, 1, 3], [0, 2, 3], [1, 2, 3]], dtype=np.int32)
+    for sizing in (None, [SphereZone((0, 0, 0), 1.0, 0.1)]):
+        with pytest.raises(RuntimeError, match="stop"):
+            adapter.tetrahedralize(vertices, faces, [[0, 1, 2]], sizing=sizing)
+
+    assert "sizing" not in calls[0]
+    assert calls[1]["sizing"] == [{"kind": "sphere", "center": [0.0, 0.0, 0.0], "radius": 1.0, "size": 0.1}]
+    args = (vertices, faces, None, [[0, 1, 2]], "pzQ", False)
+    assert mesh_key(*args) != mesh_key(*args, sizing=calls[1]["sizing"])
+
+
+# Native refinement checks (real TetGen runs)
+
+
+def _mesh_box(hi, sizing):
+    """Centroids and longest edges of a mesh of the box [0, hi] refined by `sizing`; -O0 keeps the refined tets."""
+    lo = np.zeros(3)
+    corners = np.array([[x, y, z] for z in (lo[2], hi[2]) for y in (lo[1], hi[1]) for x in (lo[0], hi[0])])
+    facets = [[0, 2, 3, 1], [4, 5, 7, 6], [0, 1, 5, 4], [2, 6, 7, 3], [0, 4, 6, 2], [1, 3, 7, 5]]
+    io = adapter.tetrahedralize(
+        corners, np.empty((0, 3), dtype=np.int32), facets, switches_params={"optimize_level": 0}, sizing=sizing
+    )
+    c = np.asarray(io.points)[np.asarray(io.tets)]
+    edges = c[:, [0, 0, 0, 1, 1, 2]] - c[:, [1, 2, 3, 2, 3, 3]]
+    return c.mean(axis=1), np.linalg.norm(edges, axis=2).max(axis=1)
+
+
+def test_native_box_zone_refines_inside_only() -> None:
+    """Tets centered in the zone are no longer than its size; the rest stay coarse."""
+    h = 0.4
+    centroids, longest = _mesh_box((4.0, 4.0, 4.0), [BoxZone((1, 1, 1), (3, 3, 3), size=h)])
+
+    inside = ((centroids >= 1) & (centroids <= 3)).all(axis=1)
+    assert inside.sum() > 100
+    assert longest[inside].max() <= h * (1 + 1e-9)
+    assert longest[~inside].max() > 4 * h
+
+
+
+def test_native_grid_sizing_follows_x_axis() -> None:
+    """values[i, j, k] is the size at x = origin + i * spacing, clamped outside the grid."""
+    values = np.empty((3, 2, 2))
+    values[:] = np.array([0.15, 0.35, 0.55])[:, None, None]
+    grid = GridSizing(origin=(1.0, 0.0, 0.0), spacing=1.0, values=values)
+    centroids, longest = _mesh_box((4.0, 1.0, 1.0), [grid])
+
+    x = centroids[:, 0]
+    assert (longest <= np.interp(x, [1.0, 2.0, 3.0], values[:, 0, 0]) * (1 + 1e-9)).all()
+    # Fine at the low-x end, coarse at the high-x end, the same along z
+    low, high = longest[x < 1].mean(), longest[x > 3].mean()
+    assert high > 2 * low
+    bottom, top = longest[centroids[:, 2] < 0.5].mean(), longest[centroids[:, 2] > 0.5].mean()
+    assert 0.75 < bottom / top < 1.33
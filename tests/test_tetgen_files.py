@@ -0,0 +1,214 @@
+"""Tests for the TetGen file format helpers."""
+
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+from dtcc_tetgen_wrapper import tetgen_files, tetrahedralize
+from dtcc_tetgen_wrapper.adapter import FacetCSR
+
+
+def _points():
+    return np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0]])
+
+
+def test_read_tetgen_rebases_by_node_numbering(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    calls = {}
+    native = tetgen_files._tetwrap
+    monkeypatch.setattr(
+        native, "_read_tetgen_node",
+        lambda path, num_threads=0: {"points": _points(), "attributes": None, "markers": None, "first_index": 1},
+        raising=False,
+    )
+
+    def _fake_ele(path, first_index=-1, num_threads=0):
+        calls["ele"] = (path, first_index)
+        return {"tets": np.array([[0, 1, 2, 3]], dtype=np.int32), "attributes": None}
+
+    monkeypatch.setattr(native, "_read_tetgen_ele", _fake_ele, raising=False)
+    for ext in (".node", ".ele"):
+        (tmp_path / f"m{ext}").write_text("")
+
+    io = tetgen_files.read_tetgen(tmp_path / "m.node")
+
+    assert calls["ele"] == (str(tmp_path / "m.ele"), 1)
+    assert io.tets.shape == (1, 4)
+    assert io.tri_faces is None and io.neighbors is None
+
+
+def test_write_tetgen_prefers_boundary_faces(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    written = {}
+    native = tetgen_files._tetwrap
+    for name in ("node", "ele", "face", "neigh"):
+        monkeypatch.setattr(
+            native, f"_write_tetgen_{name}",
+            lambda path, array, _n=name, **kw: written.__setitem__(_n, (path, array, kw)),
+            raising=False,
+        )
+    io = tetgen_files.TetgenFilesIO(
+        points=_points(),
+        tets=np.array([[0, 1, 2, 3]], dtype=np.int32),
+        tri_faces=np.array([[0, 1, 2]], dtype=np.int32),
+        boundary_tri_faces=np.array([[1, 2, 3]], dtype=np.int32),
+        boundary_tri_markers=np.array([4], dtype=np.int32),
+        neighbors=np.empty((0, 4), dtype=np.int32),
+    )
+
+    tetgen_files.write_tetgen(tmp_path / "out", io, first_index=1)
+
+    assert sorted(written) == ["ele", "face", "node"]
+    path, faces, kw = written["face"]
+    assert path == str(tmp_path / "out.face")
+    assert faces is io.boundary_tri_faces and kw["markers"] is io.boundary_tri_markers
+    assert kw["first_index"] == 1
+
+
+def test_read_smesh_uses_node_file(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    native = tetgen_files._tetwrap
+    monkeypatch.setattr(
+        native, "_read_tetgen_node",
+        lambda path, num_threads=0: {"points": _points(), "attributes": None, "markers": None, "first_index": 1},
+        raising=False,
+    )
+    seen = {}
+
+    def _fake_smesh(path, first_index=-1):
+        seen["first_index"] = first_index
+        return {
+            "points": None,
+            "point_markers": None,
+            "first_index": first_index,
+            "facet_offsets": np.array([0, 3], dtype=np.int64),
+            "facet_indices": np.array([0, 1, 2], dtype=np.int32),
+            "facet_markers": None,
+            "holes": np.empty((0, 3)),
+            "regions": np.empty((0, 5)),
+        }
+
+    monkeypatch.setattr(native, "_read_tetgen_smesh", _fake_smesh, raising=False)
+    (tmp_path / "plc.node").write_text("")
+
+    vertices, facets, holes = tetgen_files.read_smesh(tmp_path / "plc.smesh")
+
+    assert seen["first_index"] == 1
+    assert isinstance(facets, FacetCSR)
+    assert vertices.shape == (4, 3) and holes.shape == (0, 3)
+
+
+def _two_tets() -> tetgen_files.TetgenFilesIO:
+    return tetgen_files.TetgenFilesIO(
+        points=np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0], [0.1, 0.7, 1.3e-7]]),
+        point_markers=np.array([1, 0, 0, 2, -3], dtype=np.int32),
+        tets=np.array([[0, 1, 2, 3], [1, 2, 3, 4]], dtype=np.int32),
+        tet_attr=np.array([[1.5], [-2.0]]),
+        boundary_tri_faces=np.array([[0, 2, 1], [0, 1, 3], [0, 3, 2], [1, 2, 4]], dtype=np.int32),
+        boundary_tri_markers=np.array([-2, 0, 7, -10], dtype=np.int32),
+        neighbors=np.array([[1, -1, -1, -1], [-1, -1, -1, 0]], dtype=np.int32),
+    )
+
+
+@pytest.mark.parametrize("first_index", [0, 1])
+def test_native_tetgen_round_trip(tmp_path, first_index: int) -> None:
+    """write_tetgen -> read_tetgen through the native module restores every array exactly."""
+    src = _two_tets()
+    tetgen_files.write_tetgen(tmp_path / "m", src, first_index=first_index)
+
+    assert (tmp_path / "m.node").read_text().split()[4] == str(first_index)
+    io = tetgen_files.read_tetgen(tmp_path / "m.node")
+
+    np.testing.assert_array_equal(io.points, src.points)
+    np.testing.assert_array_equal(io.point_markers, src.point_markers)
+    np.testing.assert_array_equal(io.tets, src.tets)
+    np.testing.assert_array_equal(io.tet_attr, src.tet_attr)
+    np.testing.assert_array_equal(io.tri_faces, src.boundary_tri_faces)
+    np.testing.assert_array_equal(io.tri_markers, src.boundary_tri_markers)
+    np.testing.assert_array_equal(io.neighbors, src.neighbors)
+
+
+def test_native_reads_hand_written_files(tmp_path) -> None:
+    """Comments, blank lines, tabs and 1-based numbering as TetGen writes them."""
+    (tmp_path / "h.node").write_text(
+        "# unit tet plus one point\n"
+        "5  3  0  1\n"
+        "\n"
+        "1  0 0 0  1\n"
+        "2\t1.0\t0.0\t0.0\t0   # trailing comment\n"
+        "3  0 1 0  0\n"
+        "  # indented comment\n"
+        "4  0 0 1  2\n"
+        "5  1 1 1  0\n"
+    )
+    (tmp_path / "h.ele").write_text("2 4 0\n# tets\n1 1 2 3 4\n2 2 3 4 5\n# Generated by hand\n")
+    (tmp_path / "h.face").write_text("2 1\n1 1 3 2 5\n2 2 3 5 -4\n")
+    (tmp_path / "h.neigh").write_text("2 4\n1 2 -1 -1 -1\n2 -1 -1 -1 1\n")
+
+    io = tetgen_files.read_tetgen(tmp_path / "h")
+
+    assert io.points.shape == (5, 3) and io.points[1].tolist() == [1.0, 0.0, 0.0]
+    assert io.point_markers.tolist() == [1, 0, 0, 2, 0]
+    assert io.tets.tolist() == [[0, 1, 2, 3], [1, 2, 3, 4]]
+    assert io.tri_faces.tolist() == [[0, 2, 1], [1, 2, 4]] and io.tri_markers.tolist() == [5, -4]
+    assert io.neighbors.tolist() == [[1, -1, -1, -1], [-1, -1, -1, 0]]
+
+    (tmp_path / "bad.node").write_text("2 3 0 0\n1 0 0 0\n")
+    with pytest.raises(RuntimeError, match="bad.node"):
+        tetgen_files.read_tetgen(tmp_path / "bad")
+
+
+@pytest.mark.parametrize("suffix", [".smesh", ".poly"])
+def test_native_plc_round_trip(tmp_path, suffix: str) -> None:
+    """write_smesh -> read_smesh restores the facets, markers and holes, 1-based on disk."""
+    vertices = _points()
+    facets = FacetCSR(
+        np.array([0, 3, 6, 9, 12]),
+        np.array([0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3]),
+        np.array([1, 2, 3, 8], dtype=np.int32),
+    )
+    holes = np.array([[5.0, 5.0, 5.0]])
+    tetgen_files.write_smesh(tmp_path / f"plc{suffix}", vertices, facets, holes, first_index=1)
+
+    assert (tmp_path / f"plc{suffix}").exists() and (tmp_path / "plc.node").exists()
+    V, F, H = tetgen_files.read_smesh(tmp_path / f"plc{suffix}")
+
+    np.testing.assert_array_equal(V, vertices)
+    assert F.offsets.tolist() == facets.offsets.tolist()
+    assert F.indices.tolist() == facets.indices.tolist()
+    assert F.markers.tolist() == facets.markers.tolist()
+    np.testing.assert_array_equal(H, holes)
+
+
+def test_native_reads_hand_written_poly(tmp_path) -> None:
+    """An inline-node .poly with comments meshes like the PLC it describes."""
+    (tmp_path / "cube.poly").write_text(
+        "# Part 1 - nodes, 1-based\n"
+        "8 3 0 0\n"
+        "1 0 0 0\n2 1 0 0\n3 1 1 0\n4 0 1 0\n"
+        "5 0 0 1\n6 1 0 1\n7 1 1 1\n8 0 1 1\n"
+        "# Part 2 - facets: polygons, holes, marker\n"
+        "6 1\n"
+        "1 0 1\n4  1 4 3 2   # bottom\n"
+        "1 0 2\n4  5 6 7 8\n"
+        "1 0 3\n4  1 2 6 5\n"
+        "1 0 4\n4  3 4 8 7\n"
+        "1 0 5\n4  1 5 8 4\n"
+        "1 0 6\n4  2 3 7 6\n"
+        "# Part 3 - holes\n0\n"
+    )
+
+    V, F, H = tetgen_files.read_smesh(tmp_path / "cube.poly")
+
+    assert V.shape == (8, 3) and H.shape == (0, 3)
+    assert F.offsets.tolist() == [0, 4, 8, 12, 16, 20, 24]
+    assert F.indices[:4].tolist() == [0, 3, 2, 1] and F.markers.tolist() == [1, 2, 3, 4, 5, 6]
+
+    io = tetrahedralize(V, np.empty((0, 3), dtype=np.int32), F)
+    c = io.points[io.tets]
+    det = np.einsum("ij,ij->i", np.cross(c[:, 1] - c[:, 0], c[:, 2] - c[:, 0]), c[:, 3] - c[:, 0])
+    assert np.abs(det).sum() / 6.0 == pytest.approx(1.0)
+
+    (tmp_path / "holed.poly").write_text(
+        "4 3 0 0\n1 0 0 0\n2 1 0 0\n3 0 1 0\n4 0 0 1\n1 0\n1 1  # one polygon, one hole\n3 1 2 3\n1 0.2 0.2 0\n"
+    )
+    with pytest.raises(RuntimeError, match="one polygon"):
+        tetgen_files.read_smesh(tmp_path / "holed.poly")
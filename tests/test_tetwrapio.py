@@ -2,8 +2,13 @@
 
 from __future__ import annotations
 
+import re
+import xml.etree.ElementTree as ET
+
 import numpy as np
+import pytest
 
+from dtcc_tetgen_wrapper import tetrahedralize, tetwrapio
 from dtcc_tetgen_wrapper.tetwrapio import TetwrapIO
 
 
@@ -13,6 +18,7 @@ class _FakeRawIO:
         self.tri_markers = np.array([1, 0], dtype=np.int32)
         self.points = np.empty((0, 3))
         self.tets = np.empty((0, 4), dtype=np.int32)
+        self.boundary_tri_faces = np.array([[0, 1, 2], [0, 2, 3]], dtype=np.int32)
 
 
 def test_normalize_markers_updates_arrays() -> None:
@@ -30,3 +36,126 @@ def test_raw_passthrough() -> None:
     raw = _FakeRawIO()
     wrapper = TetwrapIO(raw, normalize_on_init=False)
     assert wrapper.raw() is raw
+
+
+def test_raw_markers_survive_normalization() -> None:
+    """raw_markers() keeps TetGen's markers, which normalization cannot invert."""
+    raw = _FakeRawIO()
+    raw.boundary_tri_markers = np.array([0, -10], dtype=np.int32)
+    wrapper = TetwrapIO(raw)
+
+    assert raw.boundary_tri_markers.tolist() == [-10, -10]
+    assert wrapper.raw_markers().tolist() == [0, -10]
+    assert wrapper.raw_markers("tri_markers").tolist() == [1, 0]
+    assert TetwrapIO(_FakeRawIO(), normalize_on_init=False).raw_markers().tolist() == [0, 2]
+    with pytest.raises(ValueError, match="no marker array"):
+        wrapper.raw_markers("points")
+
+
+def test_writers_pass_normalized_boundary(monkeypatch: pytest.MonkeyPatch, tmp_path) -> None:
+    """write_vtu / write_xdmf hand the output arrays to the native writers."""
+    calls = []
+    monkeypatch.setattr(tetwrapio._tetwrap, "_write_vtu", lambda *a, **kw: calls.append(("vtu", a, kw)), raising=False)
+    monkeypatch.setattr(tetwrapio._tetwrap, "_write_xdmf", lambda *a, **kw: calls.append(("xdmf", a, kw)), raising=False)
+    raw = _FakeRawIO()
+    wrapper = TetwrapIO(raw, interior_default=-1)
+
+    wrapper.write_vtu(tmp_path / "m.vtu", compress=True)
+    wrapper.write_xdmf(tmp_path / "m.xmf", boundary_faces=False)
+
+    kind, args, kwargs = calls[0]
+    assert kind == "vtu" and args[0] == str(tmp_path / "m.vtu")
+    assert args[3] is raw.boundary_tri_faces
+    assert args[4].tolist() == [-1, 1]
+    assert kwargs == {"compress": True, "num_threads": 0}
+    kind, args, _ = calls[1]
+    assert kind == "xdmf" and args[3] is None and args[4] is None
+
+
+# VTU / XDMF scalar types, in the writers' (native) byte order
+_VTK_TYPES = {"Float64": np.float64, "Int32": np.int32, "Int64": np.int64, "UInt8": np.uint8}
+_XDMF_TYPES = {("Float", "8"): np.float64, ("Int", "4"): np.int32}
+
+
+def _mesh_cube(vertices, facets, **kwargs) -> TetwrapIO:
+    return tetrahedralize(
+        vertices,
+        np.empty((0, 3), dtype=np.int32),
+        facets.tolist(),
+        switches_params={"max_volume": 0.05},
+        return_boundary_faces=True,
+        return_neighbors=True,
+        **kwargs,
+    )
+
+
+def _vtu_arrays(path) -> tuple:
+    """Header and the appended arrays of a raw VTU file, located through their offsets."""
+    data = path.read_bytes()
+    start = data.index(b"_", data.index(b"<AppendedData")) + 1
+    header = data[:start].decode()
+    arrays, end = {}, start
+    for tag in re.findall(r"<DataArray ([^>]*)/>", header):
+        attrs = dict(re.findall(r'(\w+)="([^"]*)"', tag))
+        at = start + int(attrs["offset"])
+        assert at == end  # arrays are back to back in tag order
+        nbytes = int(np.frombuffer(data, dtype=np.uint64, count=1, offset=at)[0])
+        dtype = np.dtype(_VTK_TYPES[attrs["type"]])
+        count = nbytes // dtype.itemsize
+        arrays[attrs.get("Name", "points")] = np.frombuffer(data, dtype=dtype, count=count, offset=at + 8)
+        end = at + 8 + nbytes
+    assert data[end:].startswith(b"\n  </AppendedData>")
+    return header, arrays
+
+
+def test_native_writers_and_streamed_output(unit_cube_vertices, unit_cube_faces, tmp_path) -> None:
+    """VTU / XDMF files and output_dir .npy files hold exactly the in-memory arrays."""
+    io = _mesh_cube(unit_cube_vertices, unit_cube_faces)
+    points, tets = np.asarray(io.points), np.asarray(io.tets)
+    faces, markers = np.asarray(io.boundary_tri_faces), np.asarray(io.boundary_tri_markers)
+    N, K, F = len(points), len(tets), len(faces)
+    assert K > 6 and F > 12
+
+    io.write_vtu(tmp_path / "m.vtu")
+    header, arrays = _vtu_arrays(tmp_path / "m.vtu")
+    assert f'NumberOfPoints="{N}" NumberOfCells="{K + F}"' in header
+    np.testing.assert_array_equal(arrays["points"].reshape(N, 3), points)
+    np.testing.assert_array_equal(arrays["connectivity"], np.concatenate([tets.ravel(), faces.ravel()]))
+    np.testing.assert_array_equal(
+        arrays["offsets"], np.concatenate([4 * np.arange(1, K + 1), 4 * K + 3 * np.arange(1, F + 1)])
+    )
+    np.testing.assert_array_equal(arrays["types"], [10] * K + [5] * F)
+    np.testing.assert_array_equal(arrays["marker"], np.concatenate([np.full(K, -1), markers]))
+
+    io.write_xdmf(tmp_path / "m.xmf")
+    grids = {g.get("Name"): g for g in ET.parse(tmp_path / "m.xmf").getroot().iter("Grid")}
+    assert (tmp_path / "m.bin").stat().st_size == 24 * N + 16 * K + 16 * F
+
+    def item(element, expected):
+        shape = tuple(int(d) for d in element.get("Dimensions").split())
+        assert element.text == "m.bin" and shape == expected.shape
+        dtype = _XDMF_TYPES[(element.get("NumberType"), element.get("Precision"))]
+        count = int(np.prod(shape))
+        return np.fromfile(tmp_path / "m.bin", dtype=dtype, count=count, offset=int(element.get("Seek"))).reshape(shape)
+
+    np.testing.assert_array_equal(item(grids["tets"].find("Topology/DataItem"), tets), tets)
+    np.testing.assert_array_equal(item(grids["tets"].find("Geometry/DataItem"), points), points)
+    np.testing.assert_array_equal(item(grids["boundary"].find("Topology/DataItem"), faces), faces)
+    np.testing.assert_array_equal(item(grids["boundary"].find("Attribute/DataItem"), markers), markers)
+
+    streamed = _mesh_cube(unit_cube_vertices, unit_cube_faces, output_dir=tmp_path / "out")
+    # boundary_tri_markers.npy holds normalized markers too: TetwrapIO
+    # normalizes the mapped view in place
+    names = ("points", "tets", "neighbors", "boundary_tri_faces", "boundary_tri_markers")
+    for name in names + ("boundary_tri_tets", "boundary_tri_local_faces"):
+        on_disk = np.load(tmp_path / "out" / f"{name}.npy", mmap_mode="r")
+        np.testing.assert_array_equal(on_disk, getattr(io, name), err_msg=name)
+        np.testing.assert_array_equal(getattr(streamed, name), on_disk, err_msg=name)
+    # Point markers follow the in-memory output: streamed when TetGen writes them
+    if io.point_markers is None:
+        assert streamed.point_markers is None
+        assert not (tmp_path / "out" / "point_markers.npy").exists()
+    else:
+        on_disk = np.load(tmp_path / "out" / "point_markers.npy", mmap_mode="r")
+        np.testing.assert_array_equal(on_disk, io.point_markers)
+        np.testing.assert_array_equal(streamed.point_markers, on_disk)